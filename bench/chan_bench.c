@@ -0,0 +1,249 @@
+/* bench/chan_bench.c */
+// नलिका runtime (lock-free MPMC ring, futex handoff) against a mutex and
+// condition variable queue: throughput for 1→1, N→1 and N→M, and round-trip
+// latency between two threads
+#define HC_TASK_IMPLEMENTATION
+#include "hc_chan.h"
+#include <pthread.h>
+#include <time.h>
+
+#define MESSAGES 1000000
+#define HANDOFFS 200000
+#define ROUND_TRIPS 100000
+#define CAPACITY 1024
+
+// Mutex-protected bounded ring with one condition variable per direction
+typedef struct
+{
+    int *slots;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    pthread_mutex_t lock;
+    pthread_cond_t notFull;
+    pthread_cond_t notEmpty;
+} LockedQueue;
+
+static void lockedInit(LockedQueue *queue, size_t capacity)
+{
+    queue->slots = (int *)hc_alloc(sizeof(int) * capacity);
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->count = 0;
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->notFull, NULL);
+    pthread_cond_init(&queue->notEmpty, NULL);
+}
+
+static void lockedSend(LockedQueue *queue, int value)
+{
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->capacity)
+        pthread_cond_wait(&queue->notFull, &queue->lock);
+    queue->slots[(queue->head + queue->count) % queue->capacity] = value;
+    queue->count++;
+    pthread_cond_signal(&queue->notEmpty);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static int lockedRecv(LockedQueue *queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0)
+        pthread_cond_wait(&queue->notEmpty, &queue->lock);
+    int value = queue->slots[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    pthread_cond_signal(&queue->notFull);
+    pthread_mutex_unlock(&queue->lock);
+    return value;
+}
+
+// A benchmark run: which queue, how many messages each thread moves
+typedef struct
+{
+    hc_chan_int *channel; // NULL to use queue
+    LockedQueue *queue;
+    long count;
+    long sum;
+} Worker;
+
+static void *producer(void *argument)
+{
+    Worker *worker = (Worker *)argument;
+    for (long i = 0; i < worker->count; i++)
+    {
+        if (worker->channel != NULL)
+            hc_chan_send(worker->channel, (int)(i & 0xFFFF));
+        else
+            lockedSend(worker->queue, (int)(i & 0xFFFF));
+    }
+    return NULL;
+}
+
+static void *consumer(void *argument)
+{
+    Worker *worker = (Worker *)argument;
+    long sum = 0;
+    for (long i = 0; i < worker->count; i++)
+    {
+        sum += worker->channel != NULL ? hc_chan_recv(worker->channel) : lockedRecv(worker->queue);
+    }
+    worker->sum = sum;
+    return NULL;
+}
+
+static double seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static hc_chan_int *newChannel(size_t capacity, int unbuffered)
+{
+    hc_chan_int *channel = (hc_chan_int *)aligned_alloc(_Alignof(hc_chan_int), sizeof(hc_chan_int));
+    hc_chan_int_cell *cells = (hc_chan_int_cell *)calloc(capacity, sizeof(hc_chan_int_cell));
+    *channel = (hc_chan_int)HC_CHAN_INIT(cells, capacity, unbuffered);
+    return channel;
+}
+
+static void freeChannel(hc_chan_int *channel)
+{
+    free(channel->cells);
+    free(channel);
+}
+
+// Move messages from producers to consumers; returns ns per message and
+// checks that every message arrived
+static double run(hc_chan_int *channel, LockedQueue *queue, int producers, int consumers, long messages,
+                  long *checksum)
+{
+    pthread_t threads[16];
+    Worker workers[16];
+    for (int i = 0; i < producers + consumers; i++)
+    {
+        workers[i].channel = channel;
+        workers[i].queue = queue;
+        workers[i].count = messages / (i < producers ? producers : consumers);
+        workers[i].sum = 0;
+    }
+
+    double start = seconds();
+    for (int i = 0; i < producers + consumers; i++)
+        pthread_create(&threads[i], NULL, i < producers ? producer : consumer, &workers[i]);
+    for (int i = 0; i < producers + consumers; i++)
+        pthread_join(threads[i], NULL);
+    double elapsed = seconds() - start;
+
+    long expected = 0;
+    for (int i = 0; i < producers; i++)
+    {
+        for (long j = 0; j < workers[i].count; j++)
+            expected += j & 0xFFFF;
+    }
+    for (int i = producers; i < producers + consumers; i++)
+        expected -= workers[i].sum;
+    *checksum += expected;
+
+    return elapsed * 1e9 / messages;
+}
+
+// Ping-pong between two threads over a pair of queues
+typedef struct
+{
+    hc_chan_int *ping;
+    hc_chan_int *pong;
+    LockedQueue *lockedPing;
+    LockedQueue *lockedPong;
+} Echo;
+
+static void *echo(void *argument)
+{
+    Echo *pair = (Echo *)argument;
+    for (int i = 0; i < ROUND_TRIPS; i++)
+    {
+        if (pair->ping != NULL)
+            hc_chan_send(pair->pong, hc_chan_recv(pair->ping) + 1);
+        else
+            lockedSend(pair->lockedPong, lockedRecv(pair->lockedPing) + 1);
+    }
+    return NULL;
+}
+
+static double roundTrip(Echo *pair, long *checksum)
+{
+    pthread_t thread;
+    pthread_create(&thread, NULL, echo, pair);
+
+    double start = seconds();
+    int value = 0;
+    for (int i = 0; i < ROUND_TRIPS; i++)
+    {
+        if (pair->ping != NULL)
+        {
+            hc_chan_send(pair->ping, value);
+            value = hc_chan_recv(pair->pong);
+        }
+        else
+        {
+            lockedSend(pair->lockedPing, value);
+            value = lockedRecv(pair->lockedPong);
+        }
+    }
+    double elapsed = seconds() - start;
+    pthread_join(thread, NULL);
+
+    *checksum += value - ROUND_TRIPS;
+    return elapsed * 1e9 / ROUND_TRIPS;
+}
+
+int main(void)
+{
+    static const struct
+    {
+        const char *name;
+        int producers;
+        int consumers;
+    } shapes[] = {{"1->1", 1, 1}, {"4->1", 4, 1}, {"4->4", 4, 4}};
+
+    long checksum = 0;
+
+    printf("%-8s %14s %14s %14s\n", "shape", "ring ns/msg", "handoff ns/msg", "mutex ns/msg");
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+    {
+        hc_chan_int *ring = newChannel(CAPACITY, 0);
+        hc_chan_int *handoff = newChannel(2, 1);
+        LockedQueue queue;
+        lockedInit(&queue, CAPACITY);
+
+        double ringTime = run(ring, NULL, shapes[s].producers, shapes[s].consumers, MESSAGES, &checksum);
+        double handoffTime = run(handoff, NULL, shapes[s].producers, shapes[s].consumers, HANDOFFS, &checksum);
+        double lockedTime = run(NULL, &queue, shapes[s].producers, shapes[s].consumers, MESSAGES, &checksum);
+        printf("%-8s %14.1f %14.1f %14.1f\n", shapes[s].name, ringTime, handoffTime, lockedTime);
+
+        freeChannel(ring);
+        freeChannel(handoff);
+        hc_release(queue.slots);
+    }
+
+    hc_chan_int *ping = newChannel(2, 0);
+    hc_chan_int *pong = newChannel(2, 0);
+    Echo channels = {ping, pong, NULL, NULL};
+    double channelLatency = roundTrip(&channels, &checksum);
+
+    LockedQueue lockedPing, lockedPong;
+    lockedInit(&lockedPing, 2);
+    lockedInit(&lockedPong, 2);
+    Echo locked = {NULL, NULL, &lockedPing, &lockedPong};
+    double lockedLatency = roundTrip(&locked, &checksum);
+
+    printf("%-8s %14.1f %14s %14.1f\n", "rtt ns", channelLatency, "", lockedLatency);
+    printf("checksum %ld (must be 0)\n", checksum);
+
+    freeChannel(ping);
+    freeChannel(pong);
+    hc_release(lockedPing.slots);
+    hc_release(lockedPong.slots);
+    return checksum == 0 ? 0 : 1;
+}
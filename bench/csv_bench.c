@@ -0,0 +1,98 @@
+/* bench/csv_bench.c */
+// तालिका_पढ़ो runtime (SIMD-classified CSV, parsed straight into lists)
+// against the loop a program has to write with पढ़ो, which generated code
+// lowers to scanf on stdin
+#include "hc_csv.h"
+#include <time.h>
+#include <unistd.h>
+
+#define ROWS 2000000
+
+static double seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Write ROWS records of id,price,quantity with a header row; returns the
+// file's size
+static long writeTable(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        hc_fatal("cannot create the table");
+
+    fprintf(file, "id,price,quantity\n");
+    uint32_t state = 12345;
+    for (int i = 0; i < ROWS; i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        fprintf(file, "%d,%u.%02u,%d\n", i, (state >> 8) % 100000, (state >> 4) % 100, (int)(state % 2000) - 1000);
+    }
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+int main(void)
+{
+    char path[] = "/tmp/hc_csv_benchXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+        hc_fatal("cannot create the table");
+    close(fd);
+    long size = writeTable(path);
+
+    // तालिका_पढ़ो(path, ",", 0, ids, 1, prices, 2, quantities)
+    hc_list_int ids = {0};
+    hc_list_float prices = {0};
+    hc_list_int quantities = {0};
+    double start = seconds();
+    hc_csv_column columns[] = {HC_CSV_COLUMN(0, &ids), HC_CSV_COLUMN(1, &prices), HC_CSV_COLUMN(2, &quantities)};
+    int rows = hc_csv_read(HC_STR_VIEW(path, strlen(path)), ',', columns, 3);
+    double csvTime = seconds() - start;
+
+    // पढ़ो("%d,%f,%d", ...) in a loop, pushing into the same kinds of lists
+    hc_list_int scannedIds = {0};
+    hc_list_float scannedPrices = {0};
+    hc_list_int scannedQuantities = {0};
+    start = seconds();
+    if (freopen(path, "r", stdin) == NULL)
+        hc_fatal("cannot reopen the table");
+    scanf("%*[^\n]\n");
+    int id, quantity;
+    float price;
+    while (scanf("%d,%f,%d", &id, &price, &quantity) == 3)
+    {
+        hc_list_int_push(&scannedIds, id);
+        hc_list_float_push(&scannedPrices, price);
+        hc_list_int_push(&scannedQuantities, quantity);
+    }
+    double scanTime = seconds() - start;
+    unlink(path);
+
+    long checksum = (long)rows - ROWS;
+    checksum += (long)scannedIds.length - ROWS;
+    for (size_t i = 0; i < ids.length && i < scannedIds.length; i++)
+    {
+        checksum += ids.data[i] - scannedIds.data[i];
+        checksum += quantities.data[i] - scannedQuantities.data[i];
+        checksum += prices.data[i] != scannedPrices.data[i];
+    }
+
+    double megabytes = size / 1e6;
+    printf("%-22s %10s %10s\n", "reader", "MB/s", "ns/row");
+    printf("%-22s %10.1f %10.1f\n", "csv (hc_csv)", megabytes / csvTime, csvTime * 1e9 / ROWS);
+    printf("%-22s %10.1f %10.1f\n", "scanf loop", megabytes / scanTime, scanTime * 1e9 / ROWS);
+    printf("speedup %.1fx\n", scanTime / csvTime);
+    printf("checksum %ld (must be 0)\n", checksum);
+
+    hc_list_int_free(&ids);
+    hc_list_float_free(&prices);
+    hc_list_int_free(&quantities);
+    hc_list_int_free(&scannedIds);
+    hc_list_float_free(&scannedPrices);
+    hc_list_int_free(&scannedQuantities);
+    return checksum == 0 ? 0 : 1;
+}
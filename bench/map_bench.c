@@ -0,0 +1,108 @@
+/* bench/map_bench.c */
+// शब्दकोश runtime (SIMD-probed open addressing) against a naive chained hash map
+#include "hc_map.h"
+#include <time.h>
+
+#define KEY_COUNT 1000000
+#define LOOKUPS 4000000
+
+// Naive separate chaining: one malloc'd node per key, fixed-size bucket array
+typedef struct ChainNode
+{
+    int key;
+    int value;
+    struct ChainNode *next;
+} ChainNode;
+
+typedef struct
+{
+    ChainNode **buckets;
+    size_t bucketCount;
+} ChainMap;
+
+static void chainPut(ChainMap *map, int key, int value)
+{
+    size_t bucket = hc_hash_int(key) & (map->bucketCount - 1);
+    for (ChainNode *node = map->buckets[bucket]; node != NULL; node = node->next)
+    {
+        if (node->key == key)
+        {
+            node->value = value;
+            return;
+        }
+    }
+    ChainNode *node = (ChainNode *)hc_alloc(sizeof(ChainNode));
+    node->key = key;
+    node->value = value;
+    node->next = map->buckets[bucket];
+    map->buckets[bucket] = node;
+}
+
+static int chainGet(const ChainMap *map, int key)
+{
+    size_t bucket = hc_hash_int(key) & (map->bucketCount - 1);
+    for (ChainNode *node = map->buckets[bucket]; node != NULL; node = node->next)
+    {
+        if (node->key == key)
+            return node->value;
+    }
+    return 0;
+}
+
+static double seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+int main(void)
+{
+    int *keys = (int *)hc_alloc(sizeof(int) * KEY_COUNT);
+    for (int i = 0; i < KEY_COUNT; i++)
+    {
+        keys[i] = (int)((unsigned)i * 2654435761u); // Scattered, distinct
+    }
+
+    // Half the lookups hit, half miss
+    int *probes = (int *)hc_alloc(sizeof(int) * LOOKUPS);
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        probes[i] = (i & 1) ? keys[(i * 7919) % KEY_COUNT] : -i - 1;
+    }
+
+    long checksum = 0;
+
+    double start = seconds();
+    hc_map_int_int swiss = {0};
+    for (int i = 0; i < KEY_COUNT; i++)
+        hc_map_put(&swiss, keys[i], i);
+    double swissInsert = seconds() - start;
+
+    start = seconds();
+    for (int i = 0; i < LOOKUPS; i++)
+        checksum += hc_map_get(&swiss, probes[i]);
+    double swissLookup = seconds() - start;
+
+    ChainMap chain;
+    chain.bucketCount = 1 << 20;
+    chain.buckets = (ChainNode **)calloc(chain.bucketCount, sizeof(ChainNode *));
+
+    start = seconds();
+    for (int i = 0; i < KEY_COUNT; i++)
+        chainPut(&chain, keys[i], i);
+    double chainInsert = seconds() - start;
+
+    start = seconds();
+    for (int i = 0; i < LOOKUPS; i++)
+        checksum -= chainGet(&chain, probes[i]);
+    double chainLookup = seconds() - start;
+
+    printf("%-22s %12s %12s\n", "map", "insert ns/op", "lookup ns/op");
+    printf("%-22s %12.1f %12.1f\n", "swiss (hc_map)", swissInsert * 1e9 / KEY_COUNT, swissLookup * 1e9 / LOOKUPS);
+    printf("%-22s %12.1f %12.1f\n", "chained", chainInsert * 1e9 / KEY_COUNT, chainLookup * 1e9 / LOOKUPS);
+    printf("checksum %ld (must be 0)\n", checksum);
+
+    hc_map_int_int_free(&swiss);
+    return checksum == 0 ? 0 : 1;
+}
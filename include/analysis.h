@@ -0,0 +1,107 @@
+/* include/analysis.h */
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include "ast.h"
+
+// A call from one user-defined function to another
+typedef struct
+{
+    int callee;    // Call graph index of the called function
+    int loopDepth; // Number of loops enclosing the call site
+    bool cold;     // Call site sits on an error path
+} CallSite;
+
+// Static execution frequency class of a function
+typedef enum
+{
+    TEMPERATURE_COLD,   // Unreachable, or only called from error paths
+    TEMPERATURE_NORMAL,
+    TEMPERATURE_HOT     // Called from loops
+} FunctionTemperature;
+
+// A function in the call graph
+typedef struct
+{
+    AstFunctionDecl *decl;
+    int size;          // AST node count of the function
+    int callCount;     // Number of call sites that target this function
+    int calleeCount;   // Number of call sites in this function's body
+    int calleeCapacity;
+    CallSite *callees; // One entry per call site
+    int scc;           // Strongly connected component, numbered callees-first
+    bool recursive;    // Part of a cycle (including direct self-recursion)
+    bool reachable;    // Reachable from मुख्य
+    double frequency;  // Estimated calls per run of मुख्य
+    FunctionTemperature temperature;
+} CallGraphNode;
+
+// Whole-program call graph over the user-defined functions
+typedef struct
+{
+    int count;
+    CallGraphNode *nodes;
+    int sccCount;
+    int entry; // Index of मुख्य, or -1
+} CallGraph;
+
+// Build the call graph from the AstCall nodes of an analyzed program
+void buildCallGraph(CallGraph *graph, AstProgram *program);
+
+// Find a function's call graph index by name (-1 if it is not user-defined)
+int findCallGraphNode(CallGraph *graph, Token name);
+
+// A leaf calls no user-defined functions
+bool isLeafFunction(CallGraph *graph, int index);
+
+// Check whether a token names the program entry point (मुख्य)
+bool isEntryPoint(Token name);
+
+// Check whether a statement looks like an error path (reports an error message)
+bool isColdPath(AstNode *node);
+
+// Order function indices for emission: hot first, cold last
+void orderFunctionsByTemperature(CallGraph *graph, int *order);
+
+// Warn on stderr about loops that mix decimal literals (doubles in C) with
+// float values; returns the number of warnings
+int checkLoopPrecision(CallGraph *graph);
+
+// Work out the value ranges of पूर्णांक expressions and record in the AST the
+// arithmetic that cannot overflow or divide by zero, divisions of operands
+// that are not negative and अगर conditions the ranges decide; with dump set,
+// also write the ranges there
+void analyzeRanges(AstProgram *program, FILE *dump);
+
+// Estimated stack use of a function and of the deepest call path from it
+typedef struct
+{
+    int frame;      // Bytes of the function's own frame
+    long depth;     // Bytes of the deepest path from the function, its frame included
+    bool unbounded; // A path from the function recurses
+    int next;       // Callee on the deepest path (towards the recursion if unbounded), or -1
+} StackUsage;
+
+// Estimate the bytes of a function's own stack frame from its parameters
+// and locals
+int estimateFrameSize(AstFunctionDecl *decl);
+
+// Fill in one StackUsage per call graph node; recursion makes a path unbounded
+void analyzeStackUsage(CallGraph *graph, StackUsage *usage);
+
+// Write every function's stack use and the deepest paths from मुख्य and from
+// the functions run as tasks
+void dumpStackReport(CallGraph *graph, StackUsage *usage, FILE *output);
+
+// Warn on stderr about paths from मुख्य or a task that may need more than
+// limit bytes of stack or recurse; returns the number of warnings
+int checkStackLimit(CallGraph *graph, StackUsage *usage, long limit);
+
+// Write the call graph in Graphviz DOT or JSON format
+void dumpCallGraphDot(CallGraph *graph, FILE *output);
+void dumpCallGraphJson(CallGraph *graph, FILE *output);
+
+// Free the call graph
+void freeCallGraph(CallGraph *graph);
+
+#endif /* ANALYSIS_H */
@@ -17,6 +17,9 @@ typedef enum
     AST_FOR,             // For statement
     AST_RETURN,          // Return statement
     AST_EXPRESSION_STMT, // Expression statement
+    AST_SYNC,            // प्रतीक्षा: wait for the function's tasks
+    AST_YIELD,           // रोको_और_दो: hand a value out of a coroutine
+    AST_MEASURE,         // मापो: time a block over many runs
 
     // Expressions
     AST_BINARY,     // Binary operation
@@ -25,8 +28,46 @@ typedef enum
     AST_VARIABLE,   // Variable reference
     AST_ASSIGNMENT, // Variable assignment
     AST_CALL,       // Function call
+    AST_INDEX,      // List element
+    AST_SPAWN,      // कार्य call: run a call as a task
 } AstNodeType;
 
+// Expected outcome of a branch condition
+typedef enum
+{
+    BRANCH_HINT_NONE,     // Left to the code generator's heuristics
+    BRANCH_HINT_LIKELY,   // संभावित
+    BRANCH_HINT_UNLIKELY, // असंभावित
+} BranchHint;
+
+// Parts of the bundled runtime (runtime/hc_*.h) a program needs
+typedef enum
+{
+    RUNTIME_MAP = 1 << 0,     // hc_map.h
+    RUNTIME_LIST = 1 << 1,    // hc_list.h
+    RUNTIME_STR = 1 << 2,     // hc_str.h
+    RUNTIME_TASK = 1 << 3,    // hc_task.h
+    RUNTIME_CHAN = 1 << 4,    // hc_chan.h
+    RUNTIME_ATOMIC = 1 << 5,  // hc_atomic.h
+    RUNTIME_REGION = 1 << 6,  // hc_arena.h
+    RUNTIME_FILE = 1 << 7,    // hc_file.h
+    RUNTIME_CSV = 1 << 8,     // hc_csv.h
+    RUNTIME_SORT = 1 << 9,    // hc_sort.h
+    RUNTIME_TIME = 1 << 10,   // hc_time.h
+    RUNTIME_RANDOM = 1 << 11, // hc_random.h
+} RuntimeFeature;
+
+// Memory order argument of the परमाणु_ builtins, named like C11's
+typedef enum
+{
+    MEMORY_ORDER_NONE,    // Not a memory order name
+    MEMORY_ORDER_RELAXED, // शिथिल
+    MEMORY_ORDER_ACQUIRE, // अर्जन
+    MEMORY_ORDER_RELEASE, // विमोचन
+    MEMORY_ORDER_ACQ_REL, // अर्जन_विमोचन
+    MEMORY_ORDER_SEQ_CST, // अनुक्रमिक
+} MemoryOrder;
+
 // Forward declaration
 typedef struct AstNode AstNode;
 
@@ -36,6 +77,8 @@ struct AstNode
     AstNodeType type;
     int line;
     int column;
+    TokenType dataType; // Expression type, filled in by semantic analysis
+    bool temporary;     // Expression creates a पाठ value its consumer must release
 };
 
 // Program (the root of the AST)
@@ -45,31 +88,84 @@ typedef struct
     int count;
     int capacity;
     AstNode **declarations;
+    int runtimeFeatures; // RuntimeFeature bits, filled in by semantic analysis
+    int genericCount;
+    int genericCapacity;
+    struct AstFunctionDecl **generics; // सामान्य functions; their instances are added to declarations
 } AstProgram;
 
+// Value of a constant expression, worked out by semantic analysis
+typedef struct
+{
+    bool known;         // The expression is constant
+    bool isFloat;       // floatValue holds the value, else intValue
+    bool single;        // A float computed in single precision, like a दशमलव variable
+    int intValue;
+    double floatValue;
+} ConstantValue;
+
 // Variable declaration
 typedef struct
 {
     AstNode base;
     Token name;
     TokenType varType;    // Type of variable (INT, FLOAT, etc.)
+    TokenType keyType;    // Key type of maps
+    TokenType elemType;   // Value type of maps, element type of lists and channels
+    int capacity;         // Buffer size of channels, 0 for unbuffered
     AstNode *initializer; // Optional
+    int typeParam;        // In a generic function: the type parameter standing for varType, or -1
+    bool constant;        // Declared स्थिर
+    ConstantValue value;  // Of a स्थिर number or character whose initializer is constant
+    int elementCount;     // Elements of a स्थिर list's [...] table
+    int elementCapacity;
+    AstNode **elements;
 } AstVarDecl;
 
-// Function declaration
+typedef struct AstFunctionDecl AstFunctionDecl;
+
+// A parameter or local of a coroutine. Parameters and the locals that live
+// across a रोको_और_दो are kept in the coroutine's frame between resumptions.
 typedef struct
+{
+    Token name;
+    TokenType type;
+    AstFunctionDecl *coroutine; // Coroutine run by a सहक्रम variable
+    bool kept;
+} AstFrameSlot;
+
+// Most type parameters a generic function can have
+#define MAX_TYPE_PARAMS 4
+
+// Function parameter
+typedef struct
+{
+    Token name;
+    TokenType type;
+    int typeParam; // In a generic function: the type parameter standing for type, or -1
+} AstParam;
+
+// Function declaration. A generic function (सामान्य) is never analyzed or
+// generated itself: each set of argument types it is called with gets an
+// instance, a copy with the type parameters replaced by those types.
+struct AstFunctionDecl
 {
     AstNode base;
     Token name;
-    TokenType returnType;
+    TokenType returnType; // Type of the values a coroutine yields
     int paramCount;
-    struct
-    {
-        Token name;
-        TokenType type;
-    } *params;
+    AstParam *params;
     AstNode *body;
-} AstFunctionDecl;
+    bool spawns;         // Body runs tasks with कार्य, so it needs a task frame
+    bool spawned;        // Run as a task somewhere, so it needs a task wrapper
+    bool coroutine;      // सहक्रम: resumable, hands out values with रोको_और_दो
+    int slotCount;       // Variables of a coroutine, filled in by semantic analysis
+    AstFrameSlot *slots;
+    int typeParamCount;  // Type parameters of a generic function, 0 for others
+    Token typeParams[MAX_TYPE_PARAMS];
+    int returnTypeParam;      // Type parameter standing for returnType, or -1
+    AstFunctionDecl *generic; // For instances: the generic function; the instance owns its name
+};
 
 // Block statement
 typedef struct
@@ -78,6 +174,7 @@ typedef struct
     int count;
     int capacity;
     AstNode **statements;
+    bool region; // क्षेत्र: containers and strings made inside live in an arena
 } AstBlock;
 
 // If statement
@@ -87,6 +184,8 @@ typedef struct
     AstNode *condition;
     AstNode *thenBranch;
     AstNode *elseBranch; // Optional
+    BranchHint hint;
+    int outcome; // Range analysis: 1 if the condition always holds, 0 if it never does, -1 if not known
 } AstIf;
 
 // While statement
@@ -95,6 +194,7 @@ typedef struct
     AstNode base;
     AstNode *condition;
     AstNode *body;
+    BranchHint hint;
 } AstWhile;
 
 // For statement
@@ -128,14 +228,17 @@ typedef struct
     AstNode *left;
     TokenType operator;
     AstNode *right;
+    bool proven;      // Range analysis showed it cannot overflow or divide by zero
+    bool nonNegative; // Range analysis showed both operands are not negative
 } AstBinary;
 
 // Unary expression
 typedef struct
 {
     AstNode base;
-    TokenType operator;
+    TokenType operator; // TOKEN_INT, TOKEN_FLOAT or TOKEN_CHAR for a conversion
     AstNode *right;
+    bool proven; // Range analysis showed a negation cannot overflow
 } AstUnary;
 
 // Literal value
@@ -150,6 +253,7 @@ typedef struct
 {
     AstNode base;
     Token name;
+    AstVarDecl *constant; // The स्थिर declaration whose value replaces the reference, or NULL
 } AstVariable;
 
 // Assignment
@@ -157,6 +261,7 @@ typedef struct
 {
     AstNode base;
     Token name;
+    AstNode *index; // Optional: assigns one element of a list
     AstNode *value;
 } AstAssignment;
 
@@ -168,8 +273,48 @@ typedef struct
     int argCount;
     int capacity;
     AstNode **arguments;
+    AstFunctionDecl *coroutine; // Coroutine the call starts, resumes or reads, set by semantic analysis
 } AstCall;
 
+// List element: name[index]
+typedef struct
+{
+    AstNode base;
+    Token name;
+    AstNode *index;
+} AstIndex;
+
+// कार्य call: the call runs as a task, and its result (if stored) is only
+// readable after प्रतीक्षा
+typedef struct
+{
+    AstNode base;
+    AstCall *call;
+    bool heapTask; // Spawned from a nested block, so its task outlives the block
+} AstSpawn;
+
+// प्रतीक्षा
+typedef struct
+{
+    AstNode base;
+} AstSync;
+
+// रोको_और_दो value: suspend the coroutine, handing value to whoever resumed it
+typedef struct
+{
+    AstNode base;
+    AstNode *value;
+} AstYield;
+
+// मापो (runs) { body }: run body runs times after a warm-up and report how
+// long the runs took
+typedef struct
+{
+    AstNode base;
+    AstNode *runs;
+    AstNode *body;
+} AstMeasure;
+
 // Functions to create AST nodes
 AstProgram *createProgram();
 AstVarDecl *createVarDecl(Token name, TokenType type, AstNode *initializer);
@@ -186,8 +331,33 @@ AstLiteral *createLiteral(Token value);
 AstVariable *createVariable(Token name);
 AstAssignment *createAssignment(Token name, AstNode *value);
 AstCall *createCall(Token name);
+AstIndex *createIndex(Token name, AstNode *index);
+AstSpawn *createSpawn(AstCall *call);
+AstSync *createSync();
+AstYield *createYield(AstNode *value);
+AstMeasure *createMeasure(AstNode *runs, AstNode *body);
+
+// Add a top-level declaration to a program
+void addDeclaration(AstProgram *program, AstNode *declaration);
+
+// Instance of a generic function for the given types of its type
+// parameters, named name (which the instance takes ownership of)
+AstFunctionDecl *instantiateFunction(AstFunctionDecl *generic, const TokenType *typeArguments, char *name);
 
 // Functions to free AST nodes
 void freeAst(AstNode *node);
 
+// Count the nodes in a subtree (used as a size estimate)
+int countAstNodes(AstNode *node);
+
+// Whether an expression is a string literal, a स्थिर string or a
+// concatenation of them, which is folded at compile time
+bool isStringConstant(AstNode *node);
+
+// The memory order an argument names, or MEMORY_ORDER_NONE
+MemoryOrder memoryOrderOf(AstNode *node);
+
+// The byte a one-character string literal stands for, or -1
+int delimiterOf(AstNode *node);
+
 #endif /* AST_H */
\ No newline at end of file
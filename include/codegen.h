@@ -3,12 +3,41 @@
 #define CODEGEN_H
 
 #include "ast.h"
+#include "analysis.h"
+
+// A string stored in the literal table
+typedef struct
+{
+    char *bytes; // Decoded bytes
+    int length;
+} PooledString;
+
+// Literal table of one translation unit: every distinct string is stored once
+// and the code refers to it by its index in the table
+typedef struct
+{
+    PooledString *entries;
+    int count;
+    int capacity;
+    int *slots; // Open-addressing hash index into entries, -1 when empty
+    int slotCount;
+} StringPool;
 
 // Code generator context
 typedef struct
 {
-    FILE *output;    // Output file for generated code
-    int indentLevel; // Current indentation level
+    FILE *output;               // Output file for generated code
+    int indentLevel;            // Current indentation level
+    CallGraph *callGraph;       // Optional; enables inline/hot/cold hints
+    bool singleFile;            // All functions in one translation unit (static linkage)
+    StringPool *strings;        // Literal table being filled; NULL writes literals in place
+    bool taskFrame;             // The current function has a task frame (hc_frame)
+    AstFunctionDecl *coroutine; // Coroutine whose resume function is being generated
+    int resumePoints;           // रोको_और_दो statements generated in it so far
+    int regionDepth;            // क्षेत्र blocks around the code being generated
+    int measureDepth;           // मापो blocks around the code being generated
+    bool singlePrecision;       // Decimal literals are floats (-fsingle-precision)
+    bool checkedArith;          // पूर्णांक arithmetic traps on overflow (--checked-arith)
 } CodeGenContext;
 
 // Initialize the code generator
@@ -17,8 +46,34 @@ void initCodeGen(CodeGenContext *context, FILE *output);
 // Generate code from AST
 void generateCode(CodeGenContext *context, AstProgram *program);
 
+// Generate code split across several translation units: <basePath>.h with
+// prototypes and globals, <basePath>_1.c .. _N.c balanced by AST size, and a
+// <basePath>.mk makefile snippet for building them in parallel
+bool generateSplitCode(CodeGenContext *context, AstProgram *program, const char *basePath, int parts);
+
+// Print the C compiler flags a generated program needs, when it includes
+// runtime headers: the runtime include path and -pthread for tasks
+void printCompileFlags(CodeGenContext *context, AstProgram *program, const char *outputPath);
+
 // Helper functions
 void emitIndentation(CodeGenContext *context);
 void emitLine(CodeGenContext *context, const char *format, ...);
 
+// String pool
+void initStringPool(StringPool *pool);
+void freeStringPool(StringPool *pool);
+
+// Add bytes to the pool unless an equal string is already there; returns its index
+int internString(StringPool *pool, const char *bytes, int length);
+
+// Append the bytes a C string literal's text (without quotes) denotes
+void decodeStringLiteral(const char *text, int length, char **bytes, int *size, int *capacity);
+
+// Write bytes as the contents of a C string literal, without the quotes
+void writeEscapedString(FILE *output, const char *bytes, int length);
+
+// Write the pool as a static constant table named hc_strings, with one
+// NUL-terminated char array member s<index> per string
+void writeStringPool(FILE *output, StringPool *pool);
+
 #endif /* CODEGEN_H */
\ No newline at end of file
@@ -11,10 +11,16 @@ typedef enum
     TOKEN_EOF = 0,
 
     // Data types
-    TOKEN_INT,   // पूर्णांक
-    TOKEN_FLOAT, // दशमलव
-    TOKEN_CHAR,  // वर्ण
-    TOKEN_VOID,  // शून्य
+    TOKEN_INT,     // पूर्णांक
+    TOKEN_FLOAT,   // दशमलव
+    TOKEN_CHAR,    // वर्ण
+    TOKEN_TEXT,    // पाठ
+    TOKEN_VOID,    // शून्य
+    TOKEN_MAP,     // शब्दकोश
+    TOKEN_LIST,    // सूची
+    TOKEN_CHANNEL, // नलिका
+    TOKEN_ATOMIC,  // परमाणु
+    TOKEN_FILE,    // संचिका
 
     // Control flow
     TOKEN_IF,       // अगर
@@ -26,6 +32,30 @@ typedef enum
     TOKEN_CONTINUE, // जारी
     TOKEN_RETURN,   // वापस
 
+    // Branch hints
+    TOKEN_LIKELY,   // संभावित
+    TOKEN_UNLIKELY, // असंभावित
+
+    // Tasks
+    TOKEN_SPAWN, // कार्य
+    TOKEN_SYNC,  // प्रतीक्षा
+
+    // Coroutines
+    TOKEN_COROUTINE, // सहक्रम
+    TOKEN_YIELD,     // रोको_और_दो
+
+    // Regions
+    TOKEN_REGION, // क्षेत्र
+
+    // Benchmarks
+    TOKEN_MEASURE, // मापो
+
+    // Generics
+    TOKEN_GENERIC, // सामान्य
+
+    // Constants
+    TOKEN_CONST, // स्थिर
+
     // Literals & Identifiers
     TOKEN_IDENTIFIER,
     TOKEN_NUMBER,
@@ -55,6 +85,8 @@ typedef enum
     TOKEN_RPAREN,    // )
     TOKEN_LBRACE,    // {
     TOKEN_RBRACE,    // }
+    TOKEN_LBRACKET,  // [
+    TOKEN_RBRACKET,  // ]
 
     // Error token
     TOKEN_ERROR
@@ -90,4 +122,7 @@ void initLexer(Lexer *lexer, const char *source);
 Token scanToken(Lexer *lexer);
 const char *getTokenName(TokenType type);
 
+// Find the next printf conversion in the text of a format string
+int nextFormatConversion(const char *text, int length, int from);
+
 #endif /* LEXER_H */
\ No newline at end of file
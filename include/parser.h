@@ -12,6 +12,8 @@ typedef struct
     Token previous;
     bool hadError;
     bool panicMode;
+    Token typeParams[MAX_TYPE_PARAMS]; // Of the generic function being parsed
+    int typeParamCount;
 } Parser;
 
 // Initialize the parser
@@ -16,10 +16,19 @@ typedef struct Symbol
 {
     char *name;
     SymbolType type;
-    TokenType dataType;    // For variables and function return types
-    int paramCount;        // For functions
-    TokenType *paramTypes; // For functions
+    TokenType dataType;         // For variables and function return types
+    TokenType keyType;          // For maps
+    TokenType elemType;         // For containers, and the values of coroutines
+    int paramCount;             // For functions
+    TokenType *paramTypes;      // For functions
     int scopeDepth;
+    bool pendingTask;           // Receives the result of a कार्य not yet waited for
+    AstFunctionDecl *coroutine; // For सहक्रम variables: the coroutine they run
+    AstFunctionDecl *generic;   // For generic functions: the declaration instances are copied from
+    AstVarDecl *constant;       // For स्थिर variables: their declaration
+    int frameSlot;              // Index in the enclosing coroutine's slots, or -1
+    int yieldsBefore;           // रोको_और_दो statements analyzed before the definition
+    int lastUse;                // Use count at the latest reference
     struct Symbol *next;
 } Symbol;
 
@@ -34,6 +43,17 @@ typedef struct
 typedef struct
 {
     int errorCount;
+    int runtimeFeatures;   // RuntimeFeature bits the program uses
+    bool temporaryAllowed; // The next expression analyzed may create a new string
+    bool formatString;     // Analyzing a format string, which printf takes as plain bytes
+    AstProgram *program;       // Program being analyzed
+    AstFunctionDecl *function; // Function being analyzed (NULL at global scope)
+    int functionDepth;         // Scope depth of that function's body
+    int yieldCount;            // रोको_और_दो statements analyzed so far in that function
+    int useCount;              // Variable references analyzed so far
+    int regionDepth;           // Scope depth of the innermost क्षेत्र body, 0 outside
+    int measureDepth;          // मापो blocks being analyzed
+    bool singlePrecision;      // Decimal literals are floats (-fsingle-precision), not doubles
 } SemanticContext;
 
 // Initialize the semantic analyzer
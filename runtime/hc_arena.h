@@ -0,0 +1,138 @@
+/* runtime/hc_arena.h */
+#ifndef HC_ARENA_H
+#define HC_ARENA_H
+
+// Bump allocator for short-lived container storage. Allocations are never
+// freed one by one; the whole arena is reset or freed at once.
+
+#include "hc_common.h"
+
+#define HC_ARENA_ALIGN 16
+#define HC_ARENA_CHUNK_SIZE (64 * 1024)
+
+typedef struct hc_arena_chunk
+{
+    struct hc_arena_chunk *next; // Older chunk
+    size_t size;
+    size_t used;
+    _Alignas(HC_ARENA_ALIGN) unsigned char data[];
+} hc_arena_chunk;
+
+typedef struct
+{
+    hc_arena_chunk *head; // Chunk currently bumped
+    void *last;           // Most recent allocation, which can grow in place
+} hc_arena;
+
+static inline size_t hc_arena_round(size_t size)
+{
+    return (size + HC_ARENA_ALIGN - 1) & ~(size_t)(HC_ARENA_ALIGN - 1);
+}
+
+static void hc_arena_add_chunk(hc_arena *arena, size_t size)
+{
+    // Chunks double so that large arenas need few of them
+    size_t chunkSize = arena->head != NULL ? arena->head->size * 2 : HC_ARENA_CHUNK_SIZE;
+    if (chunkSize < size)
+        chunkSize = size;
+
+    hc_arena_chunk *chunk = (hc_arena_chunk *)hc_alloc(sizeof(hc_arena_chunk) + chunkSize);
+    chunk->next = arena->head;
+    chunk->size = chunkSize;
+    chunk->used = 0;
+    arena->head = chunk;
+}
+
+static inline void *hc_arena_alloc(hc_arena *arena, size_t size)
+{
+    size = hc_arena_round(size);
+    if (HC_RUNTIME_UNLIKELY(arena->head == NULL || arena->head->size - arena->head->used < size))
+        hc_arena_add_chunk(arena, size);
+
+    void *memory = arena->head->data + arena->head->used;
+    arena->head->used += size;
+    arena->last = memory;
+    return memory;
+}
+
+// Grow an allocation, in place when it is the most recent one and fits
+static inline void *hc_arena_grow(hc_arena *arena, void *memory, size_t oldSize, size_t newSize)
+{
+    if (memory != NULL && memory == arena->last)
+    {
+        size_t offset = (size_t)((unsigned char *)memory - arena->head->data);
+        if (offset + hc_arena_round(newSize) <= arena->head->size)
+        {
+            arena->head->used = offset + hc_arena_round(newSize);
+            return memory;
+        }
+    }
+
+    void *grown = hc_arena_alloc(arena, newSize);
+    if (memory != NULL)
+        memcpy(grown, memory, oldSize);
+    return grown;
+}
+
+// Drop every allocation but keep the newest (largest) chunk for reuse
+static inline void hc_arena_reset(hc_arena *arena)
+{
+    if (arena->head == NULL)
+        return;
+
+    hc_arena_chunk *chunk = arena->head->next;
+    while (chunk != NULL)
+    {
+        hc_arena_chunk *next = chunk->next;
+        hc_release(chunk);
+        chunk = next;
+    }
+    arena->head->next = NULL;
+    arena->head->used = 0;
+    arena->last = NULL;
+}
+
+static inline void hc_arena_free(hc_arena *arena)
+{
+    hc_arena_reset(arena);
+    hc_release(arena->head);
+    arena->head = NULL;
+}
+
+// क्षेत्र blocks take their arena from a per-thread pool and hand it back
+// reset. A block entered on every iteration of a loop thus reuses the chunk
+// it grew on the first iterations, and leaving it frees nothing.
+typedef struct hc_region
+{
+    hc_arena arena;         // First, so the arena's address is the region's
+    struct hc_region *next; // Next idle region in the pool
+} hc_region;
+
+static _Thread_local hc_region *hc_region_pool;
+
+static inline hc_arena *hc_region_enter(void)
+{
+    hc_region *region = hc_region_pool;
+    if (HC_RUNTIME_LIKELY(region != NULL))
+    {
+        hc_region_pool = region->next;
+    }
+    else
+    {
+        region = (hc_region *)hc_alloc(sizeof(hc_region));
+        region->arena.head = NULL;
+        region->arena.last = NULL;
+    }
+    return &region->arena;
+}
+
+// Cleanup of the arena variable a क्षेत्र block declares
+static inline void hc_region_leave(hc_arena **arena)
+{
+    hc_region *region = (hc_region *)*arena;
+    hc_arena_reset(&region->arena);
+    region->next = hc_region_pool;
+    hc_region_pool = region;
+}
+
+#endif /* HC_ARENA_H */
@@ -0,0 +1,23 @@
+/* runtime/hc_atomic.h */
+#ifndef HC_ATOMIC_H
+#define HC_ATOMIC_H
+
+// परमाणु: integers shared between tasks. Loads, stores and fetch-add map
+// directly onto C11 atomics; compare-exchange is wrapped so that it can be
+// used as an expression.
+
+#include <stdatomic.h>
+
+// Store desired into *atomic if it holds expected; 1 if it did. A failed
+// exchange is only a load, so it gets the strongest order a load can have
+// that is no stronger than order.
+static inline int hc_atomic_compare_exchange(atomic_int *atomic, int expected, int desired,
+                                             memory_order order)
+{
+    memory_order failure = order == memory_order_release   ? memory_order_relaxed
+                           : order == memory_order_acq_rel ? memory_order_acquire
+                                                           : order;
+    return atomic_compare_exchange_strong_explicit(atomic, &expected, desired, order, failure);
+}
+
+#endif /* HC_ATOMIC_H */
@@ -0,0 +1,247 @@
+/* runtime/hc_chan.h */
+#ifndef HC_CHAN_H
+#define HC_CHAN_H
+
+// नलिका: typed channel between tasks.
+//
+// Buffered channels are bounded lock-free MPMC rings (Dmitry Vyukov's
+// design): every cell carries a sequence number that tells producers and
+// consumers whose turn it is, so each operation is one CAS on a position
+// counter plus one release store on the cell. Unbuffered channels use the
+// same ring with two cells, and a send returns only once a receiver has
+// taken its value.
+//
+// Threads that cannot make progress spin and yield briefly, then sleep on a
+// futex that every completed operation wakes when there are sleepers.
+// Sleeping task workers tell the task pool, which adds a worker when all of
+// them are blocked, so a pipeline of tasks never starves itself of threads.
+//
+// A cell's sequence is stored relative to its index, so all-zero storage is
+// a valid empty ring and channels need no initialization code.
+
+// syscall() and SYS_futex are hidden by -std=c99 and -std=c11 without it
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "hc_common.h"
+#include "hc_task.h"
+#include <limits.h>
+#include <stdatomic.h>
+
+#include <sched.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Failed attempts a blocked operation spins for, then yields its CPU for,
+// before it goes to sleep
+#define HC_CHAN_SPINS 32
+#define HC_CHAN_YIELDS 64
+
+typedef struct
+{
+    atomic_uint epoch;  // Bumped whenever sleepers need to recheck
+    atomic_int waiters; // Threads asleep or about to sleep on epoch
+} hc_chan_wait;
+
+static inline void hc_chan_sleep(hc_chan_wait *wait, unsigned epoch)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, (unsigned *)&wait->epoch, FUTEX_WAIT_PRIVATE, epoch, NULL, NULL, 0);
+#else
+    (void)wait;
+    (void)epoch;
+    sched_yield();
+#endif
+}
+
+// Called after every completed operation
+static inline void hc_chan_notify(hc_chan_wait *wait)
+{
+    // Pairs with the fence in HC_CHAN_BLOCK: either the sleeper sees our
+    // operation when it rechecks, or we see its waiter count
+    atomic_thread_fence(memory_order_seq_cst);
+    if (HC_RUNTIME_LIKELY(atomic_load_explicit(&wait->waiters, memory_order_relaxed) == 0))
+        return;
+
+    atomic_fetch_add_explicit(&wait->epoch, 1, memory_order_release);
+#if defined(__linux__)
+    syscall(SYS_futex, (unsigned *)&wait->epoch, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+static inline void hc_chan_pause(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Run ATTEMPT (which sets done) until it succeeds, sleeping when spinning
+// does not help
+#define HC_CHAN_BLOCK(wait, done, ATTEMPT)                                            \
+    for (int spins_ = 0; !(done); spins_++)                                           \
+    {                                                                                 \
+        ATTEMPT;                                                                      \
+        if (done)                                                                     \
+            break;                                                                    \
+        if (spins_ < HC_CHAN_SPINS)                                                   \
+        {                                                                             \
+            hc_chan_pause();                                                          \
+            continue;                                                                 \
+        }                                                                             \
+        if (spins_ < HC_CHAN_YIELDS)                                                  \
+        {                                                                             \
+            sched_yield();                                                            \
+            continue;                                                                 \
+        }                                                                             \
+        unsigned epoch_ = atomic_load_explicit(&(wait)->epoch, memory_order_acquire); \
+        atomic_fetch_add_explicit(&(wait)->waiters, 1, memory_order_relaxed);         \
+        atomic_thread_fence(memory_order_seq_cst);                                    \
+        ATTEMPT;                                                                      \
+        if (!(done))                                                                  \
+        {                                                                             \
+            hc_task_block_begin();                                                    \
+            hc_chan_sleep(wait, epoch_);                                              \
+            hc_task_block_end();                                                      \
+        }                                                                             \
+        atomic_fetch_sub_explicit(&(wait)->waiters, 1, memory_order_relaxed);         \
+    }
+
+// Stamp out a channel type NAME carrying values of type T
+#define HC_DEFINE_CHAN(NAME, T)                                                                 \
+    typedef struct                                                                              \
+    {                                                                                           \
+        atomic_size_t sequence; /* Minus the cell's index */                                    \
+        T value;                                                                                \
+    } NAME##_cell;                                                                              \
+                                                                                                \
+    typedef struct                                                                              \
+    {                                                                                           \
+        /* Producers and consumers each get a cache line */                                     \
+        _Alignas(64) atomic_size_t enqueue;                                                     \
+        _Alignas(64) atomic_size_t dequeue;                                                     \
+        _Alignas(64) hc_chan_wait wait;                                                         \
+        NAME##_cell *cells;                                                                     \
+        size_t mask;    /* Capacity - 1; the capacity is a power of two, at least 2 */          \
+        int rendezvous; /* Unbuffered: a send waits until its value is received */              \
+    } NAME;                                                                                     \
+                                                                                                \
+    /* Claim a free cell and fill it; *position is where the value went */                      \
+    static inline int NAME##_try_send(NAME *channel, T value, size_t *position)                 \
+    {                                                                                           \
+        size_t pos = atomic_load_explicit(&channel->enqueue, memory_order_relaxed);             \
+        for (;;)                                                                                \
+        {                                                                                       \
+            NAME##_cell *cell = &channel->cells[pos & channel->mask];                           \
+            size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);      \
+            intptr_t difference = (intptr_t)sequence - (intptr_t)(pos & ~channel->mask);        \
+            if (difference == 0)                                                                \
+            {                                                                                   \
+                if (atomic_compare_exchange_weak_explicit(&channel->enqueue, &pos, pos + 1,     \
+                                                          memory_order_relaxed,                 \
+                                                          memory_order_relaxed))                \
+                {                                                                               \
+                    cell->value = value;                                                        \
+                    atomic_store_explicit(&cell->sequence, (pos & ~channel->mask) + 1,          \
+                                          memory_order_release);                                \
+                    *position = pos;                                                            \
+                    return 1;                                                                   \
+                }                                                                               \
+            }                                                                                   \
+            else if (difference < 0)                                                            \
+            {                                                                                   \
+                return 0; /* Full */                                                            \
+            }                                                                                   \
+            else                                                                                \
+            {                                                                                   \
+                pos = atomic_load_explicit(&channel->enqueue, memory_order_relaxed);            \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    static inline int NAME##_try_recv(NAME *channel, T *value)                                  \
+    {                                                                                           \
+        size_t pos = atomic_load_explicit(&channel->dequeue, memory_order_relaxed);             \
+        for (;;)                                                                                \
+        {                                                                                       \
+            NAME##_cell *cell = &channel->cells[pos & channel->mask];                           \
+            size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);      \
+            intptr_t difference = (intptr_t)sequence - (intptr_t)((pos & ~channel->mask) + 1);  \
+            if (difference == 0)                                                                \
+            {                                                                                   \
+                if (atomic_compare_exchange_weak_explicit(&channel->dequeue, &pos, pos + 1,     \
+                                                          memory_order_relaxed,                 \
+                                                          memory_order_relaxed))                \
+                {                                                                               \
+                    *value = cell->value;                                                       \
+                    /* Free for the producer one lap later */                                   \
+                    atomic_store_explicit(&cell->sequence,                                      \
+                                          (pos & ~channel->mask) + channel->mask + 1,           \
+                                          memory_order_release);                                \
+                    return 1;                                                                   \
+                }                                                                               \
+            }                                                                                   \
+            else if (difference < 0)                                                            \
+            {                                                                                   \
+                return 0; /* Empty */                                                           \
+            }                                                                                   \
+            else                                                                                \
+            {                                                                                   \
+                pos = atomic_load_explicit(&channel->dequeue, memory_order_relaxed);            \
+            }                                                                                   \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    static inline void NAME##_send(NAME *channel, T value)                                      \
+    {                                                                                           \
+        size_t position = 0;                                                                    \
+        int sent = 0;                                                                           \
+        HC_CHAN_BLOCK(&channel->wait, sent, sent = NAME##_try_send(channel, value, &position)); \
+        hc_chan_notify(&channel->wait);                                                         \
+                                                                                                \
+        if (channel->rendezvous)                                                                \
+        {                                                                                       \
+            /* Handoff: wait until a receiver has claimed this position */                      \
+            int taken = 0;                                                                      \
+            HC_CHAN_BLOCK(&channel->wait, taken,                                                \
+                          taken = atomic_load_explicit(&channel->dequeue,                       \
+                                                       memory_order_acquire) > position);       \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    static inline T NAME##_recv(NAME *channel)                                                  \
+    {                                                                                           \
+        T value;                                                                                \
+        int received = 0;                                                                       \
+        HC_CHAN_BLOCK(&channel->wait, received, received = NAME##_try_recv(channel, &value));   \
+        hc_chan_notify(&channel->wait);                                                         \
+        return value;                                                                           \
+    }
+
+// Static initializer over zeroed storage for CAPACITY cells (a power of
+// two, at least 2)
+#define HC_CHAN_INIT(storage, capacity, unbuffered) \
+    {.cells = (storage), .mask = (capacity) - 1, .rendezvous = (unbuffered)}
+
+// Channels carry plain values only: strings share a reference count that is
+// not atomic
+HC_DEFINE_CHAN(hc_chan_int, int)
+HC_DEFINE_CHAN(hc_chan_float, float)
+HC_DEFINE_CHAN(hc_chan_char, char)
+
+// Type-directed dispatch used by generated code
+#define HC_CHAN_DISPATCH(channel, op)        \
+    _Generic((channel),                      \
+        hc_chan_int *: hc_chan_int_##op,     \
+        hc_chan_float *: hc_chan_float_##op, \
+        hc_chan_char *: hc_chan_char_##op)
+
+#define hc_chan_send(channel, value) HC_CHAN_DISPATCH(channel, send)(channel, value)
+#define hc_chan_recv(channel) HC_CHAN_DISPATCH(channel, recv)(channel)
+
+#endif /* HC_CHAN_H */
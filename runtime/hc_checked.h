@@ -0,0 +1,91 @@
+/* runtime/hc_checked.h */
+#ifndef HC_CHECKED_H
+#define HC_CHECKED_H
+
+// --checked-arith: पूर्णांक arithmetic that stops the program instead of
+// running into undefined behaviour. Sums, differences and products go
+// through the compilers' overflow builtins, which compile to the operation
+// and a branch on the overflow flag; division checks for a zero divisor and
+// for INT_MIN / -1. The report names the line of the Hindi source. It lives
+// in a cold function that is never inlined, so the checks add little more
+// than a predicted branch to the code around them.
+
+#include "hc_common.h"
+#include <limits.h>
+
+#if defined(__GNUC__)
+#define HC_CHECKED_TRAP __attribute__((cold, noinline, noreturn))
+#define HC_CHECKED_ADD(a, b, result) __builtin_add_overflow(a, b, result)
+#define HC_CHECKED_SUB(a, b, result) __builtin_sub_overflow(a, b, result)
+#define HC_CHECKED_MUL(a, b, result) __builtin_mul_overflow(a, b, result)
+#else
+#define HC_CHECKED_TRAP
+
+// Store the low 32 bits of a 64-bit result; 1 if they lost something
+static inline int hc_checked_narrow(long long value, int *result)
+{
+    *result = (int)value;
+    return value < INT_MIN || value > INT_MAX;
+}
+
+#define HC_CHECKED_ADD(a, b, result) hc_checked_narrow((long long)(a) + (b), result)
+#define HC_CHECKED_SUB(a, b, result) hc_checked_narrow((long long)(a) - (b), result)
+#define HC_CHECKED_MUL(a, b, result) hc_checked_narrow((long long)(a) * (b), result)
+#endif
+
+static HC_CHECKED_TRAP void hc_checked_trap(int line, const char *problem)
+{
+    fprintf(stderr, "hindic runtime: line %d: %s\n", line, problem);
+    exit(1);
+}
+
+static inline int hc_checked_add(int a, int b, int line)
+{
+    int result;
+    if (HC_RUNTIME_UNLIKELY(HC_CHECKED_ADD(a, b, &result)))
+        hc_checked_trap(line, "integer overflow in +");
+    return result;
+}
+
+static inline int hc_checked_sub(int a, int b, int line)
+{
+    int result;
+    if (HC_RUNTIME_UNLIKELY(HC_CHECKED_SUB(a, b, &result)))
+        hc_checked_trap(line, "integer overflow in -");
+    return result;
+}
+
+static inline int hc_checked_mul(int a, int b, int line)
+{
+    int result;
+    if (HC_RUNTIME_UNLIKELY(HC_CHECKED_MUL(a, b, &result)))
+        hc_checked_trap(line, "integer overflow in *");
+    return result;
+}
+
+static inline int hc_checked_neg(int a, int line)
+{
+    if (HC_RUNTIME_UNLIKELY(a == INT_MIN))
+        hc_checked_trap(line, "integer overflow in -");
+    return -a;
+}
+
+static inline int hc_checked_div(int a, int b, int line)
+{
+    if (HC_RUNTIME_UNLIKELY(b == 0))
+        hc_checked_trap(line, "division by zero");
+    if (HC_RUNTIME_UNLIKELY(a == INT_MIN && b == -1))
+        hc_checked_trap(line, "integer overflow in /");
+    return a / b;
+}
+
+static inline int hc_checked_mod(int a, int b, int line)
+{
+    if (HC_RUNTIME_UNLIKELY(b == 0))
+        hc_checked_trap(line, "division by zero");
+    if (HC_RUNTIME_UNLIKELY(a == INT_MIN && b == -1))
+        hc_checked_trap(line, "integer overflow in %");
+    return a % b;
+}
+
+#endif /* HC_CHECKED_H */
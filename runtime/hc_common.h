@@ -0,0 +1,56 @@
+/* runtime/hc_common.h */
+#ifndef HC_COMMON_H
+#define HC_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// GNU extensions used by the runtime degrade to plain C elsewhere
+#if defined(__GNUC__)
+#define HC_CLEANUP(fn) __attribute__((cleanup(fn)))
+#define HC_RUNTIME_LIKELY(x) __builtin_expect(!!(x), 1)
+#define HC_RUNTIME_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define HC_CLEANUP(fn)
+#define HC_RUNTIME_LIKELY(x) (x)
+#define HC_RUNTIME_UNLIKELY(x) (x)
+#endif
+
+// Element hooks for containers of plain values: copying is assignment and
+// nothing needs releasing
+#define HC_SCALAR_COPY(value) (value)
+#define HC_SCALAR_DROP(pointer) ((void)(pointer))
+
+// Report an unrecoverable runtime error and stop the program
+static inline void hc_fatal(const char *message)
+{
+    fprintf(stderr, "hindic runtime: %s\n", message);
+    exit(1);
+}
+
+// All container storage goes through these two functions
+static inline void *hc_alloc(size_t size)
+{
+    void *memory = malloc(size);
+    if (HC_RUNTIME_UNLIKELY(memory == NULL && size > 0))
+        hc_fatal("out of memory");
+    return memory;
+}
+
+static inline void *hc_resize(void *memory, size_t size)
+{
+    memory = realloc(memory, size);
+    if (HC_RUNTIME_UNLIKELY(memory == NULL && size > 0))
+        hc_fatal("out of memory");
+    return memory;
+}
+
+static inline void hc_release(void *memory)
+{
+    free(memory);
+}
+
+#endif /* HC_COMMON_H */
@@ -0,0 +1,438 @@
+/* runtime/hc_csv.h */
+#ifndef HC_CSV_H
+#define HC_CSV_H
+
+// तालिका_पढ़ो: CSV/TSV reader that fills lists column by column.
+//
+// The file is mapped with hc_file_open and classified 64 bytes at a time,
+// as simdcsv does: SIMD compares give one bitmask each of the quotes,
+// delimiters and line breaks in a block, a prefix XOR of the quote mask gives
+// the bytes inside quoted fields, and the delimiters and line breaks outside
+// them are the field boundaries. The reader then only visits boundaries.
+//
+// Numeric fields are parsed straight into the int or float list of their
+// column. Text fields are views of the mapping unless they need unescaping.
+
+#include "hc_common.h"
+#include "hc_file.h"
+#include "hc_list.h"
+#include "hc_str.h"
+#include <limits.h>
+
+#if defined(__AVX2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#endif
+
+typedef enum
+{
+    HC_CSV_INT,
+    HC_CSV_FLOAT,
+    HC_CSV_TEXT,
+} hc_csv_kind;
+
+// A column to read and the list that receives it
+typedef struct
+{
+    int index; // Zero-based position in the record
+    hc_csv_kind kind;
+    void *list;
+} hc_csv_column;
+
+// Descriptor for a list; its element type picks how the column is parsed
+#define HC_CSV_COLUMN(index, list)                                                          \
+    {(index),                                                                               \
+     _Generic((list), hc_list_int *: HC_CSV_INT, hc_list_float *: HC_CSV_FLOAT,             \
+              hc_list_str *: HC_CSV_TEXT),                                                  \
+     (list)}
+
+// Bitmasks of the quotes, delimiters and line breaks in a 64-byte block
+typedef struct
+{
+    uint64_t quote;
+    uint64_t delimiter;
+    uint64_t newline;
+} hc_csv_masks;
+
+#if defined(__AVX2__)
+static inline uint32_t hc_csv_match32(__m256i block, char c)
+{
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(c)));
+}
+#elif defined(__SSE2__)
+static inline uint64_t hc_csv_match16(__m128i block, char c, int shift)
+{
+    return (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(c))) << shift;
+}
+#endif
+
+static inline hc_csv_masks hc_csv_classify(const char *block, char delimiter)
+{
+    hc_csv_masks masks = {0, 0, 0};
+#if defined(__AVX2__)
+    for (int half = 0; half < 2; half++)
+    {
+        __m256i bytes = _mm256_loadu_si256((const __m256i *)(block + 32 * half));
+        masks.quote |= (uint64_t)hc_csv_match32(bytes, '"') << (32 * half);
+        masks.delimiter |= (uint64_t)hc_csv_match32(bytes, delimiter) << (32 * half);
+        masks.newline |= (uint64_t)hc_csv_match32(bytes, '\n') << (32 * half);
+    }
+#elif defined(__SSE2__)
+    for (int quarter = 0; quarter < 4; quarter++)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(block + 16 * quarter));
+        masks.quote |= hc_csv_match16(bytes, '"', 16 * quarter);
+        masks.delimiter |= hc_csv_match16(bytes, delimiter, 16 * quarter);
+        masks.newline |= hc_csv_match16(bytes, '\n', 16 * quarter);
+    }
+#else
+    for (int i = 0; i < 64; i++)
+    {
+        masks.quote |= (uint64_t)(block[i] == '"') << i;
+        masks.delimiter |= (uint64_t)(block[i] == delimiter) << i;
+        masks.newline |= (uint64_t)(block[i] == '\n') << i;
+    }
+#endif
+    return masks;
+}
+
+// Bit i of the result is the XOR of bits 0..i of x: set for every byte from
+// an opening quote up to, not including, its closing quote
+static inline uint64_t hc_csv_prefix_xor(uint64_t x)
+{
+#if defined(__PCLMUL__)
+    __m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)x), _mm_set1_epi8((char)0xFF), 0);
+    return (uint64_t)_mm_cvtsi128_si64(product);
+#else
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+#endif
+}
+
+// Decimal integer filling the whole field
+static inline int hc_csv_parse_int(const char *p, const char *end, int *value)
+{
+    int negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+'))
+        p++;
+    if (p == end || end - p > 10)
+        return 0;
+
+    int64_t result = 0;
+    for (; p < end; p++)
+    {
+        unsigned digit = (unsigned)(*p - '0');
+        if (digit > 9)
+            return 0;
+        result = result * 10 + digit;
+    }
+    result = negative ? -result : result;
+    if (result < INT_MIN || result > INT_MAX)
+        return 0;
+    *value = (int)result;
+    return 1;
+}
+
+// Decimal number filling the whole field. Short mantissas with small
+// exponents are exact in float arithmetic (Clinger's fast path); anything
+// else goes through strtof.
+static inline int hc_csv_parse_float(const char *p, const char *end, float *value)
+{
+    static const float powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    const char *start = p;
+
+    int negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+'))
+        p++;
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    int seen = 0;
+    for (; p < end && (unsigned)(*p - '0') <= 9; p++, seen++)
+    {
+        if (mantissa != 0 || *p != '0')
+            digits++;
+        mantissa = digits <= 19 ? mantissa * 10 + (unsigned)(*p - '0') : mantissa;
+        exponent += digits > 19;
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && (unsigned)(*p - '0') <= 9; p++, seen++)
+        {
+            if (mantissa != 0 || *p != '0')
+                digits++;
+            if (digits <= 19)
+            {
+                mantissa = mantissa * 10 + (unsigned)(*p - '0');
+                exponent--;
+            }
+        }
+    }
+    if (seen == 0)
+        return 0;
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        int sign = p < end && *p == '-' ? -1 : 1;
+        if (p < end && (*p == '-' || *p == '+'))
+            p++;
+        int power = 0;
+        if (p == end)
+            return 0;
+        for (; p < end && (unsigned)(*p - '0') <= 9; p++)
+            power = power < 10000 ? power * 10 + (*p - '0') : power;
+        exponent += sign * power;
+    }
+    if (p != end)
+        return 0;
+
+    if (mantissa < (1u << 24) && exponent >= -10 && exponent <= 10)
+    {
+        float result = (float)mantissa;
+        result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+        *value = negative ? -result : result;
+        return 1;
+    }
+
+    char copy[128];
+    if ((size_t)(end - start) >= sizeof(copy))
+        return 0;
+    memcpy(copy, start, (size_t)(end - start));
+    copy[end - start] = '\0';
+    *value = strtof(copy, NULL);
+    return 1;
+}
+
+// Reader state while walking the boundaries
+typedef struct
+{
+    const hc_csv_column *columns;
+    int count;
+    int *wanted;       // Column position to index in columns, or -1
+    int width;         // Positions up to the last wanted column
+    size_t *lengths;   // List lengths before the first record
+    int field;         // Position of the next field in the record
+    int rows;          // Records read
+    int header;        // 1 while the first record fails to parse as numbers, 2 once dropped
+    size_t line;       // Lines before the current record, for messages
+} hc_csv_reader;
+
+static inline size_t *hc_csv_list_length(hc_csv_column column)
+{
+    switch (column.kind)
+    {
+    case HC_CSV_INT:
+        return &((hc_list_int *)column.list)->length;
+    case HC_CSV_FLOAT:
+        return &((hc_list_float *)column.list)->length;
+    default:
+        return &((hc_list_str *)column.list)->length;
+    }
+}
+
+static inline void hc_csv_fail(hc_csv_reader *reader, const char *problem)
+{
+    fprintf(stderr, "hindic runtime: line %zu, column %d: %s\n", reader->line + 1, reader->field, problem);
+    exit(1);
+}
+
+// Text of a field, with its quotes removed and doubled quotes undone
+static inline hc_str hc_csv_text(const char *p, const char *end)
+{
+    if (end - p < 2 || *p != '"')
+        return hc_file_view(p, (size_t)(end - p));
+
+    p++;
+    end -= end[-1] == '"';
+    if (hc_file_find(p, end, '"') == end)
+        return hc_file_view(p, (size_t)(end - p));
+
+    size_t length = (size_t)(end - p);
+    for (const char *q = p; q + 1 < end; q++)
+    {
+        if (q[0] == '"' && q[1] == '"')
+        {
+            length--;
+            q++;
+        }
+    }
+
+    hc_str text;
+    char *out = hc_str_reserve(&text, length);
+    for (; p < end; p++)
+    {
+        *out++ = *p;
+        p += *p == '"' && p + 1 < end && p[1] == '"';
+    }
+    return text;
+}
+
+static inline void hc_csv_field(hc_csv_reader *reader, const char *p, const char *end)
+{
+    int position = reader->field++;
+    if (position >= reader->width || reader->wanted[position] < 0)
+        return;
+
+    hc_csv_column column = reader->columns[reader->wanted[position]];
+    if (column.kind == HC_CSV_TEXT)
+    {
+        hc_str text = hc_csv_text(p, end);
+        hc_list_str_push((hc_list_str *)column.list, text);
+        hc_str_release(&text);
+        return;
+    }
+
+    // Numbers may be quoted
+    if (end - p >= 2 && *p == '"' && end[-1] == '"')
+    {
+        p++;
+        end--;
+    }
+
+    int parsed;
+    if (column.kind == HC_CSV_INT)
+    {
+        int value = 0;
+        parsed = hc_csv_parse_int(p, end, &value);
+        if (parsed)
+            hc_list_int_push((hc_list_int *)column.list, value);
+    }
+    else
+    {
+        float value = 0;
+        parsed = hc_csv_parse_float(p, end, &value);
+        if (parsed)
+            hc_list_float_push((hc_list_float *)column.list, value);
+    }
+
+    if (HC_RUNTIME_UNLIKELY(!parsed))
+    {
+        // A first record that is not numbers is a header
+        if (reader->rows > 0 || reader->header == 2)
+            hc_csv_fail(reader, "not a number");
+        reader->header = 1;
+    }
+}
+
+// Close the record whose last field was just read
+static inline void hc_csv_record(hc_csv_reader *reader)
+{
+    if (HC_RUNTIME_UNLIKELY(reader->field < reader->width))
+    {
+        reader->field = reader->width;
+        hc_csv_fail(reader, "missing field");
+    }
+    reader->line++;
+    reader->field = 0;
+
+    if (HC_RUNTIME_UNLIKELY(reader->header == 1))
+    {
+        // Drop whatever the header row added
+        for (int i = 0; i < reader->count; i++)
+        {
+            hc_csv_column column = reader->columns[i];
+            size_t *length = hc_csv_list_length(column);
+            while (*length > reader->lengths[i])
+            {
+                if (column.kind == HC_CSV_TEXT)
+                    hc_str_drop(hc_list_str_pop((hc_list_str *)column.list));
+                else
+                    --*length;
+            }
+        }
+        reader->header = 2;
+        return;
+    }
+    reader->rows++;
+}
+
+// Read the listed columns of every record of the file at path into their
+// lists; returns the number of records read, a header row not included
+static inline int hc_csv_read(hc_str path, char delimiter, const hc_csv_column *columns, int count)
+{
+    hc_file file = hc_file_open(path);
+
+    hc_csv_reader reader;
+    memset(&reader, 0, sizeof(reader));
+    reader.columns = columns;
+    reader.count = count;
+    for (int i = 0; i < count; i++)
+        reader.width = columns[i].index >= reader.width ? columns[i].index + 1 : reader.width;
+    reader.wanted = (int *)hc_alloc(sizeof(int) * (size_t)reader.width);
+    reader.lengths = (size_t *)hc_alloc(sizeof(size_t) * (size_t)count);
+    for (int i = 0; i < reader.width; i++)
+        reader.wanted[i] = -1;
+    for (int i = 0; i < count; i++)
+    {
+        reader.wanted[columns[i].index] = i;
+        reader.lengths[i] = *hc_csv_list_length(columns[i]);
+    }
+
+    const char *data = file.data;
+    size_t fieldStart = 0;
+    uint64_t quoted = 0; // All ones while a quoted field continues into the next block
+
+    for (size_t base = 0; base < file.size; base += 64)
+    {
+        hc_csv_masks masks;
+        if (file.size - base >= 64)
+        {
+            masks = hc_csv_classify(data + base, delimiter);
+        }
+        else
+        {
+            // The last block is classified from a padded copy
+            char tail[64];
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, data + base, file.size - base);
+            masks = hc_csv_classify(tail, delimiter);
+        }
+
+        uint64_t inside = hc_csv_prefix_xor(masks.quote) ^ quoted;
+        quoted = (uint64_t)((int64_t)inside >> 63);
+
+        uint64_t boundaries = (masks.delimiter | masks.newline) & ~inside;
+        while (boundaries != 0)
+        {
+            int bit = __builtin_ctzll(boundaries);
+            size_t position = base + (size_t)bit;
+
+            size_t fieldEnd = position;
+            int newline = (masks.newline >> bit) & 1;
+            if (newline && fieldEnd > fieldStart && data[fieldEnd - 1] == '\r')
+                fieldEnd--;
+
+            if (newline && reader.field == 0 && fieldEnd == fieldStart)
+            {
+                reader.line++; // Blank lines hold no record
+            }
+            else
+            {
+                hc_csv_field(&reader, data + fieldStart, data + fieldEnd);
+                if (newline)
+                    hc_csv_record(&reader);
+            }
+
+            fieldStart = position + 1;
+            boundaries &= boundaries - 1;
+        }
+    }
+
+    // A last record without a line break
+    if (fieldStart < file.size || reader.field > 0)
+    {
+        hc_csv_field(&reader, data + fieldStart, data + file.size);
+        hc_csv_record(&reader);
+    }
+
+    hc_release(reader.wanted);
+    hc_release(reader.lengths);
+    return reader.rows;
+}
+
+#endif /* HC_CSV_H */
@@ -0,0 +1,179 @@
+/* runtime/hc_file.h */
+#ifndef HC_FILE_H
+#define HC_FILE_H
+
+// संचिका: read-only file mapped into memory and read line by line and field
+// by field. Lines and fields are views of the mapping, like literals, so
+// iterating a file copies no bytes. A mapping stays in place until the
+// program exits, which keeps every view taken from it valid.
+//
+// Line breaks and delimiters are found 16 bytes at a time: one SSE2 compare
+// and movemask gives a bitmask of the matching bytes in a block.
+
+#include "hc_common.h"
+#include "hc_str.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HC_FILE_MMAP 1
+#endif
+
+typedef struct
+{
+    const char *data; // The file's bytes
+    size_t size;
+    size_t next;        // Offset of the line after the current one
+    const char *line;   // Current line, without its line break
+    size_t lineLength;
+    size_t fieldNext;   // Offset in the line of the next field; past the end when done
+    const char *field;  // Current field
+    size_t fieldLength;
+} hc_file;
+
+// First byte equal to c in [p, end), or end
+static inline const char *hc_file_find(const char *p, const char *end, char c)
+{
+#if defined(__SSE2__)
+    __m128i needle = _mm_set1_epi8(c);
+    for (; end - p >= 16; p += 16)
+    {
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), needle));
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+    }
+#endif
+    for (; p < end; p++)
+    {
+        if (*p == c)
+            return p;
+    }
+    return end;
+}
+
+// Map the file at path; the program stops if it cannot be read
+static inline hc_file hc_file_open(hc_str path)
+{
+    hc_file file;
+    memset(&file, 0, sizeof(file));
+
+    char name[4096];
+    if (HC_RUNTIME_UNLIKELY(path.length >= sizeof(name)))
+        hc_fatal("file name too long");
+    memcpy(name, hc_str_bytes(&path), path.length);
+    name[path.length] = '\0';
+
+#if defined(HC_FILE_MMAP)
+    int fd = open(name, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0)
+    {
+        fprintf(stderr, "hindic runtime: cannot open '%s'\n", name);
+        exit(1);
+    }
+    file.size = (size_t)info.st_size;
+    if (file.size > 0)
+    {
+        void *mapping = mmap(NULL, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            fprintf(stderr, "hindic runtime: cannot map '%s'\n", name);
+            exit(1);
+        }
+#if defined(MADV_SEQUENTIAL)
+        madvise(mapping, file.size, MADV_SEQUENTIAL);
+#endif
+        file.data = (const char *)mapping;
+    }
+    close(fd);
+#else
+    // Without mmap the file is read into memory once
+    FILE *stream = fopen(name, "rb");
+    if (stream == NULL)
+    {
+        fprintf(stderr, "hindic runtime: cannot open '%s'\n", name);
+        exit(1);
+    }
+    size_t capacity = 1 << 16;
+    char *data = (char *)hc_alloc(capacity);
+    size_t count;
+    while ((count = fread(data + file.size, 1, capacity - file.size, stream)) > 0)
+    {
+        file.size += count;
+        if (file.size == capacity)
+            data = (char *)hc_resize(data, capacity *= 2);
+    }
+    fclose(stream);
+    file.data = data;
+#endif
+
+    return file;
+}
+
+// Move to the next line; 0 once the file is exhausted. A final line without
+// a line break still counts, and \r\n endings lose their \r.
+static inline int hc_file_next_line(hc_file *file)
+{
+    if (file->next >= file->size)
+    {
+        file->lineLength = 0;
+        file->fieldNext = 1;
+        return 0;
+    }
+
+    const char *start = file->data + file->next;
+    const char *end = file->data + file->size;
+    const char *newline = hc_file_find(start, end, '\n');
+
+    file->next = (size_t)(newline - file->data) + 1;
+    if (newline > start && newline[-1] == '\r')
+        newline--;
+    file->line = start;
+    file->lineLength = (size_t)(newline - start);
+    file->fieldNext = 0;
+    return 1;
+}
+
+// View of bytes in the mapping
+static inline hc_str hc_file_view(const char *data, size_t length)
+{
+    if (HC_RUNTIME_UNLIKELY(length > UINT32_MAX))
+        hc_fatal("line too long");
+    return HC_STR_VIEW(data, (uint32_t)length);
+}
+
+static inline hc_str hc_file_line(hc_file *file)
+{
+    return hc_file_view(file->line, file->lineLength);
+}
+
+// Move to the next field of the current line; 0 once the line is exhausted.
+// Every line has at least one field, possibly empty.
+static inline int hc_file_next_field(hc_file *file, char delimiter)
+{
+    if (file->fieldNext > file->lineLength)
+        return 0;
+
+    const char *start = file->line + file->fieldNext;
+    const char *end = file->line + file->lineLength;
+    const char *found = hc_file_find(start, end, delimiter);
+
+    file->field = start;
+    file->fieldLength = (size_t)(found - start);
+    file->fieldNext = (size_t)(found - file->line) + 1;
+    return 1;
+}
+
+static inline hc_str hc_file_field(hc_file *file)
+{
+    return hc_file_view(file->field, file->fieldLength);
+}
+
+#endif /* HC_FILE_H */
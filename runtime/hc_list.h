@@ -0,0 +1,125 @@
+/* runtime/hc_list.h */
+#ifndef HC_LIST_H
+#define HC_LIST_H
+
+// सूची: growable array. Capacity doubles on overflow, so pushes are amortized
+// O(1). A list may take its storage from an arena instead of the heap; such
+// storage is reclaimed with the arena, never by the list.
+
+#include "hc_common.h"
+#include "hc_arena.h"
+#include "hc_str.h"
+
+#define HC_LIST_MIN_CAPACITY 8
+
+// Stamp out a list type NAME of T. The list keeps its own references to its
+// elements: COPY takes one and DROP releases it.
+#define HC_DEFINE_LIST(NAME, T, COPY, DROP)                                                      \
+    typedef struct                                                                               \
+    {                                                                                            \
+        T *data;                                                                                 \
+        size_t length;                                                                           \
+        size_t capacity;                                                                         \
+        hc_arena *arena; /* NULL for heap storage */                                             \
+    } NAME;                                                                                      \
+                                                                                                 \
+    static inline void NAME##_free(NAME *list)                                                   \
+    {                                                                                            \
+        for (size_t i = 0; i < list->length; i++)                                                \
+            DROP(&list->data[i]);                                                                \
+        if (list->arena == NULL)                                                                 \
+            hc_release(list->data);                                                              \
+        memset(list, 0, sizeof(*list));                                                          \
+    }                                                                                            \
+                                                                                                 \
+    /* Allocate from arena from now on; only valid while the list is empty */                    \
+    static inline void NAME##_use_arena(NAME *list, hc_arena *arena)                             \
+    {                                                                                            \
+        NAME##_free(list);                                                                       \
+        list->arena = arena;                                                                     \
+    }                                                                                            \
+                                                                                                 \
+    static inline void NAME##_reserve(NAME *list, size_t capacity)                               \
+    {                                                                                            \
+        if (capacity <= list->capacity)                                                          \
+            return;                                                                              \
+        if (list->arena != NULL)                                                                 \
+            list->data = (T *)hc_arena_grow(list->arena, list->data,                             \
+                                            sizeof(T) * list->length, sizeof(T) * capacity);     \
+        else                                                                                     \
+            list->data = (T *)hc_resize(list->data, sizeof(T) * capacity);                       \
+        list->capacity = capacity;                                                               \
+    }                                                                                            \
+                                                                                                 \
+    static void NAME##_grow(NAME *list)                                                          \
+    {                                                                                            \
+        size_t capacity = list->capacity * 2;                                                    \
+        NAME##_reserve(list, capacity < HC_LIST_MIN_CAPACITY ? HC_LIST_MIN_CAPACITY : capacity); \
+    }                                                                                            \
+                                                                                                 \
+    static inline void NAME##_push(NAME *list, T value)                                          \
+    {                                                                                            \
+        if (HC_RUNTIME_UNLIKELY(list->length == list->capacity))                                 \
+            NAME##_grow(list);                                                                   \
+        list->data[list->length++] = COPY(value);                                                \
+    }                                                                                            \
+                                                                                                 \
+    /* The caller owns the popped element */                                                     \
+    static inline T NAME##_pop(NAME *list)                                                       \
+    {                                                                                            \
+        if (HC_RUNTIME_UNLIKELY(list->length == 0))                                              \
+            hc_fatal("pop from an empty list");                                                  \
+        return list->data[--list->length];                                                       \
+    }                                                                                            \
+                                                                                                 \
+    /* Bounds-checked element address; one unsigned compare covers both ends */                  \
+    static inline T *NAME##_at(NAME *list, int index)                                            \
+    {                                                                                            \
+        if (HC_RUNTIME_UNLIKELY((size_t)(unsigned)index >= list->length))                        \
+            hc_fatal("list index out of range");                                                 \
+        return &list->data[index];                                                               \
+    }                                                                                            \
+                                                                                                 \
+    static inline int NAME##_length(const NAME *list)                                            \
+    {                                                                                            \
+        return (int)list->length;                                                                \
+    }                                                                                            \
+                                                                                                 \
+    /* to = from: to's old storage is released, from is left empty */                            \
+    static inline void NAME##_move(NAME *to, NAME *from)                                         \
+    {                                                                                            \
+        if (to == from)                                                                          \
+            return;                                                                              \
+        NAME##_free(to);                                                                         \
+        *to = *from;                                                                             \
+        memset(from, 0, sizeof(*from));                                                          \
+    }                                                                                            \
+                                                                                                 \
+    static inline NAME NAME##_take(NAME *from)                                                   \
+    {                                                                                            \
+        NAME list = *from;                                                                       \
+        memset(from, 0, sizeof(*from));                                                          \
+        return list;                                                                             \
+    }
+
+HC_DEFINE_LIST(hc_list_int, int, HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_LIST(hc_list_float, float, HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_LIST(hc_list_char, char, HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_LIST(hc_list_str, hc_str, hc_str_copy, hc_str_release)
+
+// Type-generic entry points used by generated code
+#define HC_LIST_DISPATCH(list, op)           \
+    _Generic((list),                         \
+        hc_list_int *: hc_list_int_##op,     \
+        hc_list_float *: hc_list_float_##op, \
+        hc_list_char *: hc_list_char_##op,   \
+        hc_list_str *: hc_list_str_##op)
+
+#define hc_list_push(list, value) HC_LIST_DISPATCH(list, push)(list, value)
+#define hc_list_pop(list) HC_LIST_DISPATCH(list, pop)(list)
+#define hc_list_at(list, index) HC_LIST_DISPATCH(list, at)(list, index)
+#define hc_list_length(list) HC_LIST_DISPATCH(list, length)(list)
+#define hc_list_move(to, from) HC_LIST_DISPATCH(to, move)(to, from)
+#define hc_list_take(from) HC_LIST_DISPATCH(from, take)(from)
+
+#endif /* HC_LIST_H */
@@ -0,0 +1,304 @@
+/* runtime/hc_map.h */
+#ifndef HC_MAP_H
+#define HC_MAP_H
+
+// शब्दकोश: open-addressing hash map in the style of a Swiss table.
+//
+// Every slot has a control byte: EMPTY, DELETED, or the low 7 bits of the
+// key's hash (H2) when full. Slots are probed 16 at a time: one SSE2 compare
+// finds every slot in a group whose control byte matches H2, so most lookups
+// touch one group of control bytes and compare a single key.
+//
+// A map may take its storage from an arena instead of the heap; such storage
+// is reclaimed with the arena, never by the map.
+
+#include "hc_common.h"
+#include "hc_arena.h"
+#include "hc_str.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define HC_MAP_GROUP_WIDTH 16
+#define HC_CTRL_EMPTY ((int8_t)-128)
+#define HC_CTRL_DELETED ((int8_t)-2)
+
+// Bitmask of the slots in a group whose control byte equals value
+static inline unsigned hc_group_match(const int8_t *ctrl, int8_t value)
+{
+#if defined(__SSE2__)
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HC_MAP_GROUP_WIDTH; i++)
+    {
+        if (ctrl[i] == value)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// Bitmask of the slots in a group that are EMPTY or DELETED (sign bit set)
+static inline unsigned hc_group_match_free(const int8_t *ctrl)
+{
+#if defined(__SSE2__)
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HC_MAP_GROUP_WIDTH; i++)
+    {
+        if (ctrl[i] < 0)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+static inline int hc_lowest_bit(unsigned mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while ((mask & 1u) == 0)
+    {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static inline uint64_t hc_hash_int(int key)
+{
+    uint64_t x = (uint64_t)(uint32_t)key * 0x9E3779B97F4A7C15ull;
+    return x ^ (x >> 29);
+}
+
+static inline int hc_equal_int(int a, int b)
+{
+    return a == b;
+}
+
+// Stamp out a map type NAME from KEY to VALUE. The map keeps its own
+// references to keys and values: COPY takes one and DROP releases it.
+#define HC_DEFINE_MAP(NAME, KEY, VALUE, HASH, EQUAL, KEY_COPY, KEY_DROP, VALUE_COPY, VALUE_DROP) \
+    typedef struct                                                                               \
+    {                                                                                            \
+        int8_t *ctrl;                                                                            \
+        KEY *keys;                                                                               \
+        VALUE *values;                                                                           \
+        size_t capacity; /* Multiple of the group width, power of two */                         \
+        size_t size;                                                                             \
+        size_t tombstones;                                                                       \
+        hc_arena *arena; /* NULL for heap storage */                                             \
+    } NAME;                                                                                      \
+                                                                                                 \
+    static inline void *NAME##_alloc(NAME *map, size_t size)                                     \
+    {                                                                                            \
+        return map->arena != NULL ? hc_arena_alloc(map->arena, size) : hc_alloc(size);           \
+    }                                                                                            \
+                                                                                                 \
+    static inline void NAME##_free(NAME *map)                                                    \
+    {                                                                                            \
+        for (size_t i = 0; i < map->capacity; i++)                                               \
+        {                                                                                        \
+            if (map->ctrl[i] >= 0)                                                               \
+            {                                                                                    \
+                KEY_DROP(&map->keys[i]);                                                         \
+                VALUE_DROP(&map->values[i]);                                                     \
+            }                                                                                    \
+        }                                                                                        \
+        if (map->arena == NULL)                                                                  \
+        {                                                                                        \
+            hc_release(map->ctrl);                                                               \
+            hc_release(map->keys);                                                               \
+            hc_release(map->values);                                                             \
+        }                                                                                        \
+        memset(map, 0, sizeof(*map));                                                            \
+    }                                                                                            \
+                                                                                                 \
+    /* Index of the key's slot, or -1 */                                                         \
+    static inline ptrdiff_t NAME##_find(const NAME *map, KEY key, uint64_t hash)                 \
+    {                                                                                            \
+        if (map->capacity == 0)                                                                  \
+            return -1;                                                                           \
+        size_t groupMask = map->capacity / HC_MAP_GROUP_WIDTH - 1;                               \
+        size_t group = (size_t)(hash >> 7) & groupMask;                                          \
+        int8_t h2 = (int8_t)(hash & 0x7F);                                                       \
+        for (size_t step = 1;; step++)                                                           \
+        {                                                                                        \
+            const int8_t *ctrl = map->ctrl + group * HC_MAP_GROUP_WIDTH;                         \
+            for (unsigned match = hc_group_match(ctrl, h2); match != 0; match &= match - 1)      \
+            {                                                                                    \
+                size_t slot = group * HC_MAP_GROUP_WIDTH + hc_lowest_bit(match);                 \
+                if (EQUAL(map->keys[slot], key))                                                 \
+                    return (ptrdiff_t)slot;                                                      \
+            }                                                                                    \
+            if (hc_group_match(ctrl, HC_CTRL_EMPTY) != 0)                                        \
+                return -1;                                                                       \
+            group = (group + step) & groupMask; /* Triangular probing */                         \
+        }                                                                                        \
+    }                                                                                            \
+                                                                                                 \
+    /* First EMPTY or DELETED slot on the key's probe sequence */                                \
+    static inline size_t NAME##_free_slot(const NAME *map, uint64_t hash)                        \
+    {                                                                                            \
+        size_t groupMask = map->capacity / HC_MAP_GROUP_WIDTH - 1;                               \
+        size_t group = (size_t)(hash >> 7) & groupMask;                                          \
+        for (size_t step = 1;; step++)                                                           \
+        {                                                                                        \
+            unsigned match = hc_group_match_free(map->ctrl + group * HC_MAP_GROUP_WIDTH);        \
+            if (match != 0)                                                                      \
+                return group * HC_MAP_GROUP_WIDTH + hc_lowest_bit(match);                        \
+            group = (group + step) & groupMask;                                                  \
+        }                                                                                        \
+    }                                                                                            \
+                                                                                                 \
+    static void NAME##_resize(NAME *map, size_t capacity)                                        \
+    {                                                                                            \
+        NAME old = *map;                                                                         \
+        map->ctrl = (int8_t *)NAME##_alloc(map, capacity);                                       \
+        map->keys = (KEY *)NAME##_alloc(map, sizeof(KEY) * capacity);                            \
+        map->values = (VALUE *)NAME##_alloc(map, sizeof(VALUE) * capacity);                      \
+        map->capacity = capacity;                                                                \
+        map->tombstones = 0;                                                                     \
+        memset(map->ctrl, HC_CTRL_EMPTY, capacity);                                              \
+        for (size_t i = 0; i < old.capacity; i++)                                                \
+        {                                                                                        \
+            if (old.ctrl[i] < 0)                                                                 \
+                continue;                                                                        \
+            uint64_t hash = HASH(old.keys[i]);                                                   \
+            size_t slot = NAME##_free_slot(map, hash);                                           \
+            map->ctrl[slot] = (int8_t)(hash & 0x7F);                                             \
+            map->keys[slot] = old.keys[i];                                                       \
+            map->values[slot] = old.values[i];                                                   \
+        }                                                                                        \
+        if (map->arena == NULL)                                                                  \
+        {                                                                                        \
+            hc_release(old.ctrl);                                                                \
+            hc_release(old.keys);                                                                \
+            hc_release(old.values);                                                              \
+        }                                                                                        \
+    }                                                                                            \
+                                                                                                 \
+    static inline void NAME##_put(NAME *map, KEY key, VALUE value)                               \
+    {                                                                                            \
+        uint64_t hash = HASH(key);                                                               \
+        ptrdiff_t found = NAME##_find(map, key, hash);                                           \
+        if (found >= 0)                                                                          \
+        {                                                                                        \
+            VALUE_DROP(&map->values[found]);                                                     \
+            map->values[found] = VALUE_COPY(value);                                              \
+            return;                                                                              \
+        }                                                                                        \
+        /* Keep the load (tombstones included) at or below 7/8 */                                \
+        if ((map->size + map->tombstones + 1) * 8 > map->capacity * 7)                           \
+        {                                                                                        \
+            size_t capacity = map->capacity == 0 ? HC_MAP_GROUP_WIDTH : map->capacity;           \
+            while ((map->size + 1) * 8 > capacity * 7 / 2)                                       \
+                capacity *= 2;                                                                   \
+            NAME##_resize(map, capacity);                                                        \
+        }                                                                                        \
+        size_t slot = NAME##_free_slot(map, hash);                                               \
+        if (map->ctrl[slot] == HC_CTRL_DELETED)                                                  \
+            map->tombstones--;                                                                   \
+        map->ctrl[slot] = (int8_t)(hash & 0x7F);                                                 \
+        map->keys[slot] = KEY_COPY(key);                                                         \
+        map->values[slot] = VALUE_COPY(value);                                                   \
+        map->size++;                                                                             \
+    }                                                                                            \
+                                                                                                 \
+    /* Missing keys read as zero; the value is borrowed from the map */                          \
+    static inline VALUE NAME##_get(const NAME *map, KEY key)                                     \
+    {                                                                                            \
+        ptrdiff_t found = NAME##_find(map, key, HASH(key));                                      \
+        if (found < 0)                                                                           \
+        {                                                                                        \
+            VALUE zero;                                                                          \
+            memset(&zero, 0, sizeof(zero));                                                      \
+            return zero;                                                                         \
+        }                                                                                        \
+        return map->values[found];                                                               \
+    }                                                                                            \
+                                                                                                 \
+    static inline int NAME##_contains(const NAME *map, KEY key)                                  \
+    {                                                                                            \
+        return NAME##_find(map, key, HASH(key)) >= 0;                                            \
+    }                                                                                            \
+                                                                                                 \
+    static inline int NAME##_remove(NAME *map, KEY key)                                          \
+    {                                                                                            \
+        ptrdiff_t found = NAME##_find(map, key, HASH(key));                                      \
+        if (found < 0)                                                                           \
+            return 0;                                                                            \
+        KEY_DROP(&map->keys[found]);                                                             \
+        VALUE_DROP(&map->values[found]);                                                         \
+        /* A group that still has an EMPTY slot never stopped a probe, so the                    \
+           slot can go straight back to EMPTY instead of becoming a tombstone */                 \
+        const int8_t *ctrl = map->ctrl + (found / HC_MAP_GROUP_WIDTH) * HC_MAP_GROUP_WIDTH;      \
+        if (hc_group_match(ctrl, HC_CTRL_EMPTY) != 0)                                            \
+        {                                                                                        \
+            map->ctrl[found] = HC_CTRL_EMPTY;                                                    \
+        }                                                                                        \
+        else                                                                                     \
+        {                                                                                        \
+            map->ctrl[found] = HC_CTRL_DELETED;                                                  \
+            map->tombstones++;                                                                   \
+        }                                                                                        \
+        map->size--;                                                                             \
+        return 1;                                                                                \
+    }                                                                                            \
+                                                                                                 \
+    static inline int NAME##_size(const NAME *map)                                               \
+    {                                                                                            \
+        return (int)map->size;                                                                   \
+    }
+
+HC_DEFINE_MAP(hc_map_int_int, int, int,
+              hc_hash_int, hc_equal_int, HC_SCALAR_COPY, HC_SCALAR_DROP,
+              HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_MAP(hc_map_int_float, int, float,
+              hc_hash_int, hc_equal_int, HC_SCALAR_COPY, HC_SCALAR_DROP,
+              HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_MAP(hc_map_int_char, int, char,
+              hc_hash_int, hc_equal_int, HC_SCALAR_COPY, HC_SCALAR_DROP,
+              HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_MAP(hc_map_int_str, int, hc_str,
+              hc_hash_int, hc_equal_int, HC_SCALAR_COPY, HC_SCALAR_DROP,
+              hc_str_copy, hc_str_release)
+HC_DEFINE_MAP(hc_map_str_int, hc_str, int,
+              hc_str_hash, hc_str_equal, hc_str_copy, hc_str_release,
+              HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_MAP(hc_map_str_float, hc_str, float,
+              hc_str_hash, hc_str_equal, hc_str_copy, hc_str_release,
+              HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_MAP(hc_map_str_char, hc_str, char,
+              hc_str_hash, hc_str_equal, hc_str_copy, hc_str_release,
+              HC_SCALAR_COPY, HC_SCALAR_DROP)
+HC_DEFINE_MAP(hc_map_str_str, hc_str, hc_str,
+              hc_str_hash, hc_str_equal, hc_str_copy, hc_str_release,
+              hc_str_copy, hc_str_release)
+
+// Type-generic entry points used by generated code
+#define HC_MAP_DISPATCH(map, op)                   \
+    _Generic((map),                                \
+        hc_map_int_int *: hc_map_int_int_##op,     \
+        hc_map_int_float *: hc_map_int_float_##op, \
+        hc_map_int_char *: hc_map_int_char_##op,   \
+        hc_map_int_str *: hc_map_int_str_##op,     \
+        hc_map_str_int *: hc_map_str_int_##op,     \
+        hc_map_str_float *: hc_map_str_float_##op, \
+        hc_map_str_char *: hc_map_str_char_##op,   \
+        hc_map_str_str *: hc_map_str_str_##op)
+
+#define hc_map_put(map, key, value) HC_MAP_DISPATCH(map, put)(map, key, value)
+#define hc_map_get(map, key) HC_MAP_DISPATCH(map, get)(map, key)
+#define hc_map_contains(map, key) HC_MAP_DISPATCH(map, contains)(map, key)
+#define hc_map_remove(map, key) HC_MAP_DISPATCH(map, remove)(map, key)
+#define hc_map_size(map) HC_MAP_DISPATCH(map, size)(map)
+
+#endif /* HC_MAP_H */
@@ -0,0 +1,244 @@
+/* runtime/hc_random.h */
+#ifndef HC_RANDOM_H
+#define HC_RANDOM_H
+
+// यादृच्छिक: random numbers from xoshiro256** (Blackman and Vigna). Every
+// thread has its own generator, so tasks draw numbers without the lock and
+// shared state behind rand(). A thread's generator is seeded on its first
+// draw: the program seed is spread over the state with splitmix64, and the
+// n-th thread to draw jumps n times by 2^128 steps, so threads get streams
+// that never overlap and a program run on one thread draws the same numbers
+// every time.
+//
+// Bounded integers use Lemire's multiply-shift: the high half of a
+// 32x32-bit product maps a random word onto [0, bound). The few words that
+// would make some results likelier than others are rejected, and the
+// division that finds them only runs when a word lands near the edge.
+//
+// The program seed and the count of seeded threads are shared by all
+// translation units; exactly one defines HC_RANDOM_IMPLEMENTATION before
+// including this header.
+
+#include "hc_common.h"
+#include "hc_list.h"
+#include <float.h>
+#include <stdatomic.h>
+
+// Seed of programs that never call यादृच्छिक_बीज
+#define HC_RANDOM_DEFAULT_SEED 0x853C49E6748FEA9Bu
+
+typedef struct
+{
+    uint64_t s[4];
+    int seeded;
+} hc_random_state;
+
+extern _Thread_local hc_random_state hc_random_local;
+extern atomic_uint_fast64_t hc_random_seed;    // Program seed
+extern atomic_uint_fast64_t hc_random_streams; // Threads seeded so far
+#ifdef HC_RANDOM_IMPLEMENTATION
+_Thread_local hc_random_state hc_random_local;
+atomic_uint_fast64_t hc_random_seed = HC_RANDOM_DEFAULT_SEED;
+atomic_uint_fast64_t hc_random_streams;
+#endif
+
+static inline uint64_t hc_random_rotate(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// Next 64 random bits
+static inline uint64_t hc_random_next(uint64_t *s)
+{
+    uint64_t result = hc_random_rotate(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = hc_random_rotate(s[3], 45);
+    return result;
+}
+
+static inline uint64_t hc_random_splitmix(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15u);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
+}
+
+// Advance s by 2^128 steps, to the start of the next thread's stream
+static void hc_random_jump(uint64_t *s)
+{
+    static const uint64_t jump[4] = {0x180EC6D33CFD0ABAu, 0xD5A61266F0C9392Cu, 0xA9582618E03FC9AAu,
+                                     0x39ABDC4529B1661Cu};
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++)
+    {
+        for (int bit = 0; bit < 64; bit++)
+        {
+            if (jump[i] & (UINT64_C(1) << bit))
+            {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+            hc_random_next(s);
+        }
+    }
+    memcpy(s, t, sizeof(t));
+}
+
+// Put state at the start of stream number stream of seed
+static void hc_random_start(hc_random_state *state, uint64_t seed, uint64_t stream)
+{
+    for (int i = 0; i < 4; i++)
+        state->s[i] = hc_random_splitmix(&seed);
+    for (uint64_t i = 0; i < stream; i++)
+        hc_random_jump(state->s);
+    state->seeded = 1;
+}
+
+// The calling thread's generator, seeded on first use
+static inline uint64_t *hc_random_thread(void)
+{
+    hc_random_state *state = &hc_random_local;
+    if (HC_RUNTIME_UNLIKELY(!state->seeded))
+    {
+        uint64_t stream = atomic_fetch_add(&hc_random_streams, 1);
+        hc_random_start(state, atomic_load(&hc_random_seed), stream);
+    }
+    return state->s;
+}
+
+// यादृच्छिक_बीज(seed): restart the calling thread's stream from seed; threads
+// that draw for the first time afterwards take the streams that follow it
+static inline void hc_random_reseed(int seed)
+{
+    uint64_t value = (uint64_t)(uint32_t)seed;
+    atomic_store(&hc_random_seed, value);
+    atomic_store(&hc_random_streams, 1);
+    hc_random_start(&hc_random_local, value, 0);
+}
+
+// Map word onto [0, bound), drawing more words while it falls in the
+// biased zone
+static inline int hc_random_lemire(uint64_t *s, uint32_t word, uint32_t bound)
+{
+    uint64_t product = (uint64_t)word * bound;
+    uint32_t low = (uint32_t)product;
+    if (HC_RUNTIME_UNLIKELY(low < bound))
+    {
+        uint32_t threshold = -bound % bound;
+        while (low < threshold)
+        {
+            product = (uint64_t)(uint32_t)(hc_random_next(s) >> 32) * bound;
+            low = (uint32_t)product;
+        }
+    }
+    return (int)(product >> 32);
+}
+
+// 24 random bits as a float in [0, 1)
+static inline float hc_random_unit(uint32_t bits)
+{
+    return (float)(bits & 0xFFFFFF) * 0x1.0p-24f;
+}
+
+// A float in [0, bound). Rounding can carry the product up to bound itself,
+// which is drawn again.
+static inline float hc_random_scale(uint64_t *s, uint32_t bits, float bound)
+{
+    float value = hc_random_unit(bits) * bound;
+    while (HC_RUNTIME_UNLIKELY(value >= bound))
+        value = hc_random_unit((uint32_t)(hc_random_next(s) >> 40)) * bound;
+    return value;
+}
+
+static inline void hc_random_check_int(int bound)
+{
+    if (HC_RUNTIME_UNLIKELY(bound <= 0))
+        hc_fatal("random bound must be positive");
+}
+
+static inline void hc_random_check_float(float bound)
+{
+    if (HC_RUNTIME_UNLIKELY(!(bound > 0 && bound <= FLT_MAX)))
+        hc_fatal("random bound must be positive");
+}
+
+static inline int hc_random_int(int bound)
+{
+    hc_random_check_int(bound);
+    uint64_t *s = hc_random_thread();
+    return hc_random_lemire(s, (uint32_t)(hc_random_next(s) >> 32), (uint32_t)bound);
+}
+
+static inline float hc_random_float(float bound)
+{
+    hc_random_check_float(bound);
+    uint64_t *s = hc_random_thread();
+    return hc_random_scale(s, (uint32_t)(hc_random_next(s) >> 40), bound);
+}
+
+// यादृच्छिक_भरो(list, count, bound): append count random numbers. The state
+// stays in locals for the whole loop, and each 64-bit draw gives two numbers.
+static inline void hc_random_fill_int(hc_list_int *list, int count, int bound)
+{
+    if (HC_RUNTIME_UNLIKELY(count < 0))
+        hc_fatal("random fill count must not be negative");
+    hc_random_check_int(bound);
+    hc_list_int_reserve(list, list->length + (size_t)count);
+
+    uint64_t *state = hc_random_thread();
+    uint64_t s[4] = {state[0], state[1], state[2], state[3]};
+    int *out = list->data + list->length;
+    int i = 0;
+    for (; i + 1 < count; i += 2)
+    {
+        uint64_t word = hc_random_next(s);
+        out[i] = hc_random_lemire(s, (uint32_t)(word >> 32), (uint32_t)bound);
+        out[i + 1] = hc_random_lemire(s, (uint32_t)word, (uint32_t)bound);
+    }
+    if (i < count)
+        out[i] = hc_random_lemire(s, (uint32_t)(hc_random_next(s) >> 32), (uint32_t)bound);
+
+    list->length += (size_t)count;
+    memcpy(state, s, sizeof(s));
+}
+
+static inline void hc_random_fill_float(hc_list_float *list, int count, float bound)
+{
+    if (HC_RUNTIME_UNLIKELY(count < 0))
+        hc_fatal("random fill count must not be negative");
+    hc_random_check_float(bound);
+    hc_list_float_reserve(list, list->length + (size_t)count);
+
+    uint64_t *state = hc_random_thread();
+    uint64_t s[4] = {state[0], state[1], state[2], state[3]};
+    float *out = list->data + list->length;
+    int i = 0;
+    for (; i + 1 < count; i += 2)
+    {
+        uint64_t word = hc_random_next(s);
+        out[i] = hc_random_scale(s, (uint32_t)(word >> 40), bound);
+        out[i + 1] = hc_random_scale(s, (uint32_t)word >> 8, bound);
+    }
+    if (i < count)
+        out[i] = hc_random_scale(s, (uint32_t)(hc_random_next(s) >> 40), bound);
+
+    list->length += (size_t)count;
+    memcpy(state, s, sizeof(s));
+}
+
+// Type-generic entry points used by generated code
+#define hc_random(bound) \
+    _Generic((bound), float: hc_random_float, double: hc_random_float, default: hc_random_int)(bound)
+#define hc_random_fill(list, count, bound)                                                      \
+    _Generic((list), hc_list_int *: hc_random_fill_int, hc_list_float *: hc_random_fill_float)( \
+        list, count, bound)
+
+#endif /* HC_RANDOM_H */
@@ -0,0 +1,388 @@
+/* runtime/hc_sort.h */
+#ifndef HC_SORT_H
+#define HC_SORT_H
+
+// क्रमबद्ध and खोज: in-place ascending sort and binary search of lists of
+// numbers.
+//
+// Integers are sorted with an LSD radix sort over bytes, skipping the byte
+// positions in which all keys agree; short lists use insertion sort. Floats
+// are sorted with pattern-defeating quicksort (Orson Peters' pdqsort):
+// introsort with ninther pivots, a partial insertion sort that finishes
+// already-sorted runs in linear time, a partition that groups keys equal to
+// the previous pivot, and a heapsort fallback after too many unbalanced
+// partitions. NaNs are moved to the end first, so comparisons stay ordered.
+//
+// The search is branchless: the range halves on a conditional move, so the
+// loop runs log2(n) times with no mispredicted branches.
+
+#include "hc_common.h"
+#include "hc_list.h"
+
+// Lists shorter than this are insertion sorted
+#define HC_SORT_INSERTION 24
+// Ranges longer than this take the median of three medians as pivot
+#define HC_SORT_NINTHER 128
+// Moves a partial insertion sort may make before it gives up
+#define HC_SORT_PARTIAL_LIMIT 8
+// Integer lists at least this long are radix sorted
+#define HC_SORT_RADIX 64
+
+static inline void hc_sort_int_insertion(int *begin, int *end)
+{
+    for (int *i = begin + 1; i < end; i++)
+    {
+        int value = *i;
+        int *j = i;
+        for (; j > begin && value < j[-1]; j--)
+            *j = j[-1];
+        *j = value;
+    }
+}
+
+// Keys with the sign bit flipped order as unsigned numbers
+static inline uint32_t hc_sort_key(int value)
+{
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+static inline void hc_sort_int(int *data, size_t length)
+{
+    if (length < HC_SORT_RADIX)
+    {
+        hc_sort_int_insertion(data, data + length);
+        return;
+    }
+
+    // One pass counts the digits of all four byte positions and notices
+    // lists that are sorted already
+    size_t counts[4][256];
+    memset(counts, 0, sizeof(counts));
+    size_t descents = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        uint32_t key = hc_sort_key(data[i]);
+        counts[0][key & 0xFF]++;
+        counts[1][(key >> 8) & 0xFF]++;
+        counts[2][(key >> 16) & 0xFF]++;
+        counts[3][key >> 24]++;
+        descents += i > 0 && data[i] < data[i - 1];
+    }
+    if (descents == 0)
+        return;
+
+    int *buffer = (int *)hc_alloc(sizeof(int) * length);
+    int *from = data;
+    int *to = buffer;
+    for (int pass = 0; pass < 4; pass++)
+    {
+        int shift = 8 * pass;
+        size_t *count = counts[pass];
+        if (count[(hc_sort_key(from[0]) >> shift) & 0xFF] == length)
+            continue; // Every key has the same byte here
+
+        size_t offsets[256];
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; digit++)
+        {
+            offsets[digit] = offset;
+            offset += count[digit];
+        }
+        for (size_t i = 0; i < length; i++)
+            to[offsets[(hc_sort_key(from[i]) >> shift) & 0xFF]++] = from[i];
+
+        int *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != data)
+        memcpy(data, from, sizeof(int) * length);
+    hc_release(buffer);
+}
+
+static inline void hc_sort_float_swap(float *a, float *b)
+{
+    float swap = *a;
+    *a = *b;
+    *b = swap;
+}
+
+static inline void hc_sort_float_sort2(float *a, float *b)
+{
+    if (*b < *a)
+        hc_sort_float_swap(a, b);
+}
+
+// Leave the median of *a, *b and *c in *b and the largest in *c
+static inline void hc_sort_float_sort3(float *a, float *b, float *c)
+{
+    hc_sort_float_sort2(a, b);
+    hc_sort_float_sort2(b, c);
+    hc_sort_float_sort2(a, b);
+}
+
+static inline void hc_sort_float_insertion(float *begin, float *end)
+{
+    for (float *i = begin + 1; i < end; i++)
+    {
+        float value = *i;
+        float *j = i;
+        for (; j > begin && value < j[-1]; j--)
+            *j = j[-1];
+        *j = value;
+    }
+}
+
+// Insertion sort that gives up once it has moved too many elements; 1 if
+// the range ends up sorted
+static inline int hc_sort_float_partial_insertion(float *begin, float *end)
+{
+    size_t moves = 0;
+    for (float *i = begin + 1; i < end; i++)
+    {
+        if (!(*i < i[-1]))
+            continue;
+
+        float value = *i;
+        float *j = i;
+        for (; j > begin && value < j[-1]; j--)
+            *j = j[-1];
+        *j = value;
+
+        moves += (size_t)(i - j);
+        if (moves > HC_SORT_PARTIAL_LIMIT)
+            return 0;
+    }
+    return 1;
+}
+
+static inline void hc_sort_float_sift(float *heap, size_t root, size_t length)
+{
+    float value = heap[root];
+    for (size_t child; (child = 2 * root + 1) < length; root = child)
+    {
+        child += child + 1 < length && heap[child] < heap[child + 1];
+        if (!(value < heap[child]))
+            break;
+        heap[root] = heap[child];
+    }
+    heap[root] = value;
+}
+
+static inline void hc_sort_float_heap(float *begin, float *end)
+{
+    size_t length = (size_t)(end - begin);
+    for (size_t i = length / 2; i-- > 0;)
+        hc_sort_float_sift(begin, i, length);
+    for (size_t i = length; i-- > 1;)
+    {
+        hc_sort_float_swap(begin, begin + i);
+        hc_sort_float_sift(begin, 0, i);
+    }
+}
+
+// Partition around *begin: smaller keys before it, the rest after. The
+// pivot was picked as a median, so a key not smaller than it sits at the end
+// and the first scan needs no bounds check. *already is set when nothing had
+// to move.
+static inline float *hc_sort_float_partition_right(float *begin, float *end, int *already)
+{
+    float pivot = *begin;
+    float *first = begin;
+    float *last = end;
+
+    while (*++first < pivot)
+        ;
+    if (first - 1 == begin)
+    {
+        while (first < last && !(*--last < pivot))
+            ;
+    }
+    else
+    {
+        while (!(*--last < pivot))
+            ;
+    }
+
+    *already = first >= last;
+    while (first < last)
+    {
+        hc_sort_float_swap(first, last);
+        while (*++first < pivot)
+            ;
+        while (!(*--last < pivot))
+            ;
+    }
+
+    float *position = first - 1;
+    *begin = *position;
+    *position = pivot;
+    return position;
+}
+
+// Partition around *begin when it equals the key before the range: keys
+// equal to the pivot go left, where they are already in place
+static inline float *hc_sort_float_partition_left(float *begin, float *end)
+{
+    float pivot = *begin;
+    float *first = begin;
+    float *last = end;
+
+    while (pivot < *--last)
+        ;
+    if (last + 1 == end)
+    {
+        while (first < last && !(pivot < *++first))
+            ;
+    }
+    else
+    {
+        while (!(pivot < *++first))
+            ;
+    }
+
+    while (first < last)
+    {
+        hc_sort_float_swap(first, last);
+        while (pivot < *--last)
+            ;
+        while (!(pivot < *++first))
+            ;
+    }
+
+    *begin = *last;
+    *last = pivot;
+    return last;
+}
+
+// Sort [begin, end); leftmost is set when no key precedes the range
+static void hc_sort_float_range(float *begin, float *end, int badAllowed, int leftmost)
+{
+    for (;;)
+    {
+        size_t size = (size_t)(end - begin);
+        if (size < HC_SORT_INSERTION)
+        {
+            hc_sort_float_insertion(begin, end);
+            return;
+        }
+
+        size_t half = size / 2;
+        if (size > HC_SORT_NINTHER)
+        {
+            hc_sort_float_sort3(begin, begin + half, end - 1);
+            hc_sort_float_sort3(begin + 1, begin + (half - 1), end - 2);
+            hc_sort_float_sort3(begin + 2, begin + (half + 1), end - 3);
+            hc_sort_float_sort3(begin + (half - 1), begin + half, begin + (half + 1));
+            hc_sort_float_swap(begin, begin + half);
+        }
+        else
+        {
+            hc_sort_float_sort3(begin + half, begin, end - 1);
+        }
+
+        // Many equal keys: skip the run equal to the previous pivot
+        if (!leftmost && !(begin[-1] < *begin))
+        {
+            begin = hc_sort_float_partition_left(begin, end) + 1;
+            continue;
+        }
+
+        int already;
+        float *pivot = hc_sort_float_partition_right(begin, end, &already);
+        size_t left = (size_t)(pivot - begin);
+        size_t right = (size_t)(end - (pivot + 1));
+
+        if (left < size / 8 || right < size / 8)
+        {
+            // Unbalanced: give up on quicksort after too many, otherwise break
+            // up the pattern that caused it
+            if (--badAllowed == 0)
+            {
+                hc_sort_float_heap(begin, end);
+                return;
+            }
+            if (left >= HC_SORT_INSERTION)
+            {
+                hc_sort_float_swap(begin, begin + left / 4);
+                hc_sort_float_swap(pivot - 1, pivot - left / 4);
+                if (left > HC_SORT_NINTHER)
+                {
+                    hc_sort_float_swap(begin + 1, begin + (left / 4 + 1));
+                    hc_sort_float_swap(begin + 2, begin + (left / 4 + 2));
+                    hc_sort_float_swap(pivot - 2, pivot - (left / 4 + 1));
+                    hc_sort_float_swap(pivot - 3, pivot - (left / 4 + 2));
+                }
+            }
+            if (right >= HC_SORT_INSERTION)
+            {
+                hc_sort_float_swap(pivot + 1, pivot + (1 + right / 4));
+                hc_sort_float_swap(end - 1, end - right / 4);
+                if (right > HC_SORT_NINTHER)
+                {
+                    hc_sort_float_swap(pivot + 2, pivot + (2 + right / 4));
+                    hc_sort_float_swap(pivot + 3, pivot + (3 + right / 4));
+                    hc_sort_float_swap(end - 2, end - (1 + right / 4));
+                    hc_sort_float_swap(end - 3, end - (2 + right / 4));
+                }
+            }
+        }
+        else if (already && hc_sort_float_partial_insertion(begin, pivot) &&
+                 hc_sort_float_partial_insertion(pivot + 1, end))
+        {
+            // The range was (nearly) sorted already
+            return;
+        }
+
+        // Recurse into the left part, loop on the right
+        hc_sort_float_range(begin, pivot, badAllowed, leftmost);
+        begin = pivot + 1;
+        leftmost = 0;
+    }
+}
+
+static inline void hc_sort_float(float *data, size_t length)
+{
+    // NaNs compare false with everything; park them after the numbers
+    size_t count = length;
+    for (size_t i = 0; i < count;)
+    {
+        if (data[i] != data[i])
+            hc_sort_float_swap(&data[i], &data[--count]);
+        else
+            i++;
+    }
+
+    int badAllowed = 1;
+    for (size_t n = count; n > 1; n >>= 1)
+        badAllowed++;
+    hc_sort_float_range(data, data + count, badAllowed, 1);
+}
+
+// Index of value in an ascending list, or -1
+#define HC_DEFINE_SEARCH(NAME, T)                                 \
+    static inline int NAME(const T *data, size_t length, T value) \
+    {                                                             \
+        if (length == 0)                                          \
+            return -1;                                            \
+        const T *base = data;                                     \
+        for (size_t n = length; n > 1; n -= n / 2)                \
+            base = base[n / 2] < value ? base + n / 2 : base;     \
+        base += *base < value;                                    \
+        if (base == data + length || *base != value)              \
+            return -1;                                            \
+        return (int)(base - data);                                \
+    }
+
+HC_DEFINE_SEARCH(hc_search_int, int)
+HC_DEFINE_SEARCH(hc_search_float, float)
+
+// Type-generic entry points used by generated code
+#define hc_list_sort(list) \
+    _Generic((list), hc_list_int *: hc_sort_int, hc_list_float *: hc_sort_float)((list)->data, (list)->length)
+#define hc_list_search(list, value)                                                     \
+    _Generic((list), hc_list_int *: hc_search_int, hc_list_float *: hc_search_float)( \
+        (list)->data, (list)->length, value)
+
+#endif /* HC_SORT_H */
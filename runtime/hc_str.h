@@ -0,0 +1,411 @@
+/* runtime/hc_str.h */
+#ifndef HC_STR_H
+#define HC_STR_H
+
+// पाठ: immutable UTF-8 string with value semantics.
+//
+// Strings of up to HC_STR_SMALL_MAX bytes are stored inline. Longer strings
+// point into a shared, reference-counted buffer that carries its length in
+// front of the bytes; copies and slices share that buffer instead of copying
+// bytes. Literals are views of static storage and are never counted.
+//
+// Inside a क्षेत्र block, concatenations put their buffer in the block's
+// arena. Such buffers are not counted either: slices share them, but a copy
+// may outlive the block, so copying one moves the bytes to the heap.
+
+#include "hc_common.h"
+#include "hc_arena.h"
+
+#define HC_STR_SMALL_MAX 23
+
+// Reference count of a buffer that lives in an arena
+#define HC_STR_ARENA_REFS 0
+
+// Programs with tasks define HC_STR_ATOMIC_REFS: tasks may copy and drop the
+// same global string at once, so its count changes atomically
+#if defined(HC_STR_ATOMIC_REFS) && defined(__GNUC__)
+#define HC_STR_REFS(buffer) __atomic_load_n(&(buffer)->refs, __ATOMIC_RELAXED)
+#define HC_STR_RETAIN(buffer) __atomic_fetch_add(&(buffer)->refs, 1, __ATOMIC_RELAXED)
+#define HC_STR_UNRETAIN(buffer) (__atomic_sub_fetch(&(buffer)->refs, 1, __ATOMIC_ACQ_REL) == 0)
+#else
+#define HC_STR_REFS(buffer) ((buffer)->refs)
+#define HC_STR_RETAIN(buffer) ((buffer)->refs++)
+#define HC_STR_UNRETAIN(buffer) (--(buffer)->refs == 0)
+#endif
+
+// Where a string's bytes live
+enum
+{
+    HC_STR_SMALL,  // Inline, NUL-terminated
+    HC_STR_HEAP,   // Inside a shared hc_str_buf
+    HC_STR_STATIC, // Static storage (literals and their slices)
+};
+
+// Length-prefixed heap storage shared by a string, its copies and its slices.
+// creator and serial name the buffer for grapheme cursors: an address comes
+// back once the buffer is freed, the pair never does.
+typedef struct
+{
+    size_t refs;
+    size_t length;
+    const uint64_t *creator; // The creating thread's buffer counter
+    uint64_t serial;
+    char data[]; // NUL-terminated
+} hc_str_buf;
+
+// Buffers this thread has created. Threads live as long as the program, so
+// the counter's address tells threads (and translation units) apart.
+static _Thread_local uint64_t hc_str_serial;
+
+typedef struct
+{
+    union
+    {
+        char small[HC_STR_SMALL_MAX + 1];
+        struct
+        {
+            const char *data; // Not NUL-terminated for slices
+            hc_str_buf *owner; // NULL for static storage
+        } ref;
+    } u;
+    uint32_t length;
+    uint32_t kind;
+} hc_str;
+
+// Views of static bytes: the _INIT forms are static initializers, the others
+// expressions. The compiler refers to its literal table with HC_STR_VIEW.
+#define HC_STR_VIEW_INIT(bytes, size) {.u.ref = {bytes, NULL}, .length = (size), .kind = HC_STR_STATIC}
+#define HC_STR_VIEW(bytes, size) ((hc_str)HC_STR_VIEW_INIT(bytes, size))
+#define HC_STR_INIT(literal) HC_STR_VIEW_INIT(literal, sizeof(literal) - 1)
+#define HC_STR_LIT(literal) ((hc_str)HC_STR_INIT(literal))
+
+static inline const char *hc_str_bytes(const hc_str *s)
+{
+    return s->kind == HC_STR_SMALL ? s->u.small : s->u.ref.data;
+}
+
+static inline int hc_str_length(hc_str s)
+{
+    return (int)s.length;
+}
+
+// Whether the bytes live in a shared buffer that is counted (not in an arena)
+static inline int hc_str_counted(const hc_str *s)
+{
+    return s->kind == HC_STR_HEAP && HC_STR_REFS(s->u.ref.owner) != HC_STR_ARENA_REFS;
+}
+
+// Make *s an uninitialized string of the given length and return its bytes.
+// Long strings get a buffer from arena, or from the heap if arena is NULL.
+static inline char *hc_str_reserve_in(hc_str *s, size_t length, hc_arena *arena)
+{
+    if (HC_RUNTIME_UNLIKELY(length > UINT32_MAX))
+        hc_fatal("string too long");
+
+    s->length = (uint32_t)length;
+    if (length <= HC_STR_SMALL_MAX)
+    {
+        s->kind = HC_STR_SMALL;
+        s->u.small[length] = '\0';
+        return s->u.small;
+    }
+
+    size_t size = sizeof(hc_str_buf) + length + 1;
+    hc_str_buf *buffer = (hc_str_buf *)(arena != NULL ? hc_arena_alloc(arena, size) : hc_alloc(size));
+    buffer->refs = arena != NULL ? HC_STR_ARENA_REFS : 1;
+    buffer->length = length;
+    buffer->creator = &hc_str_serial;
+    buffer->serial = ++hc_str_serial;
+    buffer->data[length] = '\0';
+    s->kind = HC_STR_HEAP;
+    s->u.ref.data = buffer->data;
+    s->u.ref.owner = buffer;
+    return buffer->data;
+}
+
+static inline char *hc_str_reserve(hc_str *s, size_t length)
+{
+    return hc_str_reserve_in(s, length, NULL);
+}
+
+static inline hc_str hc_str_from_bytes(const char *data, size_t length)
+{
+    hc_str s;
+    memcpy(hc_str_reserve(&s, length), data, length);
+    return s;
+}
+
+// A new reference to the same string
+static inline hc_str hc_str_copy(hc_str s)
+{
+    if (hc_str_counted(&s))
+        HC_STR_RETAIN(s.u.ref.owner);
+    else if (HC_RUNTIME_UNLIKELY(s.kind == HC_STR_HEAP))
+        return hc_str_from_bytes(s.u.ref.data, s.length);
+    return s;
+}
+
+static inline void hc_str_release(hc_str *s)
+{
+    if (hc_str_counted(s) && HC_STR_UNRETAIN(s->u.ref.owner))
+        hc_release(s->u.ref.owner);
+    memset(s, 0, sizeof(*s));
+}
+
+static inline void hc_str_drop(hc_str s)
+{
+    hc_str_release(&s);
+}
+
+// Store a string the caller owns, releasing the old value
+static inline void hc_str_assign(hc_str *to, hc_str owned)
+{
+    hc_str_release(to);
+    *to = owned;
+}
+
+// Concatenate count strings with a single allocation, from arena if it is
+// not NULL
+static inline hc_str hc_str_concat_in(hc_arena *arena, const hc_str *parts, int count)
+{
+    size_t length = 0;
+    for (int i = 0; i < count; i++)
+        length += parts[i].length;
+
+    hc_str s;
+    char *bytes = hc_str_reserve_in(&s, length, arena);
+    for (int i = 0; i < count; i++)
+    {
+        memcpy(bytes, hc_str_bytes(&parts[i]), parts[i].length);
+        bytes += parts[i].length;
+    }
+    return s;
+}
+
+static inline hc_str hc_str_concat(const hc_str *parts, int count)
+{
+    return hc_str_concat_in(NULL, parts, count);
+}
+
+// Bytes [start, start + length) of s. Long slices share s's storage, short
+// ones are copied inline so they do not keep a large buffer alive.
+static inline hc_str hc_str_slice(hc_str s, int start, int length)
+{
+    if (HC_RUNTIME_UNLIKELY(start < 0 || length < 0 || (uint32_t)start + (uint32_t)length > s.length))
+        hc_fatal("string slice out of range");
+
+    const char *data = hc_str_bytes(&s) + start;
+    if (s.kind == HC_STR_SMALL || (s.kind == HC_STR_HEAP && length <= HC_STR_SMALL_MAX))
+        return hc_str_from_bytes(data, (size_t)length);
+
+    // Slices of arena strings are views of the arena, like the string itself
+    hc_str slice = hc_str_counted(&s) ? hc_str_copy(s) : s;
+    slice.u.ref.data = data;
+    slice.length = (uint32_t)length;
+    return slice;
+}
+
+static inline int hc_str_equal(hc_str a, hc_str b)
+{
+    return a.length == b.length && memcmp(hc_str_bytes(&a), hc_str_bytes(&b), a.length) == 0;
+}
+
+// Bytewise order, which for UTF-8 is code point order
+static inline int hc_str_compare(hc_str a, hc_str b)
+{
+    uint32_t length = a.length < b.length ? a.length : b.length;
+    int order = memcmp(hc_str_bytes(&a), hc_str_bytes(&b), length);
+    if (order != 0)
+        return order;
+    return a.length < b.length ? -1 : a.length > b.length;
+}
+
+static inline uint64_t hc_str_hash(hc_str s)
+{
+    const unsigned char *p = (const unsigned char *)hc_str_bytes(&s);
+    size_t length = s.length;
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ length;
+
+    // Eight bytes per multiply; the tail is folded in byte by byte
+    for (; length >= 8; p += 8, length -= 8)
+    {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    for (; length > 0; p++, length--)
+        hash = (hash ^ *p) * 0x100000001B3ull;
+    return hash ^ (hash >> 29);
+}
+
+// ---- UTF-8 -----------------------------------------------------------------
+
+// Decode the code point at p; invalid or truncated sequences decode as U+FFFD
+// and consume one byte. Returns the sequence length.
+static inline int hc_utf8_decode(const unsigned char *p, const unsigned char *end, uint32_t *codepoint)
+{
+    unsigned char lead = p[0];
+    if (HC_RUNTIME_LIKELY(lead < 0x80))
+    {
+        *codepoint = lead;
+        return 1;
+    }
+
+    int length = lead >= 0xF8 ? 0 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 0;
+    if (length == 0 || end - p < length)
+    {
+        *codepoint = 0xFFFD;
+        return 1;
+    }
+
+    uint32_t value = lead & (0x7F >> length);
+    for (int i = 1; i < length; i++)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+        {
+            *codepoint = 0xFFFD;
+            return 1;
+        }
+        value = (value << 6) | (p[i] & 0x3F);
+    }
+    *codepoint = value;
+    return length;
+}
+
+// Number of code points: every byte that is not a continuation byte (10xxxxxx)
+// starts one. Eight bytes are classified per step.
+static inline int hc_str_codepoints(hc_str s)
+{
+    const unsigned char *p = (const unsigned char *)hc_str_bytes(&s);
+    size_t length = s.length;
+    size_t continuation = 0;
+
+    for (; length >= 8; p += 8, length -= 8)
+    {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        uint64_t marks = word & ~(word << 1) & 0x8080808080808080ull;
+#if defined(__GNUC__)
+        continuation += (size_t)__builtin_popcountll(marks);
+#else
+        for (; marks != 0; marks &= marks - 1)
+            continuation++;
+#endif
+    }
+    for (; length > 0; p++, length--)
+        continuation += (*p & 0xC0) == 0x80;
+
+    return (int)(s.length - continuation);
+}
+
+// Marks that attach to the preceding character: combining diacritics,
+// Devanagari signs and vowel signs, joiners and variation selectors
+static inline int hc_is_grapheme_extend(uint32_t c)
+{
+    return (c >= 0x0300 && c <= 0x036F) ||
+           (c >= 0x0900 && c <= 0x0903) ||
+           (c >= 0x093A && c <= 0x093C) ||
+           (c >= 0x093E && c <= 0x094F) ||
+           (c >= 0x0951 && c <= 0x0957) ||
+           (c >= 0x0962 && c <= 0x0963) ||
+           (c >= 0x200C && c <= 0x200D) ||
+           (c >= 0xFE00 && c <= 0xFE0F);
+}
+
+static inline int hc_is_devanagari_consonant(uint32_t c)
+{
+    return (c >= 0x0915 && c <= 0x0939) || (c >= 0x0958 && c <= 0x095F) || (c >= 0x0978 && c <= 0x097F);
+}
+
+#define HC_DEVANAGARI_VIRAMA 0x094D
+
+// End offset of the grapheme cluster (user-perceived character) starting at
+// offset. A virama followed by a consonant continues the cluster, so
+// conjuncts such as क्ष and श्र count as one character.
+static inline size_t hc_utf8_next_grapheme(const char *data, size_t length, size_t offset)
+{
+    const unsigned char *p = (const unsigned char *)data + offset;
+    const unsigned char *end = (const unsigned char *)data + length;
+
+    // ASCII followed by ASCII is a whole cluster (except CR LF)
+    if (p[0] < 0x80 && (p + 1 == end || p[1] < 0x80))
+        return offset + ((p[0] == '\r' && p + 1 < end && p[1] == '\n') ? 2 : 1);
+
+    uint32_t previous;
+    p += hc_utf8_decode(p, end, &previous);
+    while (p < end)
+    {
+        uint32_t next;
+        int size = hc_utf8_decode(p, end, &next);
+        if (!hc_is_grapheme_extend(next) &&
+            !(previous == HC_DEVANAGARI_VIRAMA && hc_is_devanagari_consonant(next)))
+            break;
+        p += size;
+        previous = next;
+    }
+    return (size_t)(p - (const unsigned char *)data);
+}
+
+static inline int hc_str_graphemes(hc_str s)
+{
+    const char *data = hc_str_bytes(&s);
+    int count = 0;
+    for (size_t offset = 0; offset < s.length; count++)
+        offset = hc_utf8_next_grapheme(data, s.length, offset);
+    return count;
+}
+
+// Position of a recent grapheme lookup in a string (see hc_str_grapheme_at)
+typedef struct
+{
+    const char *data;
+    const uint64_t *creator; // NULL for static and small strings
+    uint64_t serial;
+    uint32_t length;
+    int index;
+    size_t offset;
+} hc_grapheme_cursor;
+
+// Strings whose lookups each thread remembers at once
+#define HC_GRAPHEME_CURSORS 4
+
+// The index-th grapheme cluster of s. Each thread remembers where its last
+// lookups in a few strings ended, so walking a string from front to back,
+// or two strings side by side, is linear overall. The cursors are per
+// thread, so tasks may look up characters of the same string at once.
+// Small strings are short enough to scan from the start.
+static inline hc_str hc_str_grapheme_at(hc_str s, int index)
+{
+    static _Thread_local hc_grapheme_cursor cursors[HC_GRAPHEME_CURSORS];
+    hc_grapheme_cursor scratch = {NULL, NULL, 0, 0, 0, 0};
+    const uint64_t *creator = s.kind == HC_STR_HEAP ? s.u.ref.owner->creator : NULL;
+    uint64_t serial = s.kind == HC_STR_HEAP ? s.u.ref.owner->serial : 0;
+    hc_grapheme_cursor *cursor =
+        s.kind == HC_STR_SMALL ? &scratch : &cursors[((uintptr_t)s.u.ref.data >> 4) % HC_GRAPHEME_CURSORS];
+
+    const char *data = hc_str_bytes(&s);
+    if (cursor->data != data || cursor->creator != creator || cursor->serial != serial ||
+        cursor->length != s.length || cursor->index > index)
+    {
+        cursor->data = data;
+        cursor->creator = creator;
+        cursor->serial = serial;
+        cursor->length = s.length;
+        cursor->index = 0;
+        cursor->offset = 0;
+    }
+
+    while (cursor->index < index && cursor->offset < s.length)
+    {
+        cursor->offset = hc_utf8_next_grapheme(data, s.length, cursor->offset);
+        cursor->index++;
+    }
+    if (HC_RUNTIME_UNLIKELY(index < 0 || cursor->offset >= s.length))
+        hc_fatal("character index out of range");
+
+    size_t end = hc_utf8_next_grapheme(data, s.length, cursor->offset);
+    return hc_str_slice(s, (int)cursor->offset, (int)(end - cursor->offset));
+}
+
+#endif /* HC_STR_H */
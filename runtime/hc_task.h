@@ -0,0 +1,412 @@
+/* runtime/hc_task.h */
+#ifndef HC_TASK_H
+#define HC_TASK_H
+
+// कार्य / प्रतीक्षा: fork-join tasks on a work-stealing pool.
+//
+// Every worker owns a Chase–Lev deque. A worker pushes the tasks it spawns
+// onto the bottom of its own deque and takes them back from there, newest
+// first; idle workers steal the oldest task from the top of a random
+// victim's deque. Waiting workers keep running tasks, so a join never blocks
+// a thread while there is work to do.
+//
+// Each function that spawns tasks owns one hc_task_frame counting the tasks
+// it has started and not yet seen finish. hc_task_sync waits for all of them.
+//
+// The pool starts on the first spawn, with HC_WORKERS workers or one per
+// online CPU, and grows while all workers are blocked on channels. The
+// thread that spawns first becomes worker 0. Programs using tasks link with
+// -pthread. Exactly one translation unit defines HC_TASK_IMPLEMENTATION
+// before including this header.
+//
+// Memory orders follow Lê, Pop, Cohen and Zappa Nardelli, "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+
+// clock_gettime and CLOCK_REALTIME are POSIX, which -std=c99 and -std=c11
+// hide. The macro only counts before the first system header, so generated
+// code defines it first as well.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "hc_common.h"
+#include <stdatomic.h>
+
+typedef struct hc_task_frame hc_task_frame;
+
+typedef struct hc_task
+{
+    void (*run)(struct hc_task *task);
+    hc_task_frame *frame;
+    struct hc_task *next; // Next heap-allocated task of the same frame
+} hc_task;
+
+struct hc_task_frame
+{
+    atomic_long pending;  // Tasks spawned and not finished
+    hc_task *allocated;   // Task records to free at the next sync
+};
+
+// Start task on another worker, or later on this one, as part of frame
+void hc_task_spawn(hc_task_frame *frame, hc_task *task, void (*run)(hc_task *task));
+
+// Wait until the tasks of frame have finished, running other tasks meanwhile
+void hc_task_wait(hc_task_frame *frame);
+
+// Bracket a wait for something other than a join, such as a channel. When
+// every worker is blocked this way the pool adds a worker, so the tasks that
+// would unblock them still get to run.
+void hc_task_block_begin(void);
+void hc_task_block_end(void);
+
+// Storage for a task record that must outlive the spawning block; freed by
+// the frame's next sync
+static inline void *hc_task_alloc(hc_task_frame *frame, size_t size)
+{
+    hc_task *task = (hc_task *)hc_alloc(size);
+    task->next = frame->allocated;
+    frame->allocated = task;
+    return task;
+}
+
+// प्रतीक्षा. Also used as the frame's cleanup, so a function never returns
+// while tasks it started are still running.
+static inline void hc_task_sync(hc_task_frame *frame)
+{
+    if (atomic_load_explicit(&frame->pending, memory_order_acquire) != 0)
+        hc_task_wait(frame);
+
+    while (frame->allocated != NULL)
+    {
+        hc_task *next = frame->allocated->next;
+        hc_release(frame->allocated);
+        frame->allocated = next;
+    }
+}
+
+#ifdef HC_TASK_IMPLEMENTATION
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+// Circular array of a deque; replaced by one twice the size when full
+typedef struct hc_task_buffer
+{
+    int64_t capacity; // Power of two
+    struct hc_task_buffer *previous; // Outgrown buffers; thieves may still read them
+    _Atomic(hc_task *) slots[];
+} hc_task_buffer;
+
+typedef struct
+{
+    // The owner works at the bottom and thieves at the top, so the two ends
+    // sit on separate cache lines
+    _Alignas(64) atomic_llong top;
+    _Alignas(64) atomic_llong bottom;
+    _Atomic(hc_task_buffer *) buffer;
+    uint64_t seed; // Victim selection
+    int index;
+} hc_task_worker;
+
+// Room for the workers added while others are blocked
+#define HC_TASK_MAX_WORKERS 256
+
+static hc_task_worker *hc_task_workers;
+static atomic_int hc_task_worker_count;
+static atomic_int hc_task_blocked;
+static pthread_mutex_t hc_task_grow_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local hc_task_worker *hc_task_self;
+
+// Idle workers sleep here once stealing keeps failing
+static atomic_int hc_task_sleepers;
+static pthread_mutex_t hc_task_sleep_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t hc_task_wakeup = PTHREAD_COND_INITIALIZER;
+
+static hc_task_buffer *hc_task_buffer_new(int64_t capacity)
+{
+    hc_task_buffer *buffer =
+        (hc_task_buffer *)hc_alloc(sizeof(hc_task_buffer) + sizeof(hc_task *) * (size_t)capacity);
+    buffer->capacity = capacity;
+    buffer->previous = NULL;
+    return buffer;
+}
+
+// Owner only: move the live tasks [top, bottom) into a buffer twice the size
+static hc_task_buffer *hc_task_grow(hc_task_worker *worker, hc_task_buffer *old, int64_t top, int64_t bottom)
+{
+    hc_task_buffer *buffer = hc_task_buffer_new(old->capacity * 2);
+    for (int64_t i = top; i < bottom; i++)
+    {
+        hc_task *task = atomic_load_explicit(&old->slots[i & (old->capacity - 1)], memory_order_relaxed);
+        atomic_store_explicit(&buffer->slots[i & (buffer->capacity - 1)], task, memory_order_relaxed);
+    }
+    buffer->previous = old;
+    atomic_store_explicit(&worker->buffer, buffer, memory_order_release);
+    return buffer;
+}
+
+// Owner only: add a task at the bottom
+static void hc_task_push(hc_task_worker *worker, hc_task *task)
+{
+    int64_t bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&worker->top, memory_order_acquire);
+    hc_task_buffer *buffer = atomic_load_explicit(&worker->buffer, memory_order_relaxed);
+
+    if (HC_RUNTIME_UNLIKELY(bottom - top > buffer->capacity - 1))
+        buffer = hc_task_grow(worker, buffer, top, bottom);
+
+    atomic_store_explicit(&buffer->slots[bottom & (buffer->capacity - 1)], task, memory_order_relaxed);
+    // Publishes the task record along with the slot
+    atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_release);
+}
+
+// Owner only: remove the newest task, or return NULL
+static hc_task *hc_task_take(hc_task_worker *worker)
+{
+    int64_t bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed) - 1;
+    hc_task_buffer *buffer = atomic_load_explicit(&worker->buffer, memory_order_relaxed);
+    atomic_store_explicit(&worker->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&worker->top, memory_order_relaxed);
+
+    hc_task *task = NULL;
+    if (top <= bottom)
+    {
+        task = atomic_load_explicit(&buffer->slots[bottom & (buffer->capacity - 1)], memory_order_relaxed);
+        if (top == bottom)
+        {
+            // The last task: race the thieves for it
+            if (!atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1,
+                                                         memory_order_seq_cst, memory_order_relaxed))
+                task = NULL;
+            atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+        }
+    }
+    else
+    {
+        atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Any thread: remove the oldest task, or return NULL when there is none or
+// another thread got it first
+static hc_task *hc_task_steal(hc_task_worker *worker)
+{
+    int64_t top = atomic_load_explicit(&worker->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&worker->bottom, memory_order_acquire);
+
+    if (top >= bottom)
+        return NULL;
+
+    hc_task_buffer *buffer = atomic_load_explicit(&worker->buffer, memory_order_acquire);
+    hc_task *task = atomic_load_explicit(&buffer->slots[top & (buffer->capacity - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+    return task;
+}
+
+static void hc_task_run(hc_task *task)
+{
+    hc_task_frame *frame = task->frame;
+    task->run(task);
+    // The task record may be freed as soon as pending reaches zero
+    atomic_fetch_sub_explicit(&frame->pending, 1, memory_order_release);
+}
+
+// Try one random victim other than self
+static hc_task *hc_task_steal_any(hc_task_worker *self)
+{
+    int count = atomic_load_explicit(&hc_task_worker_count, memory_order_acquire);
+    if (count < 2)
+        return NULL;
+
+    // xorshift64
+    self->seed ^= self->seed << 13;
+    self->seed ^= self->seed >> 7;
+    self->seed ^= self->seed << 17;
+    int victim = (int)(self->seed % (uint64_t)(count - 1));
+    if (victim >= self->index)
+        victim++;
+    return hc_task_steal(&hc_task_workers[victim]);
+}
+
+static void *hc_task_worker_main(void *argument)
+{
+    hc_task_self = (hc_task_worker *)argument;
+    int failures = 0;
+
+    for (;;)
+    {
+        hc_task *task = hc_task_steal_any(hc_task_self);
+        if (task != NULL)
+        {
+            failures = 0;
+            hc_task_run(task);
+            continue;
+        }
+
+        // Spin briefly, then yield, then sleep until a spawn or a timeout
+        failures++;
+        if (failures < 64)
+            continue;
+        if (failures < 128)
+        {
+            sched_yield();
+            continue;
+        }
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += 1000000;
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        pthread_mutex_lock(&hc_task_sleep_lock);
+        atomic_fetch_add(&hc_task_sleepers, 1);
+        pthread_cond_timedwait(&hc_task_wakeup, &hc_task_sleep_lock, &deadline);
+        atomic_fetch_sub(&hc_task_sleepers, 1);
+        pthread_mutex_unlock(&hc_task_sleep_lock);
+        failures = 64;
+    }
+    return NULL;
+}
+
+static void hc_task_init_worker(int index)
+{
+    hc_task_worker *worker = &hc_task_workers[index];
+    atomic_init(&worker->top, 0);
+    atomic_init(&worker->bottom, 0);
+    atomic_init(&worker->buffer, hc_task_buffer_new(256));
+    worker->seed = 0x9E3779B97F4A7C15ull * (uint64_t)(index + 1);
+    worker->index = index;
+}
+
+static void hc_task_start_thread(int index)
+{
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, hc_task_worker_main, &hc_task_workers[index]) != 0)
+        hc_fatal("could not start a task worker");
+    pthread_detach(thread);
+}
+
+// Create the pool and make the calling thread worker 0
+static void hc_task_start(void)
+{
+    long count = 0;
+    const char *setting = getenv("HC_WORKERS");
+    if (setting != NULL)
+        count = strtol(setting, NULL, 10);
+    if (count <= 0)
+        count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count <= 0)
+        count = 1;
+    if (count > HC_TASK_MAX_WORKERS)
+        count = HC_TASK_MAX_WORKERS;
+
+    hc_task_workers = (hc_task_worker *)aligned_alloc(_Alignof(hc_task_worker),
+                                                      sizeof(hc_task_worker) * HC_TASK_MAX_WORKERS);
+    if (hc_task_workers == NULL)
+        hc_fatal("out of memory");
+
+    for (int i = 0; i < count; i++)
+    {
+        hc_task_init_worker(i);
+    }
+    atomic_store_explicit(&hc_task_worker_count, (int)count, memory_order_release);
+    hc_task_self = &hc_task_workers[0];
+
+    for (int i = 1; i < count; i++)
+    {
+        hc_task_start_thread(i);
+    }
+}
+
+void hc_task_block_begin(void)
+{
+    // Threads outside the pool hold up no tasks
+    if (hc_task_self == NULL)
+        return;
+
+    int blocked = atomic_fetch_add(&hc_task_blocked, 1) + 1;
+    if (blocked < atomic_load(&hc_task_worker_count))
+        return;
+
+    pthread_mutex_lock(&hc_task_grow_lock);
+    int count = atomic_load_explicit(&hc_task_worker_count, memory_order_relaxed);
+    if (count < HC_TASK_MAX_WORKERS && atomic_load(&hc_task_blocked) >= count)
+    {
+        hc_task_init_worker(count);
+        atomic_store_explicit(&hc_task_worker_count, count + 1, memory_order_release);
+        hc_task_start_thread(count);
+    }
+    pthread_mutex_unlock(&hc_task_grow_lock);
+}
+
+void hc_task_block_end(void)
+{
+    if (hc_task_self != NULL)
+        atomic_fetch_sub(&hc_task_blocked, 1);
+}
+
+void hc_task_spawn(hc_task_frame *frame, hc_task *task, void (*run)(hc_task *task))
+{
+    if (HC_RUNTIME_UNLIKELY(hc_task_self == NULL))
+        hc_task_start();
+
+    task->run = run;
+    task->frame = frame;
+    atomic_fetch_add_explicit(&frame->pending, 1, memory_order_relaxed);
+    hc_task_push(hc_task_self, task);
+
+    if (atomic_load_explicit(&hc_task_sleepers, memory_order_relaxed) > 0)
+        pthread_cond_signal(&hc_task_wakeup);
+}
+
+void hc_task_wait(hc_task_frame *frame)
+{
+    hc_task_worker *self = hc_task_self;
+
+    // The frame's unstolen tasks are the newest ones on our deque: tasks
+    // spawned by callees were joined before the callees returned. Run them
+    // until a task of an enclosing frame turns up.
+    while (atomic_load_explicit(&frame->pending, memory_order_acquire) != 0)
+    {
+        hc_task *task = hc_task_take(self);
+        if (task == NULL)
+            break;
+        if (task->frame != frame)
+        {
+            hc_task_push(self, task);
+            break;
+        }
+        hc_task_run(task);
+    }
+
+    // The rest were stolen: help out elsewhere until they have finished
+    int failures = 0;
+    while (atomic_load_explicit(&frame->pending, memory_order_acquire) != 0)
+    {
+        hc_task *task = hc_task_steal_any(self);
+        if (task != NULL)
+        {
+            failures = 0;
+            hc_task_run(task);
+        }
+        else if (++failures >= 64)
+        {
+            sched_yield();
+        }
+    }
+}
+
+#endif /* HC_TASK_IMPLEMENTATION */
+
+#endif /* HC_TASK_H */
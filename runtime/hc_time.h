@@ -0,0 +1,257 @@
+/* runtime/hc_time.h */
+#ifndef HC_TIME_H
+#define HC_TIME_H
+
+// समय_नैनो and मापो: a monotonic nanosecond clock and benchmark blocks.
+//
+// On x86-64 with an invariant time-stamp counter the clock reads the TSC,
+// which takes a few nanoseconds instead of a clock_gettime call. The first
+// reading measures the counter's rate against CLOCK_MONOTONIC over two
+// milliseconds; readings are then scaled from that point, so they stay on
+// the CLOCK_MONOTONIC time line. Everywhere else the clock is
+// clock_gettime(CLOCK_MONOTONIC).
+//
+// The calibration and the epoch of समय_नैनो are shared by all translation
+// units of a program; exactly one defines HC_TIME_IMPLEMENTATION before
+// including this header.
+
+// clock_gettime and CLOCK_MONOTONIC are POSIX, which -std=c99 and -std=c11 hide
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "hc_common.h"
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__SIZEOF_INT128__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define HC_TIME_TSC 1
+#endif
+
+// Nanoseconds the counter's rate is measured over
+#define HC_TIME_CALIBRATION 2000000
+// Back-to-back clock readings a मापो block takes to find the clock's cost
+#define HC_BENCH_OVERHEAD_SAMPLES 64
+
+static inline uint64_t hc_time_clock(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+#if defined(HC_TIME_TSC)
+enum
+{
+    HC_TIME_UNCALIBRATED,
+    HC_TIME_CALIBRATING,
+    HC_TIME_COUNTER, // Calibrated; the TSC is read
+    HC_TIME_SYSTEM,  // No invariant TSC; clock_gettime is called
+};
+
+typedef struct
+{
+    atomic_int state;
+    uint64_t ticks; // Counter at the end of calibration
+    uint64_t ns;    // CLOCK_MONOTONIC at the same moment
+    uint64_t scale; // Nanoseconds per tick, 32.32 fixed point
+} hc_time_calibration;
+
+extern hc_time_calibration hc_time_tsc;
+#ifdef HC_TIME_IMPLEMENTATION
+hc_time_calibration hc_time_tsc;
+#endif
+
+static inline uint64_t hc_time_ticks(void)
+{
+    // Keep earlier instructions from finishing after the reading
+    _mm_lfence();
+    return __rdtsc();
+}
+
+static void hc_time_calibrate(void)
+{
+    int expected = HC_TIME_UNCALIBRATED;
+    if (!atomic_compare_exchange_strong(&hc_time_tsc.state, &expected, HC_TIME_CALIBRATING))
+        return;
+
+    unsigned eax, ebx, ecx, edx;
+    int invariant = __get_cpuid_max(0x80000000u, NULL) >= 0x80000007u &&
+                    __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) && (edx >> 8) & 1;
+    if (!invariant)
+    {
+        atomic_store_explicit(&hc_time_tsc.state, HC_TIME_SYSTEM, memory_order_release);
+        return;
+    }
+
+    uint64_t ns = hc_time_clock();
+    uint64_t ticks = hc_time_ticks();
+    uint64_t endNs, endTicks;
+    do
+    {
+        endNs = hc_time_clock();
+        endTicks = hc_time_ticks();
+    } while (endNs - ns < HC_TIME_CALIBRATION);
+
+    hc_time_tsc.scale = (uint64_t)((double)(endNs - ns) / (double)(endTicks - ticks) * 4294967296.0);
+    hc_time_tsc.ticks = endTicks;
+    hc_time_tsc.ns = endNs;
+    atomic_store_explicit(&hc_time_tsc.state, HC_TIME_COUNTER, memory_order_release);
+}
+#endif
+
+// Monotonic time in nanoseconds
+static inline uint64_t hc_time_ns(void)
+{
+#if defined(HC_TIME_TSC)
+    int state = atomic_load_explicit(&hc_time_tsc.state, memory_order_acquire);
+    if (HC_RUNTIME_UNLIKELY(state == HC_TIME_UNCALIBRATED))
+    {
+        hc_time_calibrate();
+        state = atomic_load_explicit(&hc_time_tsc.state, memory_order_acquire);
+    }
+    if (HC_RUNTIME_LIKELY(state == HC_TIME_COUNTER))
+    {
+        unsigned __int128 elapsed = (unsigned __int128)(hc_time_ticks() - hc_time_tsc.ticks) * hc_time_tsc.scale;
+        return hc_time_tsc.ns + (uint64_t)(elapsed >> 32);
+    }
+#endif
+    return hc_time_clock();
+}
+
+extern atomic_uint_fast64_t hc_time_epoch;
+#ifdef HC_TIME_IMPLEMENTATION
+atomic_uint_fast64_t hc_time_epoch;
+#endif
+
+// समय_नैनो(): nanoseconds since the program first asked, as a पूर्णांक. It
+// wraps after about two seconds, which is plenty for timing short sections.
+static inline int hc_time_nano(void)
+{
+    uint64_t now = hc_time_ns();
+    uint_fast64_t start = atomic_load_explicit(&hc_time_epoch, memory_order_relaxed);
+    if (HC_RUNTIME_UNLIKELY(start == 0))
+    {
+        uint_fast64_t unset = 0;
+        start = atomic_compare_exchange_strong(&hc_time_epoch, &unset, now) ? now : unset;
+    }
+    return (int)(uint32_t)(now - start);
+}
+
+// A मापो block in progress. The body first runs a tenth as many times
+// again, untimed, to warm caches and branch predictors.
+typedef struct
+{
+    int line; // Of the block in the Hindi source
+    int runs; // Timed runs
+    int warmups;
+    int done; // Runs finished, warm-ups included; -1 before the first
+    uint64_t start;
+    uint64_t overhead; // Cost of reading the clock, taken off every run
+    uint64_t *times;
+} hc_bench;
+
+static inline hc_bench hc_bench_begin(int runs, int line)
+{
+    hc_bench bench;
+    bench.line = line;
+    bench.runs = runs > 0 ? runs : 0;
+    bench.warmups = bench.runs > 0 ? bench.runs / 10 + 1 : 0;
+    bench.done = -1;
+    bench.start = 0;
+    bench.overhead = UINT64_MAX;
+    for (int i = 0; i < HC_BENCH_OVERHEAD_SAMPLES; i++)
+    {
+        uint64_t first = hc_time_ns();
+        uint64_t second = hc_time_ns();
+        if (second - first < bench.overhead)
+            bench.overhead = second - first;
+    }
+    bench.times = (uint64_t *)hc_alloc(sizeof(uint64_t) * (size_t)(bench.runs > 0 ? bench.runs : 1));
+    return bench;
+}
+
+// Finish the run in progress and start the next; 0 once every run is done
+static inline int hc_bench_next(hc_bench *bench)
+{
+    uint64_t now = hc_time_ns();
+    if (bench->done >= bench->warmups)
+    {
+        uint64_t elapsed = now - bench->start;
+        bench->times[bench->done - bench->warmups] = elapsed > bench->overhead ? elapsed - bench->overhead : 0;
+    }
+
+    if (++bench->done == bench->warmups + bench->runs)
+        return 0;
+    bench->start = hc_time_ns();
+    return 1;
+}
+
+static inline int hc_bench_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Print the fastest, median and 99th percentile run to stderr
+static inline void hc_bench_report(hc_bench *bench)
+{
+    if (bench->runs == 0)
+    {
+        fprintf(stderr, "मापो, line %d: no runs\n", bench->line);
+    }
+    else
+    {
+        uint64_t *times = bench->times;
+        int runs = bench->runs;
+        qsort(times, (size_t)runs, sizeof(uint64_t), hc_bench_compare);
+        uint64_t median = runs % 2 ? times[runs / 2] : (times[runs / 2 - 1] + times[runs / 2]) / 2;
+        uint64_t p99 = times[(runs * 99 + 99) / 100 - 1];
+        fprintf(stderr, "मापो, line %d: %d runs, min %" PRIu64 " ns, median %" PRIu64 " ns, p99 %" PRIu64 " ns\n",
+                bench->line, runs, times[0], median, p99);
+    }
+    hc_release(bench->times);
+}
+
+// Keep the compiler from optimizing the measured body away. A variable the
+// body reads or writes is opaque on both sides of it: before, the compiler
+// must assume it changed, so nothing the body computes from it can be hoisted
+// out of the loop; after, it must assume the value is used, so the stores
+// stay. Values computed and then dropped are consumed the same way.
+#if defined(__GNUC__)
+#define HC_BENCH_OPAQUE(variable) __asm__ volatile("" : "+m"(variable) : : "memory")
+
+static inline void hc_bench_keep_int(int value)
+{
+    __asm__ volatile("" : : "g"(value) : "memory");
+}
+
+static inline void hc_bench_keep_float(float value)
+{
+    __asm__ volatile("" : : "m"(value) : "memory");
+}
+#else
+#define HC_BENCH_OPAQUE(variable) ((void)(variable))
+
+static volatile int hc_bench_int_sink;
+static volatile float hc_bench_float_sink;
+
+static inline void hc_bench_keep_int(int value)
+{
+    hc_bench_int_sink = value;
+}
+
+static inline void hc_bench_keep_float(float value)
+{
+    hc_bench_float_sink = value;
+}
+#endif
+
+#define HC_BENCH_KEEP(value) \
+    _Generic((value), float: hc_bench_keep_float, double: hc_bench_keep_float, default: hc_bench_keep_int)(value)
+
+#endif /* HC_TIME_H */
@@ -0,0 +1,572 @@
+/* src/analysis/callgraph.c */
+#include "../../include/analysis.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Each enclosing loop is assumed to run the call site this many times
+#define LOOP_WEIGHT 10.0
+
+// Calls into a recursive component are assumed to recurse this many times
+#define RECURSION_WEIGHT 10.0
+
+// Functions estimated to run at least this often per run of मुख्य are hot
+#define HOT_FREQUENCY 10.0
+
+// Words in string literals that mark a branch as error handling
+static const char *errorMarkers[] = {
+    "त्रुटि",
+    "गलती",
+    "error",
+    "Error",
+    "ERROR",
+    NULL // End sentinel
+};
+
+// Check whether two tokens spell the same name
+static bool sameName(Token a, Token b)
+{
+    return a.length == b.length && memcmp(a.start, b.start, a.length) == 0;
+}
+
+// Check whether a token names the program entry point (मुख्य)
+bool isEntryPoint(Token name)
+{
+    const char *entry = "मुख्य";
+    size_t length = strlen(entry);
+    return (size_t)name.length == length && memcmp(name.start, entry, length) == 0;
+}
+
+// Find a function's call graph index by name
+int findCallGraphNode(CallGraph *graph, Token name)
+{
+    for (int i = 0; i < graph->count; i++)
+    {
+        if (sameName(graph->nodes[i].decl->name, name))
+        {
+            return i;
+        }
+    }
+
+    return -1; // Builtins and unknown names are not part of the graph
+}
+
+// Check whether a string literal token contains an error marker
+static bool isErrorMessage(Token literal)
+{
+    for (int i = 0; errorMarkers[i] != NULL; i++)
+    {
+        size_t length = strlen(errorMarkers[i]);
+        for (int j = 0; j + (int)length <= literal.length; j++)
+        {
+            if (memcmp(literal.start + j, errorMarkers[i], length) == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+// Check whether a statement looks like an error path (reports an error message)
+bool isColdPath(AstNode *node)
+{
+    if (node == NULL)
+        return false;
+
+    switch (node->type)
+    {
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        for (int i = 0; i < block->count; i++)
+        {
+            if (isColdPath(block->statements[i]))
+                return true;
+        }
+        return false;
+    }
+    case AST_EXPRESSION_STMT:
+        return isColdPath(((AstExpressionStmt *)node)->expression);
+    case AST_RETURN:
+        return isColdPath(((AstReturn *)node)->value);
+    case AST_SPAWN:
+        return isColdPath((AstNode *)((AstSpawn *)node)->call);
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)node;
+        for (int i = 0; i < call->argCount; i++)
+        {
+            if (isColdPath(call->arguments[i]))
+                return true;
+        }
+        return false;
+    }
+    case AST_LITERAL:
+    {
+        Token value = ((AstLiteral *)node)->value;
+        return value.type == TOKEN_STRING && isErrorMessage(value);
+    }
+    default:
+        // Nested control flow is not an error report by itself
+        return false;
+    }
+}
+
+// Record a call site from caller to callee
+static void addCallSite(CallGraph *graph, int caller, int callee, int loopDepth, bool cold)
+{
+    CallGraphNode *node = &graph->nodes[caller];
+    if (node->calleeCount >= node->calleeCapacity)
+    {
+        node->calleeCapacity = node->calleeCapacity == 0 ? 4 : node->calleeCapacity * 2;
+        node->callees = realloc(node->callees, sizeof(CallSite) * node->calleeCapacity);
+    }
+    CallSite *site = &node->callees[node->calleeCount++];
+    site->callee = callee;
+    site->loopDepth = loopDepth;
+    site->cold = cold;
+    graph->nodes[callee].callCount++;
+}
+
+// Walk a function body and record every call to a user-defined function
+static void collectCalls(CallGraph *graph, int caller, AstNode *node, int loopDepth, bool cold)
+{
+    if (node == NULL)
+        return;
+
+    switch (node->type)
+    {
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        for (int i = 0; i < block->count; i++)
+        {
+            collectCalls(graph, caller, block->statements[i], loopDepth, cold);
+        }
+        break;
+    }
+    case AST_VAR_DECL:
+        collectCalls(graph, caller, ((AstVarDecl *)node)->initializer, loopDepth, cold);
+        break;
+    case AST_IF:
+    {
+        AstIf *ifStmt = (AstIf *)node;
+        collectCalls(graph, caller, ifStmt->condition, loopDepth, cold);
+        collectCalls(graph, caller, ifStmt->thenBranch, loopDepth,
+                     cold || isColdPath(ifStmt->thenBranch));
+        collectCalls(graph, caller, ifStmt->elseBranch, loopDepth,
+                     cold || isColdPath(ifStmt->elseBranch));
+        break;
+    }
+    case AST_WHILE:
+    {
+        // The condition runs once per iteration as well
+        AstWhile *whileStmt = (AstWhile *)node;
+        collectCalls(graph, caller, whileStmt->condition, loopDepth + 1, cold);
+        collectCalls(graph, caller, whileStmt->body, loopDepth + 1, cold);
+        break;
+    }
+    case AST_FOR:
+    {
+        AstFor *forStmt = (AstFor *)node;
+        collectCalls(graph, caller, forStmt->initializer, loopDepth, cold);
+        collectCalls(graph, caller, forStmt->condition, loopDepth + 1, cold);
+        collectCalls(graph, caller, forStmt->increment, loopDepth + 1, cold);
+        collectCalls(graph, caller, forStmt->body, loopDepth + 1, cold);
+        break;
+    }
+    case AST_RETURN:
+        collectCalls(graph, caller, ((AstReturn *)node)->value, loopDepth, cold);
+        break;
+    case AST_EXPRESSION_STMT:
+        collectCalls(graph, caller, ((AstExpressionStmt *)node)->expression, loopDepth, cold);
+        break;
+    case AST_BINARY:
+        collectCalls(graph, caller, ((AstBinary *)node)->left, loopDepth, cold);
+        collectCalls(graph, caller, ((AstBinary *)node)->right, loopDepth, cold);
+        break;
+    case AST_UNARY:
+        collectCalls(graph, caller, ((AstUnary *)node)->right, loopDepth, cold);
+        break;
+    case AST_ASSIGNMENT:
+        collectCalls(graph, caller, ((AstAssignment *)node)->index, loopDepth, cold);
+        collectCalls(graph, caller, ((AstAssignment *)node)->value, loopDepth, cold);
+        break;
+    case AST_INDEX:
+        collectCalls(graph, caller, ((AstIndex *)node)->index, loopDepth, cold);
+        break;
+    case AST_SPAWN:
+        collectCalls(graph, caller, (AstNode *)((AstSpawn *)node)->call, loopDepth, cold);
+        break;
+    case AST_YIELD:
+        collectCalls(graph, caller, ((AstYield *)node)->value, loopDepth, cold);
+        break;
+    case AST_MEASURE:
+        // The measured body is a loop the program wants timed
+        collectCalls(graph, caller, ((AstMeasure *)node)->runs, loopDepth, cold);
+        collectCalls(graph, caller, ((AstMeasure *)node)->body, loopDepth + 1, cold);
+        break;
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)node;
+        int callee = findCallGraphNode(graph, call->name);
+        if (callee >= 0)
+        {
+            addCallSite(graph, caller, callee, loopDepth, cold);
+        }
+        for (int i = 0; i < call->argCount; i++)
+        {
+            collectCalls(graph, caller, call->arguments[i], loopDepth, cold);
+        }
+        break;
+    }
+    default:
+        // Literals and variables contain no calls
+        break;
+    }
+}
+
+// Tarjan's algorithm state for SCC detection
+typedef struct
+{
+    int nextIndex;
+    int *index;
+    int *lowLink;
+    bool *onStack;
+    int *stack;
+    int stackTop;
+} SccState;
+
+static void strongConnect(CallGraph *graph, SccState *state, int v)
+{
+    state->index[v] = state->lowLink[v] = state->nextIndex++;
+    state->stack[state->stackTop++] = v;
+    state->onStack[v] = true;
+
+    CallGraphNode *node = &graph->nodes[v];
+    for (int i = 0; i < node->calleeCount; i++)
+    {
+        int w = node->callees[i].callee;
+        if (state->index[w] < 0)
+        {
+            strongConnect(graph, state, w);
+            if (state->lowLink[w] < state->lowLink[v])
+                state->lowLink[v] = state->lowLink[w];
+        }
+        else if (state->onStack[w] && state->index[w] < state->lowLink[v])
+        {
+            state->lowLink[v] = state->index[w];
+        }
+    }
+
+    // v is the root of a component: pop it off the stack
+    if (state->lowLink[v] == state->index[v])
+    {
+        int scc = graph->sccCount++;
+        int members = 0;
+        int w;
+        do
+        {
+            w = state->stack[--state->stackTop];
+            state->onStack[w] = false;
+            graph->nodes[w].scc = scc;
+            members++;
+        } while (w != v);
+
+        // A multi-function component is mutual recursion
+        if (members > 1)
+        {
+            for (int i = 0; i < graph->count; i++)
+            {
+                if (graph->nodes[i].scc == scc)
+                    graph->nodes[i].recursive = true;
+            }
+        }
+    }
+}
+
+// Number the strongly connected components and flag recursive functions
+static void findComponents(CallGraph *graph)
+{
+    SccState state;
+    int count = graph->count > 0 ? graph->count : 1;
+    state.nextIndex = 0;
+    state.index = (int *)malloc(sizeof(int) * count);
+    state.lowLink = (int *)malloc(sizeof(int) * count);
+    state.onStack = (bool *)calloc(count, sizeof(bool));
+    state.stack = (int *)malloc(sizeof(int) * count);
+    state.stackTop = 0;
+
+    for (int i = 0; i < graph->count; i++)
+    {
+        state.index[i] = -1;
+
+        // Direct self-recursion forms a single-node cycle
+        for (int j = 0; j < graph->nodes[i].calleeCount; j++)
+        {
+            if (graph->nodes[i].callees[j].callee == i)
+                graph->nodes[i].recursive = true;
+        }
+    }
+
+    for (int i = 0; i < graph->count; i++)
+    {
+        if (state.index[i] < 0)
+            strongConnect(graph, &state, i);
+    }
+
+    free(state.index);
+    free(state.lowLink);
+    free(state.onStack);
+    free(state.stack);
+}
+
+// Mark everything reachable from a function
+static void markReachable(CallGraph *graph, int index)
+{
+    CallGraphNode *node = &graph->nodes[index];
+    if (node->reachable)
+        return;
+
+    node->reachable = true;
+    for (int i = 0; i < node->calleeCount; i++)
+    {
+        markReachable(graph, node->callees[i].callee);
+    }
+}
+
+// Propagate estimated call frequencies from मुख्य down the call graph
+static void estimateFrequencies(CallGraph *graph)
+{
+    if (graph->entry < 0)
+        return;
+
+    graph->nodes[graph->entry].frequency = 1.0;
+
+    // Components are numbered callees-first, so walking them in reverse
+    // visits every caller before its callees
+    for (int scc = graph->sccCount - 1; scc >= 0; scc--)
+    {
+        // Every member of a recursive component repeats the component's
+        // incoming frequency, whichever member the outside calls enter through
+        double incoming = 0.0;
+        bool recursive = false;
+        for (int i = 0; i < graph->count; i++)
+        {
+            if (graph->nodes[i].scc == scc)
+            {
+                incoming += graph->nodes[i].frequency;
+                recursive = recursive || graph->nodes[i].recursive;
+            }
+        }
+        if (recursive)
+        {
+            for (int i = 0; i < graph->count; i++)
+            {
+                if (graph->nodes[i].scc == scc)
+                    graph->nodes[i].frequency = incoming * RECURSION_WEIGHT;
+            }
+        }
+
+        for (int i = 0; i < graph->count; i++)
+        {
+            CallGraphNode *node = &graph->nodes[i];
+            if (node->scc != scc || node->frequency == 0.0)
+                continue;
+
+            for (int j = 0; j < node->calleeCount; j++)
+            {
+                CallSite *site = &node->callees[j];
+                if (site->cold || graph->nodes[site->callee].scc == scc)
+                    continue;
+
+                double weight = node->frequency;
+                for (int depth = 0; depth < site->loopDepth; depth++)
+                    weight *= LOOP_WEIGHT;
+                graph->nodes[site->callee].frequency += weight;
+            }
+        }
+    }
+
+    for (int i = 0; i < graph->count; i++)
+    {
+        CallGraphNode *node = &graph->nodes[i];
+        if (!node->reachable || node->frequency == 0.0)
+            node->temperature = TEMPERATURE_COLD;
+        else if (node->frequency >= HOT_FREQUENCY)
+            node->temperature = TEMPERATURE_HOT;
+        else
+            node->temperature = TEMPERATURE_NORMAL;
+    }
+}
+
+// Order function indices for emission: hot first, cold last
+void orderFunctionsByTemperature(CallGraph *graph, int *order)
+{
+    for (int i = 0; i < graph->count; i++)
+    {
+        order[i] = i;
+    }
+
+    // Insertion sort keeps source order among equally warm functions
+    for (int i = 1; i < graph->count; i++)
+    {
+        int current = order[i];
+        CallGraphNode *node = &graph->nodes[current];
+        int j = i - 1;
+        while (j >= 0)
+        {
+            CallGraphNode *other = &graph->nodes[order[j]];
+            if (other->temperature > node->temperature ||
+                (other->temperature == node->temperature && other->frequency >= node->frequency))
+                break;
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = current;
+    }
+}
+
+// Build the call graph from the AstCall nodes of an analyzed program
+void buildCallGraph(CallGraph *graph, AstProgram *program)
+{
+    graph->count = 0;
+    graph->nodes = (CallGraphNode *)malloc(sizeof(CallGraphNode) * (program->count > 0 ? program->count : 1));
+
+    // One node per function declaration, in source order
+    for (int i = 0; i < program->count; i++)
+    {
+        if (program->declarations[i]->type != AST_FUNCTION_DECL)
+            continue;
+
+        CallGraphNode *node = &graph->nodes[graph->count++];
+        node->decl = (AstFunctionDecl *)program->declarations[i];
+        node->size = countAstNodes((AstNode *)node->decl);
+        node->callCount = 0;
+        node->calleeCount = 0;
+        node->calleeCapacity = 0;
+        node->callees = NULL;
+        node->scc = -1;
+        node->recursive = false;
+        node->reachable = false;
+        node->frequency = 0.0;
+        node->temperature = TEMPERATURE_COLD;
+    }
+
+    // Edges: one per call site
+    for (int i = 0; i < graph->count; i++)
+    {
+        collectCalls(graph, i, graph->nodes[i].decl->body, 0, false);
+    }
+
+    graph->sccCount = 0;
+    findComponents(graph);
+
+    graph->entry = -1;
+    for (int i = 0; i < graph->count; i++)
+    {
+        if (isEntryPoint(graph->nodes[i].decl->name))
+        {
+            graph->entry = i;
+            markReachable(graph, i);
+            break;
+        }
+    }
+
+    estimateFrequencies(graph);
+}
+
+// A leaf calls no user-defined functions
+bool isLeafFunction(CallGraph *graph, int index)
+{
+    return graph->nodes[index].calleeCount == 0;
+}
+
+// Count the call sites in caller that target callee
+static int countEdge(CallGraph *graph, int caller, int callee)
+{
+    int count = 0;
+    for (int i = 0; i < graph->nodes[caller].calleeCount; i++)
+    {
+        if (graph->nodes[caller].callees[i].callee == callee)
+            count++;
+    }
+    return count;
+}
+
+// Write the call graph in Graphviz DOT format
+void dumpCallGraphDot(CallGraph *graph, FILE *output)
+{
+    fprintf(output, "digraph callgraph {\n");
+
+    for (int i = 0; i < graph->count; i++)
+    {
+        CallGraphNode *node = &graph->nodes[i];
+        fprintf(output, "    f%d [label=\"%.*s\\nsize=%d calls=%d scc=%d freq=%g\"%s%s];\n",
+                i, node->decl->name.length, node->decl->name.start,
+                node->size, node->callCount, node->scc, node->frequency,
+                node->reachable ? "" : " style=dashed",
+                node->recursive ? " shape=doublecircle" : (isLeafFunction(graph, i) ? " shape=box" : ""));
+    }
+
+    // One edge per caller/callee pair, labelled with its number of call sites
+    for (int i = 0; i < graph->count; i++)
+    {
+        for (int j = 0; j < graph->count; j++)
+        {
+            int sites = countEdge(graph, i, j);
+            if (sites > 0)
+            {
+                fprintf(output, "    f%d -> f%d [label=\"%d\"];\n", i, j, sites);
+            }
+        }
+    }
+
+    fprintf(output, "}\n");
+}
+
+// Write the call graph in JSON format
+void dumpCallGraphJson(CallGraph *graph, FILE *output)
+{
+    fprintf(output, "{\n  \"sccCount\": %d,\n  \"functions\": [\n", graph->sccCount);
+
+    for (int i = 0; i < graph->count; i++)
+    {
+        CallGraphNode *node = &graph->nodes[i];
+        fprintf(output, "    {\"name\": \"%.*s\", \"size\": %d, \"callCount\": %d, \"frequency\": %g, "
+                        "\"leaf\": %s, \"recursive\": %s, \"reachable\": %s, \"scc\": %d, \"callees\": [",
+                node->decl->name.length, node->decl->name.start,
+                node->size, node->callCount, node->frequency,
+                isLeafFunction(graph, i) ? "true" : "false",
+                node->recursive ? "true" : "false",
+                node->reachable ? "true" : "false",
+                node->scc);
+
+        bool first = true;
+        for (int j = 0; j < graph->count; j++)
+        {
+            int sites = countEdge(graph, i, j);
+            if (sites > 0)
+            {
+                fprintf(output, "%s{\"name\": \"%.*s\", \"sites\": %d}", first ? "" : ", ",
+                        graph->nodes[j].decl->name.length, graph->nodes[j].decl->name.start, sites);
+                first = false;
+            }
+        }
+
+        fprintf(output, "]}%s\n", i + 1 < graph->count ? "," : "");
+    }
+
+    fprintf(output, "  ]\n}\n");
+}
+
+// Free the call graph
+void freeCallGraph(CallGraph *graph)
+{
+    for (int i = 0; i < graph->count; i++)
+    {
+        free(graph->nodes[i].callees);
+    }
+    free(graph->nodes);
+    graph->nodes = NULL;
+    graph->count = 0;
+}
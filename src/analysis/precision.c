@@ -0,0 +1,198 @@
+/* src/analysis/precision.c */
+#include "../../include/analysis.h"
+#include <stdio.h>
+#include <string.h>
+
+// A decimal literal such as 0.5 is a double in C. Next to a दशमलव (float)
+// value it drags the whole operation into double precision: both sides are
+// converted, computed in double and rounded back on every iteration. This
+// pass points out such mixes inside loops, where they cost the most.
+
+// The unsuffixed decimal literal an expression is, possibly negated, or NULL
+static AstLiteral *doubleLiteral(AstNode *node)
+{
+    if (node == NULL)
+        return NULL;
+
+    if (node->type == AST_UNARY && ((AstUnary *)node)->operator== TOKEN_MINUS)
+        return doubleLiteral(((AstUnary *)node)->right);
+
+    if (node->type != AST_LITERAL)
+        return NULL;
+
+    Token value = ((AstLiteral *)node)->value;
+    if (value.type != TOKEN_NUMBER || memchr(value.start, '.', value.length) == NULL)
+        return NULL;
+    return (AstLiteral *)node;
+}
+
+// Check whether an expression is known at compile time, so the C compiler
+// folds it and nothing is computed at run time
+static bool isCompileTimeValue(AstNode *node)
+{
+    if (node == NULL)
+        return true;
+
+    switch (node->type)
+    {
+    case AST_LITERAL:
+        return true;
+    case AST_VARIABLE:
+        return ((AstVariable *)node)->constant != NULL;
+    case AST_UNARY:
+        return isCompileTimeValue(((AstUnary *)node)->right);
+    case AST_BINARY:
+        return isCompileTimeValue(((AstBinary *)node)->left) &&
+               isCompileTimeValue(((AstBinary *)node)->right);
+    default:
+        return false;
+    }
+}
+
+static bool isArithmeticOrComparison(TokenType operator)
+{
+    switch (operator)
+    {
+    case TOKEN_PLUS:
+    case TOKEN_MINUS:
+    case TOKEN_MULTIPLY:
+    case TOKEN_DIVIDE:
+    case TOKEN_EQUALS:
+    case TOKEN_NOT_EQUALS:
+    case TOKEN_GREATER:
+    case TOKEN_LESS:
+    case TOKEN_GREATER_EQ:
+    case TOKEN_LESS_EQ:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Report binary operations in loops that pair a double literal with a value
+// computed at run time; returns the number of warnings
+static int checkNode(AstNode *node, int loopDepth)
+{
+    if (node == NULL)
+        return 0;
+
+    int warnings = 0;
+    switch (node->type)
+    {
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        for (int i = 0; i < block->count; i++)
+        {
+            warnings += checkNode(block->statements[i], loopDepth);
+        }
+        break;
+    }
+    case AST_VAR_DECL:
+        warnings += checkNode(((AstVarDecl *)node)->initializer, loopDepth);
+        break;
+    case AST_IF:
+    {
+        AstIf *ifStmt = (AstIf *)node;
+        warnings += checkNode(ifStmt->condition, loopDepth);
+        warnings += checkNode(ifStmt->thenBranch, loopDepth);
+        warnings += checkNode(ifStmt->elseBranch, loopDepth);
+        break;
+    }
+    case AST_WHILE:
+        warnings += checkNode(((AstWhile *)node)->condition, loopDepth + 1);
+        warnings += checkNode(((AstWhile *)node)->body, loopDepth + 1);
+        break;
+    case AST_FOR:
+    {
+        AstFor *forStmt = (AstFor *)node;
+        warnings += checkNode(forStmt->initializer, loopDepth);
+        warnings += checkNode(forStmt->condition, loopDepth + 1);
+        warnings += checkNode(forStmt->increment, loopDepth + 1);
+        warnings += checkNode(forStmt->body, loopDepth + 1);
+        break;
+    }
+    case AST_RETURN:
+        warnings += checkNode(((AstReturn *)node)->value, loopDepth);
+        break;
+    case AST_EXPRESSION_STMT:
+        warnings += checkNode(((AstExpressionStmt *)node)->expression, loopDepth);
+        break;
+    case AST_BINARY:
+    {
+        AstBinary *binary = (AstBinary *)node;
+        if (loopDepth > 0 && isArithmeticOrComparison(binary->operator))
+        {
+            AstLiteral *literal = doubleLiteral(binary->left);
+            AstNode *other = binary->right;
+            if (literal == NULL)
+            {
+                literal = doubleLiteral(binary->right);
+                other = binary->left;
+            }
+            if (literal != NULL && !isCompileTimeValue(other))
+            {
+                Token value = literal->value;
+                fprintf(stderr,
+                        "Line %d, Column %d: Warning: Decimal literal '%.*s' makes this loop compute in "
+                        "double precision; write दशमलव(%.*s) or compile with -fsingle-precision.\n",
+                        value.line, value.column, value.length, value.start, value.length, value.start);
+                warnings++;
+            }
+        }
+        warnings += checkNode(binary->left, loopDepth);
+        warnings += checkNode(binary->right, loopDepth);
+        break;
+    }
+    case AST_UNARY:
+        warnings += checkNode(((AstUnary *)node)->right, loopDepth);
+        break;
+    case AST_ASSIGNMENT:
+        warnings += checkNode(((AstAssignment *)node)->index, loopDepth);
+        warnings += checkNode(((AstAssignment *)node)->value, loopDepth);
+        break;
+    case AST_INDEX:
+        warnings += checkNode(((AstIndex *)node)->index, loopDepth);
+        break;
+    case AST_SPAWN:
+        warnings += checkNode((AstNode *)((AstSpawn *)node)->call, loopDepth);
+        break;
+    case AST_YIELD:
+        warnings += checkNode(((AstYield *)node)->value, loopDepth);
+        break;
+    case AST_MEASURE:
+        warnings += checkNode(((AstMeasure *)node)->runs, loopDepth);
+        warnings += checkNode(((AstMeasure *)node)->body, loopDepth + 1);
+        break;
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)node;
+        for (int i = 0; i < call->argCount; i++)
+        {
+            warnings += checkNode(call->arguments[i], loopDepth);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return warnings;
+}
+
+// Warn about loops in functions that run (not cold ones) which mix decimal
+// literals with float values
+int checkLoopPrecision(CallGraph *graph)
+{
+    int warnings = 0;
+    for (int i = 0; i < graph->count; i++)
+    {
+        CallGraphNode *node = &graph->nodes[i];
+        if (node->temperature == TEMPERATURE_COLD)
+            continue;
+
+        warnings += checkNode(node->decl->body, 0);
+    }
+
+    return warnings;
+}
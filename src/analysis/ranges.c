@@ -0,0 +1,1237 @@
+/* src/analysis/ranges.c */
+#include "../../include/analysis.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Value ranges of पूर्णांक expressions. Each function body is walked once, in
+// order, keeping an interval [low, high] for every local variable. The two
+// branches of an अगर are walked from the same state, each narrowed by what
+// the condition says on that side, and joined afterwards. A loop is walked
+// until its ranges settle: a bound that a trip through the loop moves is
+// dropped, the others are kept, and the loop condition narrows them inside
+// and after the loop. The counter of a दौर loop that steps by a constant
+// towards a bound the loop does not change lies between its start and the
+// bound inside the loop.
+//
+// The results are left in the AST for code generation. An arithmetic
+// operation whose operand ranges show that it cannot overflow or divide by
+// zero is marked proven, and --checked-arith generates it without a check.
+// Division and remainder of operands known not to be negative are marked
+// so, and are generated in unsigned arithmetic, which needs no sign
+// correction. An अगर whose condition is decided by the ranges records the
+// outcome. Bounds are kept in 64 bits, so sums and products of two पूर्णांक
+// ranges never overflow here; an interval whose low end is above its high
+// end is empty, and stands for code that never runs.
+
+typedef struct
+{
+    long long low;
+    long long high;
+} Interval;
+
+typedef struct
+{
+    Token name;
+    Interval range;
+    bool spawned; // Assigned the result of a task, which lands at प्रतीक्षा
+} RangeEntry;
+
+typedef struct
+{
+    RangeEntry *entries; // Innermost declarations last
+    int count;
+    int capacity;
+    bool record; // Mark operations as proven while evaluating
+    FILE *dump;  // --dump-ranges output, or NULL
+} RangeState;
+
+static Interval fullRange(void)
+{
+    Interval range = {INT_MIN, INT_MAX};
+    return range;
+}
+
+static Interval exactRange(long long value)
+{
+    Interval range = {value, value};
+    return range;
+}
+
+static bool isEmpty(Interval range)
+{
+    return range.low > range.high;
+}
+
+static Interval joinRanges(Interval a, Interval b)
+{
+    if (isEmpty(a))
+        return b;
+    if (isEmpty(b))
+        return a;
+    Interval range = {a.low < b.low ? a.low : b.low, a.high > b.high ? a.high : b.high};
+    return range;
+}
+
+static Interval meetRanges(Interval a, Interval b)
+{
+    Interval range = {a.low > b.low ? a.low : b.low, a.high < b.high ? a.high : b.high};
+    return range;
+}
+
+static bool isExact(Interval range)
+{
+    return range.low == range.high;
+}
+
+static bool isFull(Interval range)
+{
+    return range.low <= INT_MIN && range.high >= INT_MAX;
+}
+
+static bool isIntegral(AstNode *node)
+{
+    return node->dataType == TOKEN_INT || node->dataType == TOKEN_CHAR;
+}
+
+static void dumpRange(RangeState *state, Interval range)
+{
+    if (isEmpty(range))
+        fprintf(state->dump, "never reached");
+    else if (isFull(range))
+        fprintf(state->dump, "unknown");
+    else
+        fprintf(state->dump, "[%lld, %lld]", range.low, range.high);
+}
+
+// --dump-ranges: the range a variable has from a line on
+static void dumpVariable(RangeState *state, int line, Token name, Interval range, const char *note)
+{
+    if (state->dump == NULL || !state->record)
+        return;
+    fprintf(state->dump, "  line %d: %.*s ", line, name.length, name.start);
+    dumpRange(state, range);
+    fprintf(state->dump, "%s\n", note);
+}
+
+static const char *operatorText(TokenType operator)
+{
+    switch (operator)
+    {
+    case TOKEN_PLUS:
+        return "+";
+    case TOKEN_MINUS:
+        return "-";
+    case TOKEN_MULTIPLY:
+        return "*";
+    case TOKEN_DIVIDE:
+        return "/";
+    default:
+        return "%";
+    }
+}
+
+static bool fitsInt(Interval range)
+{
+    return range.low >= INT_MIN && range.high <= INT_MAX;
+}
+
+static bool containsValue(Interval range, long long value)
+{
+    return range.low <= value && value <= range.high;
+}
+
+static long long magnitude(Interval range)
+{
+    long long low = range.low < 0 ? -range.low : range.low;
+    long long high = range.high < 0 ? -range.high : range.high;
+    return low > high ? low : high;
+}
+
+static bool sameName(Token a, Token b)
+{
+    return a.length == b.length && memcmp(a.start, b.start, a.length) == 0;
+}
+
+static bool isCallTo(AstCall *call, const char *name)
+{
+    size_t length = strlen(name);
+    return (size_t)call->name.length == length && memcmp(call->name.start, name, length) == 0;
+}
+
+static bool isReadCall(AstCall *call)
+{
+    return isCallTo(call, "पढ़ो");
+}
+
+// The innermost variable of that name, or NULL for globals and unknown names
+static RangeEntry *findEntry(RangeState *state, Token name)
+{
+    for (int i = state->count - 1; i >= 0; i--)
+    {
+        if (sameName(state->entries[i].name, name))
+            return &state->entries[i];
+    }
+    return NULL;
+}
+
+static void declareEntry(RangeState *state, Token name, Interval range)
+{
+    if (state->count == state->capacity)
+    {
+        state->capacity = state->capacity < 8 ? 8 : state->capacity * 2;
+        state->entries = (RangeEntry *)realloc(state->entries, sizeof(RangeEntry) * state->capacity);
+    }
+    RangeEntry *entry = &state->entries[state->count++];
+    entry->name = name;
+    entry->range = range;
+    entry->spawned = false;
+}
+
+// Number of places in a subtree that write the named variable: plain
+// assignments and पढ़ो arguments
+static int countWrites(AstNode *node, Token name)
+{
+    if (node == NULL)
+        return 0;
+
+    switch (node->type)
+    {
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        int writes = 0;
+        for (int i = 0; i < block->count; i++)
+        {
+            writes += countWrites(block->statements[i], name);
+        }
+        return writes;
+    }
+    case AST_VAR_DECL:
+    {
+        AstVarDecl *decl = (AstVarDecl *)node;
+        int writes = countWrites(decl->initializer, name);
+        for (int i = 0; i < decl->elementCount; i++)
+        {
+            writes += countWrites(decl->elements[i], name);
+        }
+        return writes;
+    }
+    case AST_IF:
+        return countWrites(((AstIf *)node)->condition, name) + countWrites(((AstIf *)node)->thenBranch, name) +
+               countWrites(((AstIf *)node)->elseBranch, name);
+    case AST_WHILE:
+        return countWrites(((AstWhile *)node)->condition, name) + countWrites(((AstWhile *)node)->body, name);
+    case AST_FOR:
+    {
+        AstFor *loop = (AstFor *)node;
+        return countWrites(loop->initializer, name) + countWrites(loop->condition, name) +
+               countWrites(loop->increment, name) + countWrites(loop->body, name);
+    }
+    case AST_RETURN:
+        return countWrites(((AstReturn *)node)->value, name);
+    case AST_EXPRESSION_STMT:
+        return countWrites(((AstExpressionStmt *)node)->expression, name);
+    case AST_YIELD:
+        return countWrites(((AstYield *)node)->value, name);
+    case AST_MEASURE:
+        return countWrites(((AstMeasure *)node)->runs, name) + countWrites(((AstMeasure *)node)->body, name);
+    case AST_BINARY:
+        return countWrites(((AstBinary *)node)->left, name) + countWrites(((AstBinary *)node)->right, name);
+    case AST_UNARY:
+        return countWrites(((AstUnary *)node)->right, name);
+    case AST_ASSIGNMENT:
+    {
+        AstAssignment *assignment = (AstAssignment *)node;
+        int writes = countWrites(assignment->index, name) + countWrites(assignment->value, name);
+        if (assignment->index == NULL && sameName(assignment->name, name))
+            writes++;
+        return writes;
+    }
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)node;
+        int writes = 0;
+        for (int i = 0; i < call->argCount; i++)
+        {
+            AstNode *argument = call->arguments[i];
+            writes += countWrites(argument, name);
+            if (isReadCall(call) && argument->type == AST_VARIABLE && sameName(((AstVariable *)argument)->name, name))
+                writes++;
+        }
+        return writes;
+    }
+    case AST_INDEX:
+        return countWrites(((AstIndex *)node)->index, name);
+    case AST_SPAWN:
+        return countWrites((AstNode *)((AstSpawn *)node)->call, name);
+    default:
+        return 0;
+    }
+}
+
+// Forget what is known about every variable a loop writes
+static void widenWrites(RangeState *state, AstNode *loop)
+{
+    for (int i = 0; i < state->count; i++)
+    {
+        if (countWrites(loop, state->entries[i].name) > 0)
+            state->entries[i].range = fullRange();
+    }
+}
+
+static Interval evaluateRange(RangeState *state, AstNode *node);
+
+static Interval literalRange(AstLiteral *node)
+{
+    if (node->value.type != TOKEN_NUMBER || node->base.dataType != TOKEN_INT || node->value.length >= 32)
+        return fullRange();
+
+    char digits[32];
+    memcpy(digits, node->value.start, node->value.length);
+    digits[node->value.length] = '\0';
+    long long value = strtoll(digits, NULL, 10);
+    return value <= INT_MAX ? exactRange(value) : fullRange();
+}
+
+static Interval variableRange(RangeState *state, AstVariable *node)
+{
+    // Only number and character constants fill in their value
+    if (node->constant != NULL &&
+        (node->constant->varType == TOKEN_INT || node->constant->varType == TOKEN_CHAR) &&
+        node->constant->value.known && !node->constant->value.isFloat)
+    {
+        return exactRange(node->constant->value.intValue);
+    }
+
+    if (node->base.dataType == TOKEN_CHAR)
+    {
+        // Signed or unsigned, whichever char is
+        Interval range = {SCHAR_MIN, UCHAR_MAX};
+        return range;
+    }
+
+    RangeEntry *entry = findEntry(state, node->name);
+    return entry != NULL && node->base.dataType == TOKEN_INT ? entry->range : fullRange();
+}
+
+static Interval unaryRange(RangeState *state, AstUnary *node)
+{
+    Interval operand = evaluateRange(state, node->right);
+
+    switch (node->operator)
+    {
+    case TOKEN_MINUS:
+    {
+        if (node->base.dataType != TOKEN_INT)
+            return fullRange();
+
+        Interval range = {-operand.high, -operand.low};
+        if (state->record)
+            node->proven = fitsInt(range);
+        if (state->dump != NULL && state->record && !isFull(operand))
+            fprintf(state->dump, "  line %d: negation %s\n", node->base.line,
+                    node->proven ? "cannot overflow" : "may overflow");
+        return fitsInt(range) ? range : fullRange();
+    }
+    case TOKEN_NOT:
+        if (isIntegral(node->right) && !containsValue(operand, 0))
+            return exactRange(0);
+        if (isIntegral(node->right) && operand.low == 0 && operand.high == 0)
+            return exactRange(1);
+        return (Interval){0, 1};
+    case TOKEN_INT:
+        return node->right->dataType == TOKEN_FLOAT ? fullRange() : operand;
+    case TOKEN_CHAR:
+        return (Interval){SCHAR_MIN, UCHAR_MAX};
+    default:
+        return fullRange();
+    }
+}
+
+// Value of a comparison or logical operator: 0 or 1, or just one of them
+// when the operand ranges decide it. Only integers are compared by range;
+// the ranges of decimals are not tracked.
+static Interval comparisonRange(AstBinary *node, Interval left, Interval right)
+{
+    Interval either = {0, 1};
+    if (node->operator== TOKEN_AND || node->operator== TOKEN_OR)
+    {
+        bool leftKnown = left.low == left.high, rightKnown = right.low == right.high;
+        if (node->operator== TOKEN_AND && ((leftKnown && left.low == 0) || (rightKnown && right.low == 0)))
+            return exactRange(0);
+        if (node->operator== TOKEN_OR && ((leftKnown && left.low != 0) || (rightKnown && right.low != 0)))
+            return exactRange(1);
+        if (leftKnown && rightKnown)
+            return exactRange(node->operator== TOKEN_AND ? 1 : 0);
+        return either;
+    }
+
+    if (!isIntegral(node->left) || !isIntegral(node->right) || isEmpty(left) || isEmpty(right))
+        return either;
+
+    switch (node->operator)
+    {
+    case TOKEN_LESS:
+        return left.high < right.low ? exactRange(1) : left.low >= right.high ? exactRange(0) : either;
+    case TOKEN_LESS_EQ:
+        return left.high <= right.low ? exactRange(1) : left.low > right.high ? exactRange(0) : either;
+    case TOKEN_GREATER:
+        return left.low > right.high ? exactRange(1) : left.high <= right.low ? exactRange(0) : either;
+    case TOKEN_GREATER_EQ:
+        return left.low >= right.high ? exactRange(1) : left.high < right.low ? exactRange(0) : either;
+    case TOKEN_EQUALS:
+    case TOKEN_NOT_EQUALS:
+    {
+        bool equal = left.low == left.high && right.low == right.high && left.low == right.low;
+        bool apart = left.high < right.low || right.high < left.low;
+        if (!equal && !apart)
+            return either;
+        return exactRange(equal == (node->operator== TOKEN_EQUALS));
+    }
+    default:
+        return either;
+    }
+}
+
+static RangeEntry *saveEntries(RangeState *state)
+{
+    RangeEntry *saved = (RangeEntry *)malloc(sizeof(RangeEntry) * (state->count > 0 ? state->count : 1));
+    memcpy(saved, state->entries, sizeof(RangeEntry) * state->count);
+    return saved;
+}
+
+// Join the first count entries with a saved state, for code that may or may
+// not have run
+static void joinEntries(RangeState *state, RangeEntry *saved, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        state->entries[i].range = joinRanges(state->entries[i].range, saved[i].range);
+        state->entries[i].spawned = state->entries[i].spawned || saved[i].spawned;
+    }
+}
+
+static Interval binaryRange(RangeState *state, AstBinary *node)
+{
+    Interval left = evaluateRange(state, node->left);
+    Interval right;
+    if (node->operator== TOKEN_AND || node->operator== TOKEN_OR)
+    {
+        // The right operand runs only when the left one does not decide
+        int count = state->count;
+        RangeEntry *skipped = saveEntries(state);
+        right = evaluateRange(state, node->right);
+        joinEntries(state, skipped, count);
+        free(skipped);
+        return comparisonRange(node, left, right);
+    }
+    right = evaluateRange(state, node->right);
+    if (isEmpty(left) || isEmpty(right))
+    {
+        // Code that never runs; any range is right for it
+        left = isEmpty(left) ? fullRange() : left;
+        right = isEmpty(right) ? fullRange() : right;
+    }
+
+    Interval range;
+    bool proven = true;
+    switch (node->operator)
+    {
+    case TOKEN_PLUS:
+        range = (Interval){left.low + right.low, left.high + right.high};
+        break;
+    case TOKEN_MINUS:
+        range = (Interval){left.low - right.high, left.high - right.low};
+        break;
+    case TOKEN_MULTIPLY:
+    {
+        long long corners[4] = {left.low * right.low, left.low * right.high, left.high * right.low,
+                                left.high * right.high};
+        range = exactRange(corners[0]);
+        for (int i = 1; i < 4; i++)
+        {
+            range = joinRanges(range, exactRange(corners[i]));
+        }
+        break;
+    }
+    case TOKEN_DIVIDE:
+    case TOKEN_MODULO:
+    {
+        // Division by zero and INT_MIN / -1 are the cases C leaves undefined
+        proven = !containsValue(right, 0) && !(left.low == INT_MIN && containsValue(right, -1));
+        // The C compiler folds the division of two known values itself
+        if (state->record)
+            node->nonNegative = node->base.dataType == TOKEN_INT && left.low >= 0 && right.low >= 1 &&
+                                !(isExact(left) && isExact(right));
+        long long largest = magnitude(left);
+        if (node->operator== TOKEN_DIVIDE && !containsValue(right, 0))
+        {
+            // Truncating division is monotonic in each operand when the
+            // divisor keeps its sign, so the extremes are at the corners
+            long long corners[4] = {left.low / right.low, left.low / right.high, left.high / right.low,
+                                    left.high / right.high};
+            range = exactRange(corners[0]);
+            for (int i = 1; i < 4; i++)
+            {
+                range = joinRanges(range, exactRange(corners[i]));
+            }
+        }
+        else if (node->operator== TOKEN_DIVIDE)
+        {
+            range = (Interval){-largest, largest};
+        }
+        else
+        {
+            // The remainder is smaller than the divisor and takes the dividend's sign
+            long long bound = magnitude(right) - 1;
+            if (bound > largest)
+                bound = largest;
+            range = (Interval){left.low >= 0 ? 0 : -bound, left.high <= 0 ? 0 : bound};
+        }
+        break;
+    }
+    default:
+        return comparisonRange(node, left, right);
+    }
+
+    if (node->base.dataType != TOKEN_INT)
+        return fullRange();
+
+    proven = proven && fitsInt(range);
+    if (state->record)
+        node->proven = proven;
+    if (state->dump != NULL && state->record && !(isFull(left) && isFull(right)))
+    {
+        fprintf(state->dump, "  line %d: %s ", node->base.line, operatorText(node->operator));
+        dumpRange(state, fitsInt(range) ? range : fullRange());
+        fprintf(state->dump, ", %s\n", proven ? "cannot overflow" : "may overflow or divide by zero");
+    }
+    return fitsInt(range) ? range : fullRange();
+}
+
+// Calls return whatever the function computes, except for the builtins
+// that count or search
+static Interval callRange(RangeState *state, AstCall *node)
+{
+    Interval first = fullRange();
+    for (int i = 0; i < node->argCount; i++)
+    {
+        AstNode *argument = node->arguments[i];
+        Interval range = evaluateRange(state, argument);
+        if (i == 0)
+            first = range;
+        if (isReadCall(node) && argument->type == AST_VARIABLE)
+        {
+            RangeEntry *entry = findEntry(state, ((AstVariable *)argument)->name);
+            if (entry != NULL)
+                entry->range = fullRange();
+        }
+    }
+
+    if (isCallTo(node, "आकार") || isCallTo(node, "लंबाई") || isCallTo(node, "अक्षर_गिनती"))
+        return (Interval){0, INT_MAX};
+    if (isCallTo(node, "खोज"))
+        return (Interval){-1, INT_MAX};
+    if (isCallTo(node, "यादृच्छिक") && node->base.dataType == TOKEN_INT && !isEmpty(first))
+        return (Interval){0, first.high > 1 ? first.high - 1 : 0};
+    return fullRange();
+}
+
+// Range of an expression's value, applying the assignments in it
+static Interval evaluateRange(RangeState *state, AstNode *node)
+{
+    if (node == NULL)
+        return fullRange();
+
+    switch (node->type)
+    {
+    case AST_LITERAL:
+        return literalRange((AstLiteral *)node);
+    case AST_VARIABLE:
+        return variableRange(state, (AstVariable *)node);
+    case AST_UNARY:
+        return unaryRange(state, (AstUnary *)node);
+    case AST_BINARY:
+        return binaryRange(state, (AstBinary *)node);
+    case AST_ASSIGNMENT:
+    {
+        AstAssignment *assignment = (AstAssignment *)node;
+        evaluateRange(state, assignment->index);
+        Interval value = evaluateRange(state, assignment->value);
+        RangeEntry *entry = assignment->index == NULL ? findEntry(state, assignment->name) : NULL;
+        if (entry != NULL)
+        {
+            entry->range = value;
+            if (assignment->value->type == AST_SPAWN)
+            {
+                entry->range = fullRange();
+                entry->spawned = true;
+            }
+            if (assignment->base.dataType == TOKEN_INT)
+                dumpVariable(state, node->line, assignment->name, entry->range, "");
+        }
+        return value;
+    }
+    case AST_CALL:
+        return callRange(state, (AstCall *)node);
+    case AST_INDEX:
+        evaluateRange(state, ((AstIndex *)node)->index);
+        return fullRange();
+    case AST_SPAWN:
+        evaluateRange(state, (AstNode *)((AstSpawn *)node)->call);
+        return fullRange();
+    default:
+        return fullRange();
+    }
+}
+
+// Range of an expression without marking anything; for expressions without
+// side effects only
+static Interval peekRange(RangeState *state, AstNode *node)
+{
+    bool record = state->record;
+    state->record = false;
+    Interval range = evaluateRange(state, node);
+    state->record = record;
+    return range;
+}
+
+// Check that an expression has no side effects and that the local variables
+// it reads keep their ranges while the loop runs
+static bool isLoopInvariant(RangeState *state, AstNode *node, AstNode *loop)
+{
+    if (node == NULL)
+        return false;
+
+    switch (node->type)
+    {
+    case AST_LITERAL:
+        return true;
+    case AST_VARIABLE:
+    {
+        AstVariable *variable = (AstVariable *)node;
+        return variable->constant != NULL || findEntry(state, variable->name) == NULL ||
+               countWrites(loop, variable->name) == 0;
+    }
+    case AST_UNARY:
+        return isLoopInvariant(state, ((AstUnary *)node)->right, loop);
+    case AST_BINARY:
+        return isLoopInvariant(state, ((AstBinary *)node)->left, loop) &&
+               isLoopInvariant(state, ((AstBinary *)node)->right, loop);
+    default:
+        return false;
+    }
+}
+
+// Check that evaluating an expression changes nothing, so it can be evaluated
+// again, or not at all
+static bool isPure(AstNode *node)
+{
+    if (node == NULL)
+        return true;
+
+    switch (node->type)
+    {
+    case AST_LITERAL:
+    case AST_VARIABLE:
+        return true;
+    case AST_UNARY:
+        return isPure(((AstUnary *)node)->right);
+    case AST_BINARY:
+        return isPure(((AstBinary *)node)->left) && isPure(((AstBinary *)node)->right);
+    case AST_INDEX:
+        return isPure(((AstIndex *)node)->index);
+    default:
+        return false;
+    }
+}
+
+// Check that an expression evaluated with recording on can be left out of
+// the program: it changes nothing, and none of its arithmetic can overflow or
+// divide by zero, which --checked-arith would report
+static bool isRemovable(AstNode *node)
+{
+    if (node == NULL)
+        return true;
+
+    switch (node->type)
+    {
+    case AST_LITERAL:
+    case AST_VARIABLE:
+        return true;
+    case AST_UNARY:
+    {
+        AstUnary *unary = (AstUnary *)node;
+        bool safe = unary->operator!= TOKEN_MINUS || unary->base.dataType != TOKEN_INT || unary->proven;
+        return safe && isRemovable(unary->right);
+    }
+    case AST_BINARY:
+    {
+        AstBinary *binary = (AstBinary *)node;
+        bool arithmetic = binary->operator== TOKEN_PLUS || binary->operator== TOKEN_MINUS ||
+                          binary->operator== TOKEN_MULTIPLY || binary->operator== TOKEN_DIVIDE ||
+                          binary->operator== TOKEN_MODULO;
+        bool safe = !arithmetic || binary->base.dataType != TOKEN_INT || binary->proven;
+        return safe && isRemovable(binary->left) && isRemovable(binary->right);
+    }
+    default:
+        return false;
+    }
+}
+
+// The comparison that holds when this one does not
+static TokenType negateComparison(TokenType operator)
+{
+    switch (operator)
+    {
+    case TOKEN_LESS:
+        return TOKEN_GREATER_EQ;
+    case TOKEN_LESS_EQ:
+        return TOKEN_GREATER;
+    case TOKEN_GREATER:
+        return TOKEN_LESS_EQ;
+    case TOKEN_GREATER_EQ:
+        return TOKEN_LESS;
+    case TOKEN_EQUALS:
+        return TOKEN_NOT_EQUALS;
+    default:
+        return TOKEN_EQUALS;
+    }
+}
+
+// The same comparison with its operands swapped
+static TokenType swapComparison(TokenType operator)
+{
+    switch (operator)
+    {
+    case TOKEN_LESS:
+        return TOKEN_GREATER;
+    case TOKEN_LESS_EQ:
+        return TOKEN_GREATER_EQ;
+    case TOKEN_GREATER:
+        return TOKEN_LESS;
+    case TOKEN_GREATER_EQ:
+        return TOKEN_LESS_EQ;
+    default:
+        return operator;
+    }
+}
+
+static bool isComparison(TokenType operator)
+{
+    switch (operator)
+    {
+    case TOKEN_LESS:
+    case TOKEN_LESS_EQ:
+    case TOKEN_GREATER:
+    case TOKEN_GREATER_EQ:
+    case TOKEN_EQUALS:
+    case TOKEN_NOT_EQUALS:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// The tracked पूर्णांक variable an expression is, or NULL
+static RangeEntry *trackedVariable(RangeState *state, AstNode *node)
+{
+    if (node->type != AST_VARIABLE || node->dataType != TOKEN_INT || ((AstVariable *)node)->constant != NULL)
+        return NULL;
+    RangeEntry *entry = findEntry(state, ((AstVariable *)node)->name);
+    return entry != NULL && !entry->spawned ? entry : NULL;
+}
+
+// Narrow a variable to the values for which "variable operator other" holds
+static void narrowVariable(RangeEntry *entry, TokenType operator, Interval other)
+{
+    Interval *range = &entry->range;
+    switch (operator)
+    {
+    case TOKEN_LESS:
+        *range = meetRanges(*range, (Interval){INT_MIN, other.high - 1});
+        break;
+    case TOKEN_LESS_EQ:
+        *range = meetRanges(*range, (Interval){INT_MIN, other.high});
+        break;
+    case TOKEN_GREATER:
+        *range = meetRanges(*range, (Interval){other.low + 1, INT_MAX});
+        break;
+    case TOKEN_GREATER_EQ:
+        *range = meetRanges(*range, (Interval){other.low, INT_MAX});
+        break;
+    case TOKEN_EQUALS:
+        *range = meetRanges(*range, other);
+        break;
+    default:
+        // Only a value at either end can be cut off
+        if (other.low == other.high && range->low == other.low)
+            range->low++;
+        if (other.low == other.high && range->high == other.low)
+            range->high--;
+        break;
+    }
+}
+
+// Narrow the variables a condition compares to what they are when it holds,
+// or when it does not. The condition has been evaluated already.
+static void refineCondition(RangeState *state, AstNode *condition, bool holds)
+{
+    if (condition == NULL)
+        return;
+
+    if (condition->type == AST_UNARY && ((AstUnary *)condition)->operator== TOKEN_NOT)
+    {
+        refineCondition(state, ((AstUnary *)condition)->right, !holds);
+        return;
+    }
+
+    RangeEntry *entry = trackedVariable(state, condition);
+    if (entry != NULL)
+    {
+        narrowVariable(entry, holds ? TOKEN_NOT_EQUALS : TOKEN_EQUALS, exactRange(0));
+        return;
+    }
+
+    if (condition->type != AST_BINARY)
+        return;
+    AstBinary *binary = (AstBinary *)condition;
+
+    // Both sides of && hold when it does, neither side of || when it does not
+    if ((binary->operator== TOKEN_AND && holds) || (binary->operator== TOKEN_OR && !holds))
+    {
+        refineCondition(state, binary->left, holds);
+        refineCondition(state, binary->right, holds);
+        return;
+    }
+
+    if (!isComparison(binary->operator) || !isIntegral(binary->left) || !isIntegral(binary->right) ||
+        !isPure(binary->left) || !isPure(binary->right))
+        return;
+
+    TokenType operator= holds ? binary->operator: negateComparison(binary->operator);
+    Interval left = peekRange(state, binary->left);
+    Interval right = peekRange(state, binary->right);
+    RangeEntry *leftEntry = trackedVariable(state, binary->left);
+    RangeEntry *rightEntry = trackedVariable(state, binary->right);
+    if (leftEntry != NULL)
+        narrowVariable(leftEntry, operator, right);
+    if (rightEntry != NULL)
+        narrowVariable(rightEntry, swapComparison(operator), left);
+}
+
+// Check whether a statement always leaves the function, so the code after
+// it never sees its state
+static bool alwaysReturns(AstNode *node)
+{
+    if (node == NULL)
+        return false;
+
+    switch (node->type)
+    {
+    case AST_RETURN:
+        return true;
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        return block->count > 0 && alwaysReturns(block->statements[block->count - 1]);
+    }
+    case AST_IF:
+        return alwaysReturns(((AstIf *)node)->thenBranch) && alwaysReturns(((AstIf *)node)->elseBranch);
+    default:
+        return false;
+    }
+}
+
+// A दौर loop counter: the only write to it is the increment, which adds a
+// positive constant (or subtracts one), and the condition compares it with a
+// loop-invariant bound in the direction it moves
+typedef struct
+{
+    RangeEntry *entry;
+    Interval inside; // While the body and the increment run
+    Interval after;  // When the condition is tested, and after the loop
+} LoopCounter;
+
+static bool findLoopCounter(RangeState *state, AstFor *loop, LoopCounter *counter)
+{
+    if (loop->condition == NULL || loop->condition->type != AST_BINARY || loop->increment == NULL ||
+        loop->increment->type != AST_ASSIGNMENT)
+        return false;
+
+    AstAssignment *increment = (AstAssignment *)loop->increment;
+    RangeEntry *entry = findEntry(state, increment->name);
+    if (increment->index != NULL || entry == NULL || entry->spawned || increment->base.dataType != TOKEN_INT ||
+        countWrites((AstNode *)loop, increment->name) != 1 + countWrites(loop->initializer, increment->name))
+        return false;
+
+    // i = i + step, i = step + i or i = i - step
+    if (increment->value->type != AST_BINARY)
+        return false;
+    AstBinary *next = (AstBinary *)increment->value;
+    AstNode *step;
+    if (next->left->type == AST_VARIABLE && sameName(((AstVariable *)next->left)->name, increment->name))
+    {
+        step = next->right;
+    }
+    else if (next->operator== TOKEN_PLUS && next->right->type == AST_VARIABLE &&
+             sameName(((AstVariable *)next->right)->name, increment->name))
+    {
+        step = next->left;
+    }
+    else
+    {
+        return false;
+    }
+    if ((next->operator!= TOKEN_PLUS && next->operator!= TOKEN_MINUS) ||
+        !isLoopInvariant(state, step, (AstNode *)loop))
+        return false;
+    Interval stepRange = peekRange(state, step);
+    if (stepRange.low < 1)
+        return false;
+    bool rising = next->operator== TOKEN_PLUS;
+
+    // i < bound, i <= bound, bound > i, ... with the counter on either side
+    AstBinary *test = (AstBinary *)loop->condition;
+    TokenType operator= test->operator;
+    AstNode *bound;
+    if (test->left->type == AST_VARIABLE && sameName(((AstVariable *)test->left)->name, increment->name))
+    {
+        bound = test->right;
+    }
+    else if (test->right->type == AST_VARIABLE && sameName(((AstVariable *)test->right)->name, increment->name))
+    {
+        bound = test->left;
+        switch (operator)
+        {
+        case TOKEN_LESS:
+            operator= TOKEN_GREATER;
+            break;
+        case TOKEN_LESS_EQ:
+            operator= TOKEN_GREATER_EQ;
+            break;
+        case TOKEN_GREATER:
+            operator= TOKEN_LESS;
+            break;
+        case TOKEN_GREATER_EQ:
+            operator= TOKEN_LESS_EQ;
+            break;
+        default:
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+    if (bound->dataType != TOKEN_INT || !isLoopInvariant(state, bound, (AstNode *)loop))
+        return false;
+    Interval limit = peekRange(state, bound);
+
+    Interval start = entry->range;
+    if (rising && (operator== TOKEN_LESS || operator== TOKEN_LESS_EQ))
+    {
+        long long last = operator== TOKEN_LESS ? limit.high - 1 : limit.high;
+        long long past = last + stepRange.high;
+        counter->inside = (Interval){start.low, last};
+        counter->after = (Interval){start.low, start.high > past ? start.high : past};
+    }
+    else if (!rising && (operator== TOKEN_GREATER || operator== TOKEN_GREATER_EQ))
+    {
+        long long last = operator== TOKEN_GREATER ? limit.low + 1 : limit.low;
+        long long past = last - stepRange.high;
+        counter->inside = (Interval){last, start.high};
+        counter->after = (Interval){start.low < past ? start.low : past, start.high};
+    }
+    else
+    {
+        return false;
+    }
+
+    // Past the end of int the increment traps, so the counter never gets there
+    if (counter->after.low < INT_MIN)
+        counter->after.low = INT_MIN;
+    if (counter->after.high > INT_MAX)
+        counter->after.high = INT_MAX;
+    counter->entry = entry;
+    return true;
+}
+
+static void analyzeStatement(RangeState *state, AstNode *node);
+
+// Find the ranges variables have at the head of a loop, whichever trip it is
+// on. The loop is walked without recording anything, and each bound that a
+// trip moves is pushed out to the end of int, until a trip moves none. The
+// ranges of a दौर counter are known already and left alone.
+static void widenLoop(RangeState *state, AstNode *loop, AstNode *condition, AstNode *body, AstNode *increment,
+                      LoopCounter *counter)
+{
+    bool record = state->record;
+    state->record = false;
+    int count = state->count;
+    int index = counter != NULL ? (int)(counter->entry - state->entries) : -1;
+
+    // Each range can change three times: from empty, and once at either end
+    bool changed = true;
+    for (int trip = 0; changed && trip <= 3 * count; trip++)
+    {
+        RangeEntry *head = saveEntries(state);
+        evaluateRange(state, condition);
+        if (counter != NULL)
+            state->entries[index].range = counter->inside;
+        refineCondition(state, condition, true);
+        analyzeStatement(state, body);
+        evaluateRange(state, increment);
+        state->count = count;
+
+        changed = false;
+        for (int i = 0; i < count; i++)
+        {
+            Interval range = head[i].range;
+            Interval next = state->entries[i].range;
+            if (i == index || isEmpty(next))
+            {
+                // Nothing new reaches the head
+            }
+            else if (isEmpty(range))
+            {
+                range = next;
+                changed = true;
+            }
+            else
+            {
+                if (next.low < range.low)
+                {
+                    range.low = INT_MIN;
+                    changed = true;
+                }
+                if (next.high > range.high)
+                {
+                    range.high = INT_MAX;
+                    changed = true;
+                }
+            }
+            state->entries[i].range = range;
+            state->entries[i].spawned = state->entries[i].spawned || head[i].spawned;
+        }
+        free(head);
+    }
+
+    if (changed)
+        widenWrites(state, loop);
+    state->record = record;
+}
+
+// Leave a loop: the variables have the ranges they had when the condition
+// was tested at the head
+static void leaveLoop(RangeState *state, RangeEntry *head, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        state->entries[i].range = head[i].range;
+        state->entries[i].spawned = state->entries[i].spawned || head[i].spawned;
+    }
+}
+
+static void analyzeFor(RangeState *state, AstFor *loop)
+{
+    int scope = state->count;
+    analyzeStatement(state, loop->initializer);
+
+    LoopCounter counter;
+    bool counted = findLoopCounter(state, loop, &counter);
+    int index = counted ? (int)(counter.entry - state->entries) : -1;
+
+    if (counted)
+        state->entries[index].range = counter.after;
+    widenLoop(state, (AstNode *)loop, loop->condition, loop->body, loop->increment, counted ? &counter : NULL);
+    evaluateRange(state, loop->condition);
+
+    int count = state->count;
+    RangeEntry *head = saveEntries(state);
+    if (counted)
+    {
+        state->entries[index].range = counter.inside;
+        dumpVariable(state, loop->base.line, counter.entry->name, counter.inside, " inside the loop");
+    }
+    refineCondition(state, loop->condition, true);
+    analyzeStatement(state, loop->body);
+    evaluateRange(state, loop->increment);
+
+    leaveLoop(state, head, count);
+    free(head);
+    refineCondition(state, loop->condition, false);
+    state->count = scope;
+}
+
+static void analyzeWhile(RangeState *state, AstWhile *loop)
+{
+    widenLoop(state, (AstNode *)loop, loop->condition, loop->body, NULL, NULL);
+    evaluateRange(state, loop->condition);
+
+    int count = state->count;
+    RangeEntry *head = saveEntries(state);
+    refineCondition(state, loop->condition, true);
+    analyzeStatement(state, loop->body);
+
+    leaveLoop(state, head, count);
+    free(head);
+    refineCondition(state, loop->condition, false);
+}
+
+static void analyzeIf(RangeState *state, AstIf *node)
+{
+    Interval condition = evaluateRange(state, node->condition);
+    if (state->record && isRemovable(node->condition) && condition.low == condition.high &&
+        (condition.low == 0 || condition.low == 1))
+    {
+        node->outcome = (int)condition.low;
+        if (state->dump != NULL)
+            fprintf(state->dump, "  line %d: condition %s\n", node->base.line,
+                    node->outcome ? "always true" : "never true");
+    }
+
+    int scope = state->count;
+    RangeEntry *before = saveEntries(state);
+
+    // Ranges in a branch that never runs are not worth showing
+    FILE *dump = state->dump;
+    state->dump = node->outcome == 0 ? NULL : dump;
+    refineCondition(state, node->condition, true);
+    analyzeStatement(state, node->thenBranch);
+    state->count = scope;
+    bool thenLeaves = alwaysReturns(node->thenBranch) || node->outcome == 0;
+    RangeEntry *taken = saveEntries(state);
+
+    memcpy(state->entries, before, sizeof(RangeEntry) * scope);
+    state->dump = node->outcome == 1 ? NULL : dump;
+    refineCondition(state, node->condition, false);
+    analyzeStatement(state, node->elseBranch);
+    state->count = scope;
+    state->dump = dump;
+
+    // A branch that returns, or never runs, does not reach the code after the
+    // अगर
+    if (alwaysReturns(node->elseBranch) || node->outcome == 1)
+        memcpy(state->entries, taken, sizeof(RangeEntry) * scope);
+    else if (!thenLeaves)
+        joinEntries(state, taken, scope);
+
+    free(before);
+    free(taken);
+}
+
+static void analyzeStatement(RangeState *state, AstNode *node)
+{
+    if (node == NULL)
+        return;
+
+    switch (node->type)
+    {
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        int scope = state->count;
+        for (int i = 0; i < block->count; i++)
+        {
+            analyzeStatement(state, block->statements[i]);
+        }
+        state->count = scope;
+        break;
+    }
+    case AST_VAR_DECL:
+    {
+        AstVarDecl *decl = (AstVarDecl *)node;
+        for (int i = 0; i < decl->elementCount; i++)
+        {
+            evaluateRange(state, decl->elements[i]);
+        }
+
+        // Uninitialized locals hold whatever was in memory
+        Interval value = evaluateRange(state, decl->initializer);
+        bool known = decl->varType == TOKEN_INT && decl->initializer != NULL;
+        declareEntry(state, decl->name, known ? value : fullRange());
+        if (decl->initializer != NULL && decl->initializer->type == AST_SPAWN)
+        {
+            state->entries[state->count - 1].range = fullRange();
+            state->entries[state->count - 1].spawned = true;
+        }
+        if (decl->varType == TOKEN_INT && !decl->constant)
+            dumpVariable(state, node->line, decl->name, state->entries[state->count - 1].range, "");
+        break;
+    }
+    case AST_IF:
+        analyzeIf(state, (AstIf *)node);
+        break;
+    case AST_WHILE:
+        analyzeWhile(state, (AstWhile *)node);
+        break;
+    case AST_FOR:
+        analyzeFor(state, (AstFor *)node);
+        break;
+    case AST_MEASURE:
+        evaluateRange(state, ((AstMeasure *)node)->runs);
+        widenWrites(state, node);
+        analyzeStatement(state, ((AstMeasure *)node)->body);
+        widenWrites(state, node);
+        break;
+    case AST_SYNC:
+        // Results of the function's tasks are written now
+        for (int i = 0; i < state->count; i++)
+        {
+            if (state->entries[i].spawned)
+                state->entries[i].range = fullRange();
+        }
+        break;
+    case AST_RETURN:
+        evaluateRange(state, ((AstReturn *)node)->value);
+        break;
+    case AST_EXPRESSION_STMT:
+        evaluateRange(state, ((AstExpressionStmt *)node)->expression);
+        break;
+    case AST_YIELD:
+        evaluateRange(state, ((AstYield *)node)->value);
+        break;
+    default:
+        break;
+    }
+}
+
+// Work out value ranges in every function and record what they prove for code
+// generation; with dump set, also write them there
+void analyzeRanges(AstProgram *program, FILE *dump)
+{
+    RangeState state = {NULL, 0, 0, true, dump};
+
+    for (int i = 0; i < program->count; i++)
+    {
+        AstNode *declaration = program->declarations[i];
+        state.count = 0;
+        if (declaration->type == AST_VAR_DECL)
+        {
+            // Globals can change in any function, so they are never tracked;
+            // their initializers are constant
+            AstVarDecl *global = (AstVarDecl *)declaration;
+            evaluateRange(&state, global->initializer);
+            for (int j = 0; j < global->elementCount; j++)
+            {
+                evaluateRange(&state, global->elements[j]);
+            }
+        }
+        else if (declaration->type == AST_FUNCTION_DECL)
+        {
+            AstFunctionDecl *function = (AstFunctionDecl *)declaration;
+            if (dump != NULL)
+                fprintf(dump, "%.*s:\n", function->name.length, function->name.start);
+            for (int j = 0; j < function->paramCount; j++)
+            {
+                declareEntry(&state, function->params[j].name, fullRange());
+            }
+            analyzeStatement(&state, function->body);
+        }
+    }
+
+    free(state.entries);
+}
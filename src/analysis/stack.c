@@ -0,0 +1,336 @@
+/* src/analysis/stack.c */
+#include "../../include/analysis.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Worst-case stack use. A function's frame is estimated from the C the code
+// generator emits for it: every parameter and every local of every nested
+// block gets its own slot, as if no two scopes shared stack, and so does each
+// task record, benchmark, region handle and computed string. The return
+// address and saved frame pointer are added and the total is rounded up to
+// the 16 bytes frames are aligned to. Sizes are those of a 64-bit target.
+// Spills and other temporaries the C compiler adds, and the stack of runtime
+// and C library functions, are not counted.
+//
+// The deepest path from a function is its frame plus the deepest path from
+// any function it calls. Components of the call graph are numbered
+// callees-first, so walking them in order finishes every callee before its
+// callers. Paths through a recursive component have no bound.
+
+// Return address and saved frame pointer
+#define FRAME_LINKAGE 16
+#define FRAME_ALIGN 16
+
+// sizeof(hc_task) plus the result pointer of a task record
+#define TASK_RECORD 32
+// sizeof(hc_task_frame)
+#define TASK_FRAME 16
+// sizeof(hc_bench)
+#define BENCH_RECORD 48
+// Coroutine frames nested deeper than this are not followed
+#define COROUTINE_NESTING 8
+
+static int coroutineSize(AstFunctionDecl *coroutine, int nesting);
+
+// Bytes of a C variable of the given type
+static int typeSize(TokenType type, AstFunctionDecl *coroutine, int nesting)
+{
+    switch (type)
+    {
+    case TOKEN_CHAR:
+        return 1;
+    case TOKEN_INT:
+    case TOKEN_FLOAT:
+    case TOKEN_ATOMIC:
+        return 4;
+    case TOKEN_TEXT:
+        return 32; // hc_str: 24 inline bytes, length and kind
+    case TOKEN_LIST:
+        return 32; // hc_list_*: data, length, capacity, arena
+    case TOKEN_MAP:
+        return 56; // hc_map_*: control bytes, keys, values, three counts, arena
+    case TOKEN_CHANNEL:
+        return 256; // hc_chan_*: a cache line each for senders, receivers, sleepers and the ring
+    case TOKEN_FILE:
+        return 64; // hc_file: data, size and the line and field cursors
+    case TOKEN_COROUTINE:
+        return coroutineSize(coroutine, nesting);
+    default:
+        return 8;
+    }
+}
+
+// Bytes of a coroutine's frame, which its सहक्रम variable holds: the resume
+// point, the value yielded last and the variables kept across रोको_और_दो
+static int coroutineSize(AstFunctionDecl *coroutine, int nesting)
+{
+    if (coroutine == NULL || nesting >= COROUTINE_NESTING)
+        return 8;
+
+    int size = 4 + typeSize(coroutine->returnType, NULL, nesting + 1);
+    for (int i = 0; i < coroutine->slotCount; i++)
+    {
+        AstFrameSlot *slot = &coroutine->slots[i];
+        if (slot->kept)
+            size += typeSize(slot->type, slot->coroutine, nesting + 1);
+    }
+    return size;
+}
+
+// Bytes of the variables, records and temporaries a subtree keeps on the
+// stack. Every string an expression computes is an hc_str temporary.
+static int localBytes(AstNode *node)
+{
+    if (node == NULL)
+        return 0;
+
+    int temporary = node->dataType == TOKEN_TEXT && node->type != AST_VARIABLE ? typeSize(TOKEN_TEXT, NULL, 0) : 0;
+    switch (node->type)
+    {
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        int bytes = block->region ? 8 : 0; // hc_arena pointer
+        for (int i = 0; i < block->count; i++)
+        {
+            bytes += localBytes(block->statements[i]);
+        }
+        return bytes;
+    }
+    case AST_VAR_DECL:
+    {
+        // Constants are folded or kept in read-only data
+        AstVarDecl *decl = (AstVarDecl *)node;
+        int bytes = localBytes(decl->initializer);
+        if (!decl->constant)
+        {
+            AstFunctionDecl *coroutine = NULL;
+            if (decl->varType == TOKEN_COROUTINE && decl->initializer != NULL &&
+                decl->initializer->type == AST_CALL)
+                coroutine = ((AstCall *)decl->initializer)->coroutine;
+            bytes += typeSize(decl->varType, coroutine, 0);
+        }
+        return bytes;
+    }
+    case AST_IF:
+        return localBytes(((AstIf *)node)->condition) + localBytes(((AstIf *)node)->thenBranch) +
+               localBytes(((AstIf *)node)->elseBranch);
+    case AST_WHILE:
+        return localBytes(((AstWhile *)node)->condition) + localBytes(((AstWhile *)node)->body);
+    case AST_FOR:
+    {
+        AstFor *loop = (AstFor *)node;
+        return localBytes(loop->initializer) + localBytes(loop->condition) + localBytes(loop->increment) +
+               localBytes(loop->body);
+    }
+    case AST_RETURN:
+        return localBytes(((AstReturn *)node)->value);
+    case AST_EXPRESSION_STMT:
+        return localBytes(((AstExpressionStmt *)node)->expression);
+    case AST_YIELD:
+        return localBytes(((AstYield *)node)->value);
+    case AST_MEASURE:
+        return BENCH_RECORD + localBytes(((AstMeasure *)node)->runs) + localBytes(((AstMeasure *)node)->body);
+    case AST_BINARY:
+        return temporary + localBytes(((AstBinary *)node)->left) + localBytes(((AstBinary *)node)->right);
+    case AST_UNARY:
+        return temporary + localBytes(((AstUnary *)node)->right);
+    case AST_ASSIGNMENT:
+        return temporary + localBytes(((AstAssignment *)node)->index) + localBytes(((AstAssignment *)node)->value);
+    case AST_INDEX:
+        return temporary + localBytes(((AstIndex *)node)->index);
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)node;
+        int bytes = temporary;
+        for (int i = 0; i < call->argCount; i++)
+        {
+            bytes += localBytes(call->arguments[i]);
+        }
+        return bytes;
+    }
+    case AST_SPAWN:
+    {
+        // Spawns in the function's own block keep their record on its stack
+        AstSpawn *spawn = (AstSpawn *)node;
+        int bytes = localBytes((AstNode *)spawn->call);
+        if (!spawn->heapTask)
+        {
+            bytes += TASK_RECORD;
+            for (int i = 0; i < spawn->call->argCount; i++)
+            {
+                bytes += typeSize(spawn->call->arguments[i]->dataType, NULL, 0);
+            }
+        }
+        return bytes;
+    }
+    default:
+        return temporary; // Literals and variables
+    }
+}
+
+// Estimated bytes of a function's own stack frame
+int estimateFrameSize(AstFunctionDecl *decl)
+{
+    int bytes = FRAME_LINKAGE + localBytes(decl->body);
+    for (int i = 0; i < decl->paramCount; i++)
+    {
+        bytes += typeSize(decl->params[i].type, NULL, 0);
+    }
+    if (decl->spawns)
+        bytes += TASK_FRAME;
+
+    return (bytes + FRAME_ALIGN - 1) / FRAME_ALIGN * FRAME_ALIGN;
+}
+
+// Work out every function's frame and deepest call path
+void analyzeStackUsage(CallGraph *graph, StackUsage *usage)
+{
+    for (int i = 0; i < graph->count; i++)
+    {
+        usage[i].frame = estimateFrameSize(graph->nodes[i].decl);
+        usage[i].depth = usage[i].frame;
+        usage[i].unbounded = graph->nodes[i].recursive;
+        usage[i].next = -1;
+    }
+
+    for (int scc = 0; scc < graph->sccCount; scc++)
+    {
+        for (int i = 0; i < graph->count; i++)
+        {
+            CallGraphNode *node = &graph->nodes[i];
+            if (node->scc != scc)
+                continue;
+
+            for (int j = 0; j < node->calleeCount; j++)
+            {
+                int callee = node->callees[j].callee;
+                if (graph->nodes[callee].scc == scc)
+                    continue; // A call within the component; it recurses
+
+                if (usage[callee].unbounded)
+                {
+                    // Follow the path towards the recursion
+                    if (!usage[i].unbounded)
+                        usage[i].next = callee;
+                    usage[i].unbounded = true;
+                }
+                else if (!usage[i].unbounded && usage[i].frame + usage[callee].depth > usage[i].depth)
+                {
+                    usage[i].depth = usage[i].frame + usage[callee].depth;
+                    usage[i].next = callee;
+                }
+            }
+        }
+    }
+}
+
+static void printName(FILE *output, AstFunctionDecl *decl)
+{
+    fprintf(output, "%.*s", decl->name.length, decl->name.start);
+}
+
+// Write the deepest path from a function as "a -> b -> c"; a path that
+// recurses stops at the first recursive function
+static void printPath(CallGraph *graph, StackUsage *usage, int index, FILE *output)
+{
+    printName(output, graph->nodes[index].decl);
+    while (!graph->nodes[index].recursive && usage[index].next >= 0)
+    {
+        index = usage[index].next;
+        fprintf(output, " -> ");
+        printName(output, graph->nodes[index].decl);
+    }
+}
+
+// The recursive function a path from index runs into
+static int recursionOnPath(CallGraph *graph, StackUsage *usage, int index)
+{
+    while (!graph->nodes[index].recursive && usage[index].next >= 0)
+    {
+        index = usage[index].next;
+    }
+    return index;
+}
+
+// मुख्य and the functions run as tasks start a stack of their own
+static bool isStackRoot(CallGraph *graph, int index)
+{
+    return index == graph->entry || graph->nodes[index].decl->spawned;
+}
+
+static void reportRoot(CallGraph *graph, StackUsage *usage, int index, FILE *output)
+{
+    printName(output, graph->nodes[index].decl);
+    fprintf(output, index == graph->entry ? ": " : " (कार्य, on a worker thread): ");
+    if (usage[index].unbounded)
+    {
+        fprintf(output, "unbounded, recursion in ");
+        printName(output, graph->nodes[recursionOnPath(graph, usage, index)].decl);
+    }
+    else
+    {
+        fprintf(output, "%ld bytes", usage[index].depth);
+    }
+    fprintf(output, "\n  ");
+    printPath(graph, usage, index, output);
+    fprintf(output, "\n");
+}
+
+// Write each function's frame and deepest path, then the deepest path from
+// every stack root
+void dumpStackReport(CallGraph *graph, StackUsage *usage, FILE *output)
+{
+    fprintf(output, "Stack use in bytes (estimated, without library calls):\n");
+    for (int i = 0; i < graph->count; i++)
+    {
+        fprintf(output, "  ");
+        printName(output, graph->nodes[i].decl);
+        fprintf(output, ": frame %d, ", usage[i].frame);
+        if (usage[i].unbounded)
+            fprintf(output, "deepest path unbounded%s\n", graph->nodes[i].recursive ? " (recursive)" : "");
+        else
+            fprintf(output, "deepest path %ld\n", usage[i].depth);
+    }
+
+    for (int i = 0; i < graph->count; i++)
+    {
+        if (isStackRoot(graph, i))
+        {
+            fprintf(output, "Deepest path from ");
+            reportRoot(graph, usage, i, output);
+        }
+    }
+}
+
+// Warn on stderr about stack roots whose deepest path needs more than limit
+// bytes or has no bound; returns the number of warnings
+int checkStackLimit(CallGraph *graph, StackUsage *usage, long limit)
+{
+    int warnings = 0;
+    for (int i = 0; i < graph->count; i++)
+    {
+        if (!isStackRoot(graph, i) || (!usage[i].unbounded && usage[i].depth <= limit))
+            continue;
+
+        AstFunctionDecl *decl = graph->nodes[i].decl;
+        fprintf(stderr, "Line %d, Column %d: Warning: ", decl->base.line, decl->base.column);
+        if (usage[i].unbounded)
+        {
+            fprintf(stderr, "Stack use from '");
+            printName(stderr, decl);
+            fprintf(stderr, "' has no bound: the path ");
+            printPath(graph, usage, i, stderr);
+            fprintf(stderr, " recurses; the limit is %ld bytes.\n", limit);
+        }
+        else
+        {
+            fprintf(stderr, "The path ");
+            printPath(graph, usage, i, stderr);
+            fprintf(stderr, " may use %ld bytes of stack, more than the limit of %ld.\n", usage[i].depth, limit);
+        }
+        warnings++;
+    }
+
+    return warnings;
+}
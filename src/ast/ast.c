@@ -1,6 +1,7 @@
 /* src/ast/ast.c */
 #include "../../include/ast.h"
 #include <stdlib.h>
+#include <string.h>
 
 // Helper to initialize the base AST node
 static void initNode(AstNode *node, AstNodeType type, int line, int column)
@@ -8,6 +9,8 @@ static void initNode(AstNode *node, AstNodeType type, int line, int column)
     node->type = type;
     node->line = line;
     node->column = column;
+    node->dataType = TOKEN_ERROR; // Not analyzed yet
+    node->temporary = false;
 }
 
 // Create a program node (root of AST)
@@ -18,6 +21,10 @@ AstProgram *createProgram()
     node->count = 0;
     node->capacity = 8; // Initial capacity
     node->declarations = (AstNode **)malloc(sizeof(AstNode *) * node->capacity);
+    node->runtimeFeatures = 0;
+    node->genericCount = 0;
+    node->genericCapacity = 0;
+    node->generics = NULL;
     return node;
 }
 
@@ -28,7 +35,16 @@ AstVarDecl *createVarDecl(Token name, TokenType type, AstNode *initializer)
     initNode((AstNode *)node, AST_VAR_DECL, name.line, name.column);
     node->name = name;
     node->varType = type;
+    node->keyType = TOKEN_VOID;
+    node->elemType = TOKEN_VOID;
+    node->capacity = 0;
     node->initializer = initializer;
+    node->typeParam = -1;
+    node->constant = false;
+    node->value = (ConstantValue){0};
+    node->elementCount = 0;
+    node->elementCapacity = 0;
+    node->elements = NULL;
     return node;
 }
 
@@ -41,8 +57,16 @@ AstFunctionDecl *createFunctionDecl(Token name, TokenType returnType)
     node->returnType = returnType;
     node->paramCount = 0;
     // Allocate space for parameters (up to 8 parameters)
-    node->params = malloc(sizeof(struct { Token name; TokenType type; }) * 8);
+    node->params = (AstParam *)malloc(sizeof(AstParam) * 8);
     node->body = NULL;
+    node->spawns = false;
+    node->spawned = false;
+    node->coroutine = false;
+    node->slotCount = 0;
+    node->slots = NULL;
+    node->typeParamCount = 0;
+    node->returnTypeParam = -1;
+    node->generic = NULL;
     return node;
 }
 
@@ -54,6 +78,7 @@ AstBlock *createBlock()
     node->count = 0;
     node->capacity = 8; // Initial capacity
     node->statements = (AstNode **)malloc(sizeof(AstNode *) * node->capacity);
+    node->region = false;
     return node;
 }
 
@@ -65,6 +90,8 @@ AstIf *createIf(AstNode *condition, AstNode *thenBranch, AstNode *elseBranch)
     node->condition = condition;
     node->thenBranch = thenBranch;
     node->elseBranch = elseBranch;
+    node->hint = BRANCH_HINT_NONE;
+    node->outcome = -1;
     return node;
 }
 
@@ -75,6 +102,7 @@ AstWhile *createWhile(AstNode *condition, AstNode *body)
     initNode((AstNode *)node, AST_WHILE, condition->line, condition->column);
     node->condition = condition;
     node->body = body;
+    node->hint = BRANCH_HINT_NONE;
     return node;
 }
 
@@ -146,6 +174,8 @@ AstBinary *createBinary(AstNode *left, TokenType operator, AstNode * right)
     node->left = left;
     node->operator= operator;
     node->right = right;
+    node->proven = false;
+    node->nonNegative = false;
     return node;
 }
 
@@ -156,6 +186,7 @@ AstUnary *createUnary(TokenType operator, AstNode * right)
     initNode((AstNode *)node, AST_UNARY, right->line, right->column);
     node->operator= operator;
     node->right = right;
+    node->proven = false;
     return node;
 }
 
@@ -174,6 +205,7 @@ AstVariable *createVariable(Token name)
     AstVariable *node = (AstVariable *)malloc(sizeof(AstVariable));
     initNode((AstNode *)node, AST_VARIABLE, name.line, name.column);
     node->name = name;
+    node->constant = NULL;
     return node;
 }
 
@@ -183,6 +215,7 @@ AstAssignment *createAssignment(Token name, AstNode *value)
     AstAssignment *node = (AstAssignment *)malloc(sizeof(AstAssignment));
     initNode((AstNode *)node, AST_ASSIGNMENT, name.line, name.column);
     node->name = name;
+    node->index = NULL;
     node->value = value;
     return node;
 }
@@ -196,9 +229,271 @@ AstCall *createCall(Token name)
     node->argCount = 0;
     node->capacity = 4; // Initial capacity
     node->arguments = (AstNode **)malloc(sizeof(AstNode *) * node->capacity);
+    node->coroutine = NULL;
     return node;
 }
 
+// Create a list element node
+AstIndex *createIndex(Token name, AstNode *index)
+{
+    AstIndex *node = (AstIndex *)malloc(sizeof(AstIndex));
+    initNode((AstNode *)node, AST_INDEX, name.line, name.column);
+    node->name = name;
+    node->index = index;
+    return node;
+}
+
+// Create a कार्य node around a call
+AstSpawn *createSpawn(AstCall *call)
+{
+    AstSpawn *node = (AstSpawn *)malloc(sizeof(AstSpawn));
+    initNode((AstNode *)node, AST_SPAWN, call->base.line, call->base.column);
+    node->call = call;
+    node->heapTask = false;
+    return node;
+}
+
+// Create a प्रतीक्षा statement node
+AstSync *createSync()
+{
+    AstSync *node = (AstSync *)malloc(sizeof(AstSync));
+    initNode((AstNode *)node, AST_SYNC, 0, 0);
+    return node;
+}
+
+// Create a रोको_और_दो statement node
+AstYield *createYield(AstNode *value)
+{
+    AstYield *node = (AstYield *)malloc(sizeof(AstYield));
+    initNode((AstNode *)node, AST_YIELD, 0, 0);
+    node->value = value;
+    return node;
+}
+
+// Create a मापो statement node
+AstMeasure *createMeasure(AstNode *runs, AstNode *body)
+{
+    AstMeasure *node = (AstMeasure *)malloc(sizeof(AstMeasure));
+    initNode((AstNode *)node, AST_MEASURE, 0, 0);
+    node->runs = runs;
+    node->body = body;
+    return node;
+}
+
+// Add a top-level declaration to a program
+void addDeclaration(AstProgram *program, AstNode *declaration)
+{
+    if (program->count >= program->capacity)
+    {
+        program->capacity = program->capacity * 2;
+        program->declarations = realloc(program->declarations, sizeof(AstNode *) * program->capacity);
+    }
+    program->declarations[program->count++] = declaration;
+}
+
+// Copy a node of a generic function's body, giving variables declared with a
+// type parameter the type it stands for
+static AstNode *cloneAst(AstNode *node, const TokenType *typeArguments)
+{
+    if (node == NULL)
+        return NULL;
+
+    size_t size = 0;
+    switch (node->type)
+    {
+    case AST_PROGRAM:
+    case AST_FUNCTION_DECL:
+        // Only found at the top level, never in a body
+        return NULL;
+    case AST_VAR_DECL:
+        size = sizeof(AstVarDecl);
+        break;
+    case AST_BLOCK:
+        size = sizeof(AstBlock);
+        break;
+    case AST_IF:
+        size = sizeof(AstIf);
+        break;
+    case AST_WHILE:
+        size = sizeof(AstWhile);
+        break;
+    case AST_FOR:
+        size = sizeof(AstFor);
+        break;
+    case AST_RETURN:
+        size = sizeof(AstReturn);
+        break;
+    case AST_EXPRESSION_STMT:
+        size = sizeof(AstExpressionStmt);
+        break;
+    case AST_SYNC:
+        size = sizeof(AstSync);
+        break;
+    case AST_YIELD:
+        size = sizeof(AstYield);
+        break;
+    case AST_MEASURE:
+        size = sizeof(AstMeasure);
+        break;
+    case AST_BINARY:
+        size = sizeof(AstBinary);
+        break;
+    case AST_UNARY:
+        size = sizeof(AstUnary);
+        break;
+    case AST_LITERAL:
+        size = sizeof(AstLiteral);
+        break;
+    case AST_VARIABLE:
+        size = sizeof(AstVariable);
+        break;
+    case AST_ASSIGNMENT:
+        size = sizeof(AstAssignment);
+        break;
+    case AST_CALL:
+        size = sizeof(AstCall);
+        break;
+    case AST_INDEX:
+        size = sizeof(AstIndex);
+        break;
+    case AST_SPAWN:
+        size = sizeof(AstSpawn);
+        break;
+    }
+
+    AstNode *copy = (AstNode *)malloc(size);
+    memcpy(copy, node, size);
+
+    switch (node->type)
+    {
+    case AST_VAR_DECL:
+    {
+        AstVarDecl *varDecl = (AstVarDecl *)copy;
+        if (varDecl->typeParam >= 0)
+        {
+            varDecl->varType = typeArguments[varDecl->typeParam];
+            varDecl->typeParam = -1;
+        }
+        varDecl->initializer = cloneAst(varDecl->initializer, typeArguments);
+        if (varDecl->elements != NULL)
+        {
+            varDecl->elements = (AstNode **)malloc(sizeof(AstNode *) * varDecl->elementCapacity);
+            for (int i = 0; i < varDecl->elementCount; i++)
+            {
+                varDecl->elements[i] = cloneAst(((AstVarDecl *)node)->elements[i], typeArguments);
+            }
+        }
+        break;
+    }
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)copy;
+        block->statements = (AstNode **)malloc(sizeof(AstNode *) * block->capacity);
+        for (int i = 0; i < block->count; i++)
+        {
+            block->statements[i] = cloneAst(((AstBlock *)node)->statements[i], typeArguments);
+        }
+        break;
+    }
+    case AST_IF:
+    {
+        AstIf *ifStmt = (AstIf *)copy;
+        ifStmt->condition = cloneAst(ifStmt->condition, typeArguments);
+        ifStmt->thenBranch = cloneAst(ifStmt->thenBranch, typeArguments);
+        ifStmt->elseBranch = cloneAst(ifStmt->elseBranch, typeArguments);
+        break;
+    }
+    case AST_WHILE:
+    {
+        AstWhile *whileStmt = (AstWhile *)copy;
+        whileStmt->condition = cloneAst(whileStmt->condition, typeArguments);
+        whileStmt->body = cloneAst(whileStmt->body, typeArguments);
+        break;
+    }
+    case AST_FOR:
+    {
+        AstFor *forStmt = (AstFor *)copy;
+        forStmt->initializer = cloneAst(forStmt->initializer, typeArguments);
+        forStmt->condition = cloneAst(forStmt->condition, typeArguments);
+        forStmt->increment = cloneAst(forStmt->increment, typeArguments);
+        forStmt->body = cloneAst(forStmt->body, typeArguments);
+        break;
+    }
+    case AST_RETURN:
+        ((AstReturn *)copy)->value = cloneAst(((AstReturn *)node)->value, typeArguments);
+        break;
+    case AST_EXPRESSION_STMT:
+        ((AstExpressionStmt *)copy)->expression = cloneAst(((AstExpressionStmt *)node)->expression, typeArguments);
+        break;
+    case AST_YIELD:
+        ((AstYield *)copy)->value = cloneAst(((AstYield *)node)->value, typeArguments);
+        break;
+    case AST_MEASURE:
+        ((AstMeasure *)copy)->runs = cloneAst(((AstMeasure *)node)->runs, typeArguments);
+        ((AstMeasure *)copy)->body = cloneAst(((AstMeasure *)node)->body, typeArguments);
+        break;
+    case AST_BINARY:
+        ((AstBinary *)copy)->left = cloneAst(((AstBinary *)node)->left, typeArguments);
+        ((AstBinary *)copy)->right = cloneAst(((AstBinary *)node)->right, typeArguments);
+        break;
+    case AST_UNARY:
+        ((AstUnary *)copy)->right = cloneAst(((AstUnary *)node)->right, typeArguments);
+        break;
+    case AST_ASSIGNMENT:
+        ((AstAssignment *)copy)->index = cloneAst(((AstAssignment *)node)->index, typeArguments);
+        ((AstAssignment *)copy)->value = cloneAst(((AstAssignment *)node)->value, typeArguments);
+        break;
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)copy;
+        call->arguments = (AstNode **)malloc(sizeof(AstNode *) * call->capacity);
+        for (int i = 0; i < call->argCount; i++)
+        {
+            call->arguments[i] = cloneAst(((AstCall *)node)->arguments[i], typeArguments);
+        }
+        break;
+    }
+    case AST_INDEX:
+        ((AstIndex *)copy)->index = cloneAst(((AstIndex *)node)->index, typeArguments);
+        break;
+    case AST_SPAWN:
+        ((AstSpawn *)copy)->call = (AstCall *)cloneAst((AstNode *)((AstSpawn *)node)->call, typeArguments);
+        break;
+    default:
+        break;
+    }
+
+    return copy;
+}
+
+// Instance of a generic function for the given types of its type
+// parameters, named name (which the instance takes ownership of)
+AstFunctionDecl *instantiateFunction(AstFunctionDecl *generic, const TokenType *typeArguments, char *name)
+{
+    Token instanceName = generic->name;
+    instanceName.start = name;
+    instanceName.length = (int)strlen(name);
+
+    TokenType returnType = generic->returnType;
+    if (generic->returnTypeParam >= 0)
+        returnType = typeArguments[generic->returnTypeParam];
+
+    AstFunctionDecl *instance = createFunctionDecl(instanceName, returnType);
+    instance->paramCount = generic->paramCount;
+    for (int i = 0; i < generic->paramCount; i++)
+    {
+        instance->params[i] = generic->params[i];
+        if (generic->params[i].typeParam >= 0)
+        {
+            instance->params[i].type = typeArguments[generic->params[i].typeParam];
+            instance->params[i].typeParam = -1;
+        }
+    }
+    instance->body = cloneAst(generic->body, typeArguments);
+    instance->generic = generic;
+    return instance;
+}
+
 // Free AST nodes
 void freeAst(AstNode *node)
 {
@@ -215,18 +510,31 @@ void freeAst(AstNode *node)
             freeAst(program->declarations[i]);
         }
         free(program->declarations);
+        for (int i = 0; i < program->genericCount; i++)
+        {
+            freeAst((AstNode *)program->generics[i]);
+        }
+        free(program->generics);
         break;
     }
     case AST_VAR_DECL:
     {
         AstVarDecl *varDecl = (AstVarDecl *)node;
         freeAst(varDecl->initializer);
+        for (int i = 0; i < varDecl->elementCount; i++)
+        {
+            freeAst(varDecl->elements[i]);
+        }
+        free(varDecl->elements);
         break;
     }
     case AST_FUNCTION_DECL:
     {
         AstFunctionDecl *funcDecl = (AstFunctionDecl *)node;
+        if (funcDecl->generic != NULL)
+            free((char *)funcDecl->name.start);
         free(funcDecl->params);
+        free(funcDecl->slots);
         freeAst(funcDecl->body);
         break;
     }
@@ -299,12 +607,214 @@ void freeAst(AstNode *node)
         free(call->arguments);
         break;
     }
+    case AST_ASSIGNMENT:
+    {
+        AstAssignment *assignment = (AstAssignment *)node;
+        freeAst(assignment->index);
+        freeAst(assignment->value);
+        break;
+    }
+    case AST_INDEX:
+        freeAst(((AstIndex *)node)->index);
+        break;
+    case AST_SPAWN:
+        freeAst((AstNode *)((AstSpawn *)node)->call);
+        break;
+    case AST_YIELD:
+        freeAst(((AstYield *)node)->value);
+        break;
+    case AST_MEASURE:
+        freeAst(((AstMeasure *)node)->runs);
+        freeAst(((AstMeasure *)node)->body);
+        break;
     case AST_LITERAL:
     case AST_VARIABLE:
-    case AST_ASSIGNMENT:
+    case AST_SYNC:
         // No sub-nodes to free
         break;
     }
 
     free(node);
-}
\ No newline at end of file
+}
+
+// Count the nodes in a subtree (used as a size estimate)
+int countAstNodes(AstNode *node)
+{
+    if (node == NULL)
+        return 0;
+
+    int count = 1;
+
+    switch (node->type)
+    {
+    case AST_PROGRAM:
+    {
+        AstProgram *program = (AstProgram *)node;
+        for (int i = 0; i < program->count; i++)
+        {
+            count += countAstNodes(program->declarations[i]);
+        }
+        break;
+    }
+    case AST_VAR_DECL:
+        count += countAstNodes(((AstVarDecl *)node)->initializer);
+        break;
+    case AST_FUNCTION_DECL:
+        count += countAstNodes(((AstFunctionDecl *)node)->body);
+        break;
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        for (int i = 0; i < block->count; i++)
+        {
+            count += countAstNodes(block->statements[i]);
+        }
+        break;
+    }
+    case AST_IF:
+    {
+        AstIf *ifStmt = (AstIf *)node;
+        count += countAstNodes(ifStmt->condition);
+        count += countAstNodes(ifStmt->thenBranch);
+        count += countAstNodes(ifStmt->elseBranch);
+        break;
+    }
+    case AST_WHILE:
+    {
+        AstWhile *whileStmt = (AstWhile *)node;
+        count += countAstNodes(whileStmt->condition);
+        count += countAstNodes(whileStmt->body);
+        break;
+    }
+    case AST_FOR:
+    {
+        AstFor *forStmt = (AstFor *)node;
+        count += countAstNodes(forStmt->initializer);
+        count += countAstNodes(forStmt->condition);
+        count += countAstNodes(forStmt->increment);
+        count += countAstNodes(forStmt->body);
+        break;
+    }
+    case AST_RETURN:
+        count += countAstNodes(((AstReturn *)node)->value);
+        break;
+    case AST_EXPRESSION_STMT:
+        count += countAstNodes(((AstExpressionStmt *)node)->expression);
+        break;
+    case AST_BINARY:
+    {
+        AstBinary *binary = (AstBinary *)node;
+        count += countAstNodes(binary->left);
+        count += countAstNodes(binary->right);
+        break;
+    }
+    case AST_UNARY:
+        count += countAstNodes(((AstUnary *)node)->right);
+        break;
+    case AST_ASSIGNMENT:
+        count += countAstNodes(((AstAssignment *)node)->index);
+        count += countAstNodes(((AstAssignment *)node)->value);
+        break;
+    case AST_INDEX:
+        count += countAstNodes(((AstIndex *)node)->index);
+        break;
+    case AST_SPAWN:
+        count += countAstNodes((AstNode *)((AstSpawn *)node)->call);
+        break;
+    case AST_YIELD:
+        count += countAstNodes(((AstYield *)node)->value);
+        break;
+    case AST_MEASURE:
+        count += countAstNodes(((AstMeasure *)node)->runs);
+        count += countAstNodes(((AstMeasure *)node)->body);
+        break;
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)node;
+        for (int i = 0; i < call->argCount; i++)
+        {
+            count += countAstNodes(call->arguments[i]);
+        }
+        break;
+    }
+    case AST_LITERAL:
+    case AST_VARIABLE:
+    case AST_SYNC:
+        break;
+    }
+
+    return count;
+}
+
+// Whether an expression is a string literal or a concatenation of literals
+bool isStringConstant(AstNode *node)
+{
+    if (node == NULL)
+        return false;
+
+    if (node->type == AST_LITERAL)
+        return ((AstLiteral *)node)->value.type == TOKEN_STRING;
+
+    if (node->type == AST_BINARY && ((AstBinary *)node)->operator== TOKEN_PLUS)
+        return isStringConstant(((AstBinary *)node)->left) && isStringConstant(((AstBinary *)node)->right);
+
+    // A स्थिर पाठ stands for its initializer
+    if (node->type == AST_VARIABLE && ((AstVariable *)node)->constant != NULL)
+        return ((AstVariable *)node)->constant->varType == TOKEN_TEXT;
+
+    return false;
+}
+
+MemoryOrder memoryOrderOf(AstNode *node)
+{
+    static const struct
+    {
+        const char *name;
+        MemoryOrder order;
+    } orders[] = {
+        {"शिथिल", MEMORY_ORDER_RELAXED},
+        {"अर्जन", MEMORY_ORDER_ACQUIRE},
+        {"विमोचन", MEMORY_ORDER_RELEASE},
+        {"अर्जन_विमोचन", MEMORY_ORDER_ACQ_REL},
+        {"अनुक्रमिक", MEMORY_ORDER_SEQ_CST},
+    };
+
+    if (node == NULL || node->type != AST_VARIABLE)
+        return MEMORY_ORDER_NONE;
+
+    Token name = ((AstVariable *)node)->name;
+    for (size_t i = 0; i < sizeof(orders) / sizeof(orders[0]); i++)
+    {
+        if (strlen(orders[i].name) == (size_t)name.length &&
+            memcmp(orders[i].name, name.start, name.length) == 0)
+            return orders[i].order;
+    }
+    return MEMORY_ORDER_NONE;
+}
+
+int delimiterOf(AstNode *node)
+{
+    if (node == NULL || node->type != AST_LITERAL || ((AstLiteral *)node)->value.type != TOKEN_STRING)
+        return -1;
+
+    // The token keeps its quotes
+    Token value = ((AstLiteral *)node)->value;
+    const char *text = value.start + 1;
+    int length = value.length - 2;
+
+    if (length == 1 && text[0] != '\\')
+        return (unsigned char)text[0];
+    if (length == 2 && text[0] == '\\')
+    {
+        switch (text[1])
+        {
+        case 't':
+            return '\t';
+        case '\\':
+        case '"':
+        case '\'':
+            return text[1];
+        }
+    }
+    return -1;
+}
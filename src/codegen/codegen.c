@@ -1,13 +1,33 @@
 /* src/codegen/codegen.c */
 #include "../../include/codegen.h"
+#include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
 
+// Directory of the runtime headers; the Makefile passes its absolute path
+#ifndef HC_RUNTIME_DIR
+#define HC_RUNTIME_DIR "runtime"
+#endif
+
+// Operands of a concatenation chain being emitted; runs of adjacent literals
+// are collected into one pending string
+typedef struct
+{
+    int count;
+    char *pending;
+    int pendingSize;
+    int pendingCapacity;
+} ConcatOperands;
+
 // Forward declarations
 static void generateDeclaration(CodeGenContext *context, AstNode *node);
 static void generateVarDecl(CodeGenContext *context, AstVarDecl *node);
+static void generateConstantTable(CodeGenContext *context, AstVarDecl *node);
 static void generateFunctionDecl(CodeGenContext *context, AstFunctionDecl *node);
+static void generateFunctionSignature(CodeGenContext *context, AstFunctionDecl *node);
+static void generateDeclarations(CodeGenContext *context, AstProgram *program, const int *partOf, int part);
 static void generateStatement(CodeGenContext *context, AstNode *node);
 static void generateBlock(CodeGenContext *context, AstBlock *node);
 static void generateIfStatement(CodeGenContext *context, AstIf *node);
@@ -17,11 +37,26 @@ static void generateReturnStatement(CodeGenContext *context, AstReturn *node);
 static void generateExpressionStatement(CodeGenContext *context, AstExpressionStmt *node);
 static void generateExpression(CodeGenContext *context, AstNode *node);
 static void generateBinary(CodeGenContext *context, AstBinary *node);
+static void generateConcatOperands(CodeGenContext *context, AstNode *node, ConcatOperands *operands);
 static void generateUnary(CodeGenContext *context, AstUnary *node);
 static void generateLiteral(CodeGenContext *context, AstLiteral *node);
+static void generateStringBytes(CodeGenContext *context, const char *bytes, int length);
+static void generateStringView(CodeGenContext *context, const char *bytes, int length, bool initializer);
+static void generateStringConstant(CodeGenContext *context, AstNode *node, bool initializer);
+static void flushConcatLiterals(CodeGenContext *context, ConcatOperands *operands);
 static void generateVariable(CodeGenContext *context, AstVariable *node);
 static void generateAssignment(CodeGenContext *context, AstAssignment *node);
 static void generateCall(CodeGenContext *context, AstCall *node);
+static void generateIndex(CodeGenContext *context, AstIndex *node);
+static void generateSpawn(CodeGenContext *context, AstSpawn *node, Token *result);
+static void generateYield(CodeGenContext *context, AstYield *node);
+static void generateMeasure(CodeGenContext *context, AstMeasure *node);
+static void generateOwnedValue(CodeGenContext *context, AstNode *node);
+static void generateFormatCall(CodeGenContext *context, AstCall *node, const char *cName);
+static void generateStringArgument(CodeGenContext *context, AstNode *node);
+
+// Leaf functions up to this many AST nodes are marked inline
+#define INLINE_SIZE_LIMIT 24
 
 // Type conversion from Hindi to C
 static const char *getTypeString(TokenType type)
@@ -34,18 +69,226 @@ static const char *getTypeString(TokenType type)
         return "float";
     case TOKEN_CHAR:
         return "char";
+    case TOKEN_TEXT:
+        return "hc_str";
     case TOKEN_VOID:
         return "void";
+    case TOKEN_ATOMIC:
+        return "atomic_int";
+    case TOKEN_FILE:
+        return "hc_file";
     default:
         return "void"; // Default
     }
 }
 
+static const char *getMemoryOrderString(MemoryOrder order)
+{
+    switch (order)
+    {
+    case MEMORY_ORDER_RELAXED:
+        return "memory_order_relaxed";
+    case MEMORY_ORDER_ACQUIRE:
+        return "memory_order_acquire";
+    case MEMORY_ORDER_RELEASE:
+        return "memory_order_release";
+    case MEMORY_ORDER_ACQ_REL:
+        return "memory_order_acq_rel";
+    default:
+        return "memory_order_seq_cst";
+    }
+}
+
+// Check whether a token spells the given (UTF-8) name
+static bool tokenIs(Token token, const char *name)
+{
+    size_t length = strlen(name);
+    return (size_t)token.length == length && memcmp(token.start, name, length) == 0;
+}
+
+// Numbers and characters, held in a register-sized C scalar
+static bool isScalarType(TokenType type)
+{
+    return type == TOKEN_INT || type == TOKEN_FLOAT || type == TOKEN_CHAR;
+}
+
+// Builtins and the C functions or runtime macros they lower to
+typedef struct
+{
+    const char *name;
+    TokenType firstArg; // Type of the first argument, or TOKEN_ERROR for any
+    const char *cName;
+} BuiltinLowering;
+
+static const BuiltinLowering builtinLowerings[] = {
+    {"लिखो", TOKEN_ERROR, "printf"},
+    {"पढ़ो", TOKEN_ERROR, "scanf"},
+    {"रखो", TOKEN_MAP, "hc_map_put"},
+    {"पाओ", TOKEN_MAP, "hc_map_get"},
+    {"है", TOKEN_MAP, "hc_map_contains"},
+    {"हटाओ", TOKEN_MAP, "hc_map_remove"},
+    {"आकार", TOKEN_MAP, "hc_map_size"},
+    {"जोड़ो", TOKEN_LIST, "hc_list_push"},
+    {"निकालो", TOKEN_LIST, "hc_list_pop"},
+    {"आकार", TOKEN_LIST, "hc_list_length"},
+    {"लंबाई", TOKEN_TEXT, "hc_str_length"},
+    {"टुकड़ा", TOKEN_TEXT, "hc_str_slice"},
+    {"अक्षर_गिनती", TOKEN_TEXT, "hc_str_graphemes"},
+    {"अक्षर", TOKEN_TEXT, "hc_str_grapheme_at"},
+    {"भेजो", TOKEN_CHANNEL, "hc_chan_send"},
+    {"लो", TOKEN_CHANNEL, "hc_chan_recv"},
+    {"परमाणु_पढ़ो", TOKEN_ATOMIC, "atomic_load_explicit"},
+    {"परमाणु_लिखो", TOKEN_ATOMIC, "atomic_store_explicit"},
+    {"परमाणु_जोड़ो", TOKEN_ATOMIC, "atomic_fetch_add_explicit"},
+    {"परमाणु_बदलो", TOKEN_ATOMIC, "hc_atomic_compare_exchange"},
+    {"खोलो", TOKEN_TEXT, "hc_file_open"},
+    {"अगली_पंक्ति", TOKEN_FILE, "hc_file_next_line"},
+    {"पंक्ति", TOKEN_FILE, "hc_file_line"},
+    {"अगला_खंड", TOKEN_FILE, "hc_file_next_field"},
+    {"खंड", TOKEN_FILE, "hc_file_field"},
+    {"क्रमबद्ध", TOKEN_LIST, "hc_list_sort"},
+    {"खोज", TOKEN_LIST, "hc_list_search"},
+    {"समय_नैनो", TOKEN_ERROR, "hc_time_nano"},
+    {"यादृच्छिक", TOKEN_ERROR, "hc_random"},
+    {"यादृच्छिक_भरो", TOKEN_LIST, "hc_random_fill"},
+    {"यादृच्छिक_बीज", TOKEN_ERROR, "hc_random_reseed"},
+    {NULL, TOKEN_ERROR, NULL} // End sentinel
+};
+
+// Emit a function name; the entry point becomes C's main
+static void emitFunctionName(CodeGenContext *context, Token name)
+{
+    if (tokenIs(name, "मुख्य"))
+    {
+        fprintf(context->output, "main");
+    }
+    else
+    {
+        fprintf(context->output, "%.*s", name.length, name.start);
+    }
+}
+
+// C spelling of a scalar type inside runtime type names
+static const char *getRuntimeTypeSuffix(TokenType type)
+{
+    switch (type)
+    {
+    case TOKEN_INT:
+        return "int";
+    case TOKEN_FLOAT:
+        return "float";
+    case TOKEN_TEXT:
+        return "str";
+    default:
+        return "char";
+    }
+}
+
+// Emit the C type of a variable, including runtime container types
+static void generateVarType(CodeGenContext *context, AstVarDecl *node)
+{
+    if (node->varType == TOKEN_MAP)
+    {
+        fprintf(context->output, "hc_map_%s_%s",
+                getRuntimeTypeSuffix(node->keyType),
+                getRuntimeTypeSuffix(node->elemType));
+        return;
+    }
+    if (node->varType == TOKEN_LIST)
+    {
+        fprintf(context->output, "hc_list_%s", getRuntimeTypeSuffix(node->elemType));
+        return;
+    }
+    if (node->varType == TOKEN_CHANNEL)
+    {
+        fprintf(context->output, "hc_chan_%s", getRuntimeTypeSuffix(node->elemType));
+        return;
+    }
+    if (node->varType == TOKEN_COROUTINE)
+    {
+        Token name = ((AstCall *)node->initializer)->coroutine->name;
+        fprintf(context->output, "hc_co_%.*s", name.length, name.start);
+        return;
+    }
+
+    fprintf(context->output, "%s", getTypeString(node->varType));
+}
+
+// Whether name refers to a variable the coroutine being generated keeps in
+// its frame across रोको_और_दो
+static bool isFrameVariable(CodeGenContext *context, Token name)
+{
+    if (context->coroutine == NULL)
+        return false;
+
+    for (int i = 0; i < context->coroutine->slotCount; i++)
+    {
+        AstFrameSlot *slot = &context->coroutine->slots[i];
+        if (slot->kept && slot->name.length == name.length &&
+            memcmp(slot->name.start, name.start, name.length) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether every use of a स्थिर variable is replaced by its value
+static bool isFoldedConstant(AstVarDecl *node)
+{
+    return node->constant && node->value.known;
+}
+
+// Emit the value of a folded constant as a C constant of the variable's type
+static void emitConstantValue(CodeGenContext *context, AstVarDecl *node)
+{
+    if (node->varType == TOKEN_TEXT)
+    {
+        generateStringConstant(context, node->initializer, false);
+        return;
+    }
+
+    if (!node->value.isFloat)
+    {
+        if (node->value.intValue == INT_MIN)
+            fprintf(context->output, "(-%d - 1)", INT_MAX);
+        else
+            fprintf(context->output, node->value.intValue < 0 ? "(%d)" : "%d", node->value.intValue);
+        return;
+    }
+
+    // Nine significant digits give back the same float
+    char digits[32];
+    snprintf(digits, sizeof(digits), "%.9g", node->value.floatValue);
+    const char *point = strpbrk(digits, ".e") != NULL ? "" : ".0";
+    fprintf(context->output, node->value.floatValue < 0 ? "(%s%sf)" : "%s%sf", digits, point);
+}
+
+// Emit a variable's name, reaching into the coroutine frame for kept variables
+static void emitVariableName(CodeGenContext *context, Token name)
+{
+    if (isFrameVariable(context, name))
+    {
+        fprintf(context->output, "hc_co->");
+    }
+    fprintf(context->output, "%.*s", name.length, name.start);
+}
+
 // Initialize the code generator
 void initCodeGen(CodeGenContext *context, FILE *output)
 {
     context->output = output;
     context->indentLevel = 0;
+    context->callGraph = NULL;
+    context->singleFile = true;
+    context->strings = NULL;
+    context->taskFrame = false;
+    context->coroutine = NULL;
+    context->resumePoints = 0;
+    context->regionDepth = 0;
+    context->measureDepth = 0;
+    context->singlePrecision = false;
+    context->checkedArith = false;
 }
 
 // Generate indentation
@@ -67,22 +310,627 @@ void emitLine(CodeGenContext *context, const char *format, ...)
     vfprintf(context->output, format, args);
     fprintf(context->output, "\n");
 
-    va_end(args);
+    va_end(args);
+}
+
+// Emit the standard includes every generated file starts with
+static void generateIncludes(CodeGenContext *context, AstProgram *program)
+{
+    // The runtime calls POSIX and Linux functions that strict -std= modes hide
+    if (program->runtimeFeatures != 0 || context->checkedArith)
+    {
+        fprintf(context->output, "#define _GNU_SOURCE\n");
+    }
+    // Tasks may share global strings, whose counts then change atomically
+    if (program->runtimeFeatures & RUNTIME_TASK)
+    {
+        fprintf(context->output, "#define HC_STR_ATOMIC_REFS\n");
+    }
+    fprintf(context->output, "#include <stdio.h>\n");
+    fprintf(context->output, "#include <stdlib.h>\n\n");
+
+    // Runtime headers are found through -I HC_RUNTIME_DIR (see printCompileFlags)
+    if (program->runtimeFeatures & RUNTIME_STR)
+    {
+        fprintf(context->output, "#include \"hc_str.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_MAP)
+    {
+        fprintf(context->output, "#include \"hc_map.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_LIST)
+    {
+        fprintf(context->output, "#include \"hc_list.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_TASK)
+    {
+        // The pool's shared state is defined once: here, or by the first part
+        if (context->singleFile)
+        {
+            fprintf(context->output, "#define HC_TASK_IMPLEMENTATION\n");
+        }
+        fprintf(context->output, "#include \"hc_task.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_CHAN)
+    {
+        fprintf(context->output, "#include \"hc_chan.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_ATOMIC)
+    {
+        fprintf(context->output, "#include \"hc_atomic.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_REGION)
+    {
+        fprintf(context->output, "#include \"hc_arena.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_FILE)
+    {
+        fprintf(context->output, "#include \"hc_file.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_CSV)
+    {
+        fprintf(context->output, "#include \"hc_csv.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_SORT)
+    {
+        fprintf(context->output, "#include \"hc_sort.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_TIME)
+    {
+        // So are the clock's calibration and epoch
+        if (context->singleFile)
+        {
+            fprintf(context->output, "#define HC_TIME_IMPLEMENTATION\n");
+        }
+        fprintf(context->output, "#include \"hc_time.h\"\n\n");
+    }
+    if (program->runtimeFeatures & RUNTIME_RANDOM)
+    {
+        // And the random seed and stream count
+        if (context->singleFile)
+        {
+            fprintf(context->output, "#define HC_RANDOM_IMPLEMENTATION\n");
+        }
+        fprintf(context->output, "#include \"hc_random.h\"\n\n");
+    }
+    if (context->checkedArith)
+    {
+        fprintf(context->output, "#include \"hc_checked.h\"\n\n");
+    }
+
+    // Optimization hints degrade to nothing on compilers without GNU extensions
+    fprintf(context->output, "#if defined(__GNUC__)\n");
+    fprintf(context->output, "#define HC_HOT __attribute__((hot))\n");
+    fprintf(context->output, "#define HC_COLD __attribute__((cold))\n");
+    fprintf(context->output, "#define HC_LIKELY(x) __builtin_expect(!!(x), 1)\n");
+    fprintf(context->output, "#define HC_UNLIKELY(x) __builtin_expect(!!(x), 0)\n");
+    fprintf(context->output, "#define HC_UNUSED __attribute__((unused))\n");
+    fprintf(context->output, "#else\n");
+    fprintf(context->output, "#define HC_HOT\n");
+    fprintf(context->output, "#define HC_COLD\n");
+    fprintf(context->output, "#define HC_LIKELY(x) (x)\n");
+    fprintf(context->output, "#define HC_UNLIKELY(x) (x)\n");
+    fprintf(context->output, "#define HC_UNUSED\n");
+    fprintf(context->output, "#endif\n\n");
+}
+
+// Emit linkage and optimization hints that precede a function's signature
+static void generateFunctionSpecifiers(CodeGenContext *context, AstFunctionDecl *node)
+{
+    // The entry point keeps external linkage; everything else is private to the file
+    if (isEntryPoint(node->name))
+        return;
+
+    if (context->singleFile)
+    {
+        fprintf(context->output, "static ");
+    }
+
+    if (context->callGraph == NULL)
+        return;
+
+    int index = findCallGraphNode(context->callGraph, node->name);
+    if (index < 0)
+        return;
+
+    CallGraphNode *graphNode = &context->callGraph->nodes[index];
+
+    // A static function nothing calls would warn under -Wunused-function
+    if (context->singleFile && !graphNode->reachable)
+    {
+        fprintf(context->output, "HC_UNUSED ");
+    }
+
+    // C99 inline without static needs an external definition elsewhere, so
+    // only suggest inlining when the function is file-local
+    if (context->singleFile && isLeafFunction(context->callGraph, index) &&
+        graphNode->temperature != TEMPERATURE_COLD &&
+        graphNode->size <= INLINE_SIZE_LIMIT)
+    {
+        fprintf(context->output, "inline ");
+    }
+
+    if (graphNode->temperature == TEMPERATURE_COLD)
+    {
+        fprintf(context->output, "HC_COLD ");
+    }
+    else if (graphNode->temperature == TEMPERATURE_HOT)
+    {
+        fprintf(context->output, "HC_HOT ");
+    }
+}
+
+// Emit the record, runner and spawn function through which कार्य starts a
+// function. The record holds the arguments and where the result goes; it
+// lives in the spawning function's frame unless the spawn passes NULL, in
+// which case it is allocated and freed by the frame's next sync.
+static void generateTaskWrapper(CodeGenContext *context, AstFunctionDecl *node)
+{
+    FILE *output = context->output;
+    Token name = node->name;
+    bool returns = node->returnType != TOKEN_VOID;
+    const char *returnType = getTypeString(node->returnType);
+
+    fprintf(output, "typedef struct\n{\n    hc_task task;\n");
+    if (returns)
+    {
+        fprintf(output, "    %s *result;\n", returnType);
+    }
+    for (int i = 0; i < node->paramCount; i++)
+    {
+        fprintf(output, "    %s a%d;\n", getTypeString(node->params[i].type), i);
+    }
+    fprintf(output, "} hc_task_%.*s;\n\n", name.length, name.start);
+
+    fprintf(output, "static inline void hc_task_%.*s_run(hc_task *task)\n{\n", name.length, name.start);
+    fprintf(output, "    hc_task_%.*s *self = (hc_task_%.*s *)task;\n",
+            name.length, name.start, name.length, name.start);
+    fprintf(output, "    ");
+    if (returns)
+    {
+        fprintf(output, "%s value = ", returnType);
+    }
+    emitFunctionName(context, name);
+    fprintf(output, "(");
+    for (int i = 0; i < node->paramCount; i++)
+    {
+        fprintf(output, i > 0 ? ", self->a%d" : "self->a%d", i);
+    }
+    fprintf(output, ");\n");
+    if (returns)
+    {
+        fprintf(output, "    if (self->result != NULL)\n        *self->result = value;\n");
+    }
+    fprintf(output, "}\n\n");
+
+    fprintf(output, "static inline void hc_spawn_%.*s(hc_task_frame *frame, hc_task_%.*s *self",
+            name.length, name.start, name.length, name.start);
+    if (returns)
+    {
+        fprintf(output, ", %s *result", returnType);
+    }
+    for (int i = 0; i < node->paramCount; i++)
+    {
+        fprintf(output, ", %s a%d", getTypeString(node->params[i].type), i);
+    }
+    fprintf(output, ")\n{\n");
+    fprintf(output, "    if (self == NULL)\n");
+    fprintf(output, "        self = (hc_task_%.*s *)hc_task_alloc(frame, sizeof(*self));\n",
+            name.length, name.start);
+    if (returns)
+    {
+        fprintf(output, "    self->result = result;\n");
+    }
+    for (int i = 0; i < node->paramCount; i++)
+    {
+        fprintf(output, "    self->a%d = a%d;\n", i, i);
+    }
+    fprintf(output, "    hc_task_spawn(frame, &self->task, hc_task_%.*s_run);\n}\n\n",
+            name.length, name.start);
+}
+
+// Emit the task wrappers of every function started with कार्य
+static void generateTaskWrappers(CodeGenContext *context, AstProgram *program)
+{
+    for (int i = 0; i < program->count; i++)
+    {
+        AstNode *node = program->declarations[i];
+        if (node->type == AST_FUNCTION_DECL && ((AstFunctionDecl *)node)->spawned)
+        {
+            generateTaskWrapper(context, (AstFunctionDecl *)node);
+        }
+    }
+}
+
+// Emit a coroutine's frame type, its constructor and the prototype of its
+// resume function, after those of the coroutines its frame holds. A frame
+// keeps the parameters, the locals that live across रोको_और_दो and the
+// resume point; all-zero state is the start of the body.
+static void generateCoroutineFrame(CodeGenContext *context, AstProgram *program, int index, bool *emitted)
+{
+    AstFunctionDecl *node = (AstFunctionDecl *)program->declarations[index];
+    FILE *output = context->output;
+    emitted[index] = true;
+
+    for (int i = 0; i < node->slotCount; i++)
+    {
+        for (int j = 0; node->slots[i].kept && j < program->count; j++)
+        {
+            if (program->declarations[j] == (AstNode *)node->slots[i].coroutine && !emitted[j])
+            {
+                generateCoroutineFrame(context, program, j, emitted);
+            }
+        }
+    }
+
+    Token name = node->name;
+    fprintf(output, "typedef struct\n{\n");
+    fprintf(output, "    int hc_state; // Resume point, -1 once finished\n");
+    fprintf(output, "    %s hc_value; // Value yielded last\n", getTypeString(node->returnType));
+    for (int i = 0; i < node->slotCount; i++)
+    {
+        AstFrameSlot *slot = &node->slots[i];
+        if (!slot->kept)
+            continue;
+
+        if (slot->type == TOKEN_COROUTINE)
+        {
+            fprintf(output, "    hc_co_%.*s %.*s;\n", slot->coroutine->name.length, slot->coroutine->name.start,
+                    slot->name.length, slot->name.start);
+        }
+        else
+        {
+            fprintf(output, "    %s %.*s;\n", getTypeString(slot->type), slot->name.length, slot->name.start);
+        }
+    }
+    fprintf(output, "} hc_co_%.*s;\n\n", name.length, name.start);
+
+    fprintf(output, "static inline hc_co_%.*s %.*s(", name.length, name.start, name.length, name.start);
+    for (int i = 0; i < node->paramCount; i++)
+    {
+        fprintf(output, "%s%s %.*s", i > 0 ? ", " : "", getTypeString(node->params[i].type),
+                node->params[i].name.length, node->params[i].name.start);
+    }
+    fprintf(output, "%s)\n{\n", node->paramCount == 0 ? "void" : "");
+    fprintf(output, "    hc_co_%.*s hc_co = {0};\n", name.length, name.start);
+    for (int i = 0; i < node->paramCount; i++)
+    {
+        Token param = node->params[i].name;
+        fprintf(output, "    hc_co.%.*s = %.*s;\n", param.length, param.start, param.length, param.start);
+    }
+    fprintf(output, "    return hc_co;\n}\n\n");
+
+    generateFunctionSpecifiers(context, node);
+    fprintf(output, "int hc_co_%.*s_resume(hc_co_%.*s *hc_co);\n\n", name.length, name.start,
+            name.length, name.start);
+}
+
+// Emit the frames of every coroutine
+static void generateCoroutineFrames(CodeGenContext *context, AstProgram *program)
+{
+    bool *emitted = (bool *)calloc(program->count > 0 ? program->count : 1, sizeof(bool));
+    for (int i = 0; i < program->count; i++)
+    {
+        AstNode *node = program->declarations[i];
+        if (node->type == AST_FUNCTION_DECL && ((AstFunctionDecl *)node)->coroutine && !emitted[i])
+        {
+            generateCoroutineFrame(context, program, i, emitted);
+        }
+    }
+    free(emitted);
+}
+
+// Generate the declarations assigned to one part (all of them if partOf is NULL).
+// Globals keep their source order; functions are laid out hot first and cold
+// last so the code that runs together sits together in the instruction cache.
+static void generateDeclarations(CodeGenContext *context, AstProgram *program, const int *partOf, int part)
+{
+    for (int i = 0; i < program->count; i++)
+    {
+        if (program->declarations[i]->type != AST_FUNCTION_DECL &&
+            (partOf == NULL || partOf[i] == part))
+        {
+            generateDeclaration(context, program->declarations[i]);
+            fprintf(context->output, "\n");
+        }
+    }
+
+    if (context->callGraph == NULL)
+    {
+        for (int i = 0; i < program->count; i++)
+        {
+            if (program->declarations[i]->type == AST_FUNCTION_DECL &&
+                (partOf == NULL || partOf[i] == part))
+            {
+                generateDeclaration(context, program->declarations[i]);
+                fprintf(context->output, "\n");
+            }
+        }
+        return;
+    }
+
+    CallGraph *graph = context->callGraph;
+    int *order = (int *)malloc(sizeof(int) * (graph->count > 0 ? graph->count : 1));
+    orderFunctionsByTemperature(graph, order);
+
+    for (int k = 0; k < graph->count; k++)
+    {
+        AstNode *function = (AstNode *)graph->nodes[order[k]].decl;
+        for (int i = 0; i < program->count; i++)
+        {
+            if (program->declarations[i] == function && (partOf == NULL || partOf[i] == part))
+            {
+                generateDeclaration(context, function);
+                fprintf(context->output, "\n");
+            }
+        }
+    }
+
+    free(order);
+}
+
+// Generate the declarations of one part behind the literal table they use.
+// The declarations go to a scratch file first, since the table must precede
+// them and is only complete once they have all been generated.
+static void generatePooledDeclarations(CodeGenContext *context, AstProgram *program, const int *partOf,
+                                       int part)
+{
+    FILE *output = context->output;
+    FILE *body = tmpfile();
+    if (body == NULL)
+    {
+        // Without a scratch file, literals are written where they are used
+        generateDeclarations(context, program, partOf, part);
+        return;
+    }
+
+    StringPool pool;
+    initStringPool(&pool);
+    context->output = body;
+    context->strings = &pool;
+    generateDeclarations(context, program, partOf, part);
+    context->output = output;
+    context->strings = NULL;
+
+    writeStringPool(output, &pool);
+    freeStringPool(&pool);
+
+    rewind(body);
+    char chunk[4096];
+    size_t count;
+    while ((count = fread(chunk, 1, sizeof(chunk), body)) > 0)
+    {
+        fwrite(chunk, 1, count, output);
+    }
+    fclose(body);
+}
+
+// Generate code from AST
+void generateCode(CodeGenContext *context, AstProgram *program)
+{
+    // Add standard includes
+    generateIncludes(context, program);
+
+    // Prototypes, so functions may be called before their definition
+    bool hasPrototypes = false;
+    for (int i = 0; i < program->count; i++)
+    {
+        AstNode *node = program->declarations[i];
+        if (node->type == AST_FUNCTION_DECL && !isEntryPoint(((AstFunctionDecl *)node)->name) &&
+            !((AstFunctionDecl *)node)->coroutine)
+        {
+            generateFunctionSpecifiers(context, (AstFunctionDecl *)node);
+            generateFunctionSignature(context, (AstFunctionDecl *)node);
+            fprintf(context->output, ";\n");
+            hasPrototypes = true;
+        }
+    }
+    if (hasPrototypes)
+    {
+        fprintf(context->output, "\n");
+    }
+    generateCoroutineFrames(context, program);
+    generateTaskWrappers(context, program);
+
+    // Generate code for each declaration
+    generatePooledDeclarations(context, program, NULL, 0);
+}
+
+// Open one of the files written in split mode
+static FILE *openSplitFile(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Could not open output file '%s'.\n", path);
+    }
+    return file;
+}
+
+// Build "<basePath><suffix>"
+static char *joinPath(const char *basePath, const char *suffix)
+{
+    char *path = (char *)malloc(strlen(basePath) + strlen(suffix) + 1);
+    strcpy(path, basePath);
+    strcat(path, suffix);
+    return path;
+}
+
+// Generate code split across several translation units
+bool generateSplitCode(CodeGenContext *context, AstProgram *program, const char *basePath, int parts)
+{
+    // Generated files refer to each other relative to their own directory
+    const char *baseName = strrchr(basePath, '/');
+    baseName = baseName != NULL ? baseName + 1 : basePath;
+
+    int functionCount = 0;
+    for (int i = 0; i < program->count; i++)
+    {
+        if (program->declarations[i]->type == AST_FUNCTION_DECL)
+            functionCount++;
+    }
+
+    // No point in emitting translation units without a function in them
+    if (parts > functionCount)
+        parts = functionCount > 0 ? functionCount : 1;
+
+    // Balance the functions by AST size: largest first, each onto the lightest part
+    int *partOf = (int *)malloc(sizeof(int) * (program->count > 0 ? program->count : 1));
+    int *sizes = (int *)malloc(sizeof(int) * (program->count > 0 ? program->count : 1));
+    long *load = (long *)calloc(parts, sizeof(long));
+    for (int i = 0; i < program->count; i++)
+    {
+        partOf[i] = 0; // Globals and top-level statements live in the first part
+        sizes[i] = program->declarations[i]->type == AST_FUNCTION_DECL
+                       ? countAstNodes(program->declarations[i])
+                       : -1;
+    }
+    for (int placed = 0; placed < functionCount; placed++)
+    {
+        int largest = -1;
+        for (int i = 0; i < program->count; i++)
+        {
+            if (sizes[i] >= 0 && (largest < 0 || sizes[i] > sizes[largest]))
+                largest = i;
+        }
+
+        int lightest = 0;
+        for (int p = 1; p < parts; p++)
+        {
+            if (load[p] < load[lightest])
+                lightest = p;
+        }
+
+        partOf[largest] = lightest;
+        load[lightest] += sizes[largest];
+        sizes[largest] = -1;
+    }
+    free(sizes);
+    free(load);
+
+    FILE *originalOutput = context->output;
+    bool originalSingleFile = context->singleFile;
+    bool success = true;
+
+    // Functions are shared between the parts, so they keep external linkage
+    context->singleFile = false;
+
+    // Shared header: prototypes and extern declarations of globals
+    char *headerPath = joinPath(basePath, ".h");
+    FILE *header = openSplitFile(headerPath);
+    if (header == NULL)
+    {
+        free(headerPath);
+        free(partOf);
+        context->singleFile = originalSingleFile;
+        return false;
+    }
+
+    context->output = header;
+    fprintf(header, "#ifndef HC_SPLIT_HEADER\n#define HC_SPLIT_HEADER\n\n");
+    generateIncludes(context, program);
+    for (int i = 0; i < program->count; i++)
+    {
+        AstNode *node = program->declarations[i];
+        if (node->type == AST_FUNCTION_DECL && !((AstFunctionDecl *)node)->coroutine)
+        {
+            generateFunctionSpecifiers(context, (AstFunctionDecl *)node);
+            generateFunctionSignature(context, (AstFunctionDecl *)node);
+            fprintf(header, ";\n");
+        }
+        else if (node->type == AST_VAR_DECL && !isFoldedConstant((AstVarDecl *)node))
+        {
+            AstVarDecl *var = (AstVarDecl *)node;
+            fprintf(header, "extern ");
+            generateVarType(context, var);
+            fprintf(header, " %.*s;\n", var->name.length, var->name.start);
+        }
+    }
+    fprintf(header, "\n");
+    generateCoroutineFrames(context, program);
+    generateTaskWrappers(context, program);
+    fprintf(header, "#endif\n");
+    fclose(header);
+
+    // One translation unit per part
+    for (int p = 0; p < parts && success; p++)
+    {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), "_%d.c", p + 1);
+        char *partPath = joinPath(basePath, suffix);
+        FILE *part = openSplitFile(partPath);
+        free(partPath);
+        if (part == NULL)
+        {
+            success = false;
+            break;
+        }
+
+        context->output = part;
+        if (p == 0 && (program->runtimeFeatures & RUNTIME_TASK))
+        {
+            fprintf(part, "#define HC_TASK_IMPLEMENTATION\n");
+        }
+        if (p == 0 && (program->runtimeFeatures & RUNTIME_TIME))
+        {
+            fprintf(part, "#define HC_TIME_IMPLEMENTATION\n");
+        }
+        if (p == 0 && (program->runtimeFeatures & RUNTIME_RANDOM))
+        {
+            fprintf(part, "#define HC_RANDOM_IMPLEMENTATION\n");
+        }
+        fprintf(part, "#include \"%s.h\"\n\n", baseName);
+        generatePooledDeclarations(context, program, partOf, p);
+        fclose(part);
+    }
+
+    // Makefile snippet so the parts can be built with make -j
+    if (success)
+    {
+        char *makePath = joinPath(basePath, ".mk");
+        FILE *make = openSplitFile(makePath);
+        free(makePath);
+        if (make == NULL)
+        {
+            success = false;
+        }
+        else
+        {
+            fprintf(make, "# Generated by hindic; build with: make -j -f %s.mk\n", baseName);
+            fprintf(make, "CC ?= cc\nCFLAGS ?= -O2\n");
+            fprintf(make, "HC_RUNTIME ?= %s\nCPPFLAGS += -I$(HC_RUNTIME)\n", HC_RUNTIME_DIR);
+            if (program->runtimeFeatures & (RUNTIME_TASK | RUNTIME_CHAN))
+            {
+                fprintf(make, "LDLIBS += -pthread\n");
+            }
+            fprintf(make, "\n");
+            fprintf(make, "HC_OBJS =");
+            for (int p = 0; p < parts; p++)
+            {
+                fprintf(make, " %s_%d.o", baseName, p + 1);
+            }
+            fprintf(make, "\n\n%s: $(HC_OBJS)\n\t$(CC) $(CFLAGS) $(CPPFLAGS) -o $@ $(HC_OBJS) $(LDLIBS)\n\n", baseName);
+            fprintf(make, "%s_%%.o: %s_%%.c %s.h\n\t$(CC) $(CFLAGS) $(CPPFLAGS) -c -o $@ $<\n\n",
+                    baseName, baseName, baseName);
+            fprintf(make, "clean:\n\trm -f %s $(HC_OBJS)\n\n.PHONY: clean\n", baseName);
+            fclose(make);
+        }
+    }
+
+    free(headerPath);
+    free(partOf);
+    context->output = originalOutput;
+    context->singleFile = originalSingleFile;
+    return success;
 }
 
-// Generate code from AST
-void generateCode(CodeGenContext *context, AstProgram *program)
+void printCompileFlags(CodeGenContext *context, AstProgram *program, const char *outputPath)
 {
-    // Add standard includes
-    fprintf(context->output, "#include <stdio.h>\n");
-    fprintf(context->output, "#include <stdlib.h>\n\n");
+    if (program->runtimeFeatures == 0 && !context->checkedArith)
+        return;
 
-    // Generate code for each declaration
-    for (int i = 0; i < program->count; i++)
-    {
-        generateDeclaration(context, program->declarations[i]);
-        fprintf(context->output, "\n");
-    }
+    printf("Compile it with: cc -I%s %s%s\n", HC_RUNTIME_DIR, outputPath,
+           program->runtimeFeatures & (RUNTIME_TASK | RUNTIME_CHAN) ? " -pthread" : "");
 }
 
 // Generate code for a declaration
@@ -102,13 +950,178 @@ static void generateDeclaration(CodeGenContext *context, AstNode *node)
     }
 }
 
+// Generate a स्थिर list: its elements are a static const array in read-only
+// data, and the list points at them. Nothing writes to a constant list, so
+// it never grows into the heap and is never freed.
+static void generateConstantTable(CodeGenContext *context, AstVarDecl *node)
+{
+    const char *elemType = getTypeString(node->elemType);
+    if (node->elementCount > 0)
+    {
+        emitIndentation(context);
+        fprintf(context->output, "static const %s hc_table_%.*s[%d] = {", elemType, node->name.length,
+                node->name.start, node->elementCount);
+        for (int i = 0; i < node->elementCount; i++)
+        {
+            fprintf(context->output, i > 0 ? ", " : "");
+            if (node->elemType == TOKEN_TEXT)
+                generateStringConstant(context, node->elements[i], true);
+            else
+                generateExpression(context, node->elements[i]);
+        }
+        fprintf(context->output, "};\n");
+    }
+
+    emitIndentation(context);
+    generateVarType(context, node);
+    fprintf(context->output, " %.*s", node->name.length, node->name.start);
+    if (node->elementCount > 0)
+    {
+        fprintf(context->output, " = {.data = (%s *)hc_table_%.*s, .length = %d, .capacity = %d, .arena = NULL};\n",
+                elemType, node->name.length, node->name.start, node->elementCount, node->elementCount);
+    }
+    else
+    {
+        fprintf(context->output, " = {0};\n");
+    }
+}
+
+// Generate a global channel over a zeroed ring of its own. The ring holds a
+// power of two cells, at least two; unbuffered channels hand values over
+// through a two-cell ring.
+static void generateChannelDecl(CodeGenContext *context, AstVarDecl *node)
+{
+    int capacity = 2;
+    while (capacity < node->capacity)
+    {
+        capacity *= 2;
+    }
+
+    fprintf(context->output, "static hc_chan_%s_cell hc_cells_%.*s[%d];\n",
+            getRuntimeTypeSuffix(node->elemType), node->name.length, node->name.start, capacity);
+    generateVarType(context, node);
+    fprintf(context->output, " %.*s = HC_CHAN_INIT(hc_cells_%.*s, %d, %d);\n",
+            node->name.length, node->name.start, node->name.length, node->name.start,
+            capacity, node->capacity == 0);
+}
+
 // Generate code for a variable declaration
 static void generateVarDecl(CodeGenContext *context, AstVarDecl *node)
 {
+    if (node->varType == TOKEN_CHANNEL)
+    {
+        generateChannelDecl(context, node);
+        return;
+    }
+    if (node->constant && node->varType == TOKEN_LIST)
+    {
+        generateConstantTable(context, node);
+        return;
+    }
+
+    // Uses of a constant are replaced by its value. Globals stay in read-only
+    // data, where a debugger finds them; locals are left out.
+    if (isFoldedConstant(node))
+    {
+        if (context->indentLevel == 0)
+        {
+            fprintf(context->output, "static const %s HC_UNUSED %.*s = ", getTypeString(node->varType),
+                    node->name.length, node->name.start);
+            if (node->varType == TOKEN_TEXT)
+                generateStringConstant(context, node->initializer, true);
+            else
+                emitConstantValue(context, node);
+            fprintf(context->output, ";\n");
+        }
+        return;
+    }
+
+    // Locals a coroutine keeps already have a place in its frame
+    if (isFrameVariable(context, node->name))
+    {
+        if (node->initializer != NULL)
+        {
+            emitIndentation(context);
+            emitVariableName(context, node->name);
+            fprintf(context->output, " = ");
+            generateExpression(context, node->initializer);
+            fprintf(context->output, ";\n");
+        }
+        return;
+    }
+
     emitIndentation(context);
-    fprintf(context->output, "%s %.*s",
-            getTypeString(node->varType),
-            node->name.length, node->name.start);
+    generateVarType(context, node);
+    fprintf(context->output, " %.*s", node->name.length, node->name.start);
+
+    // Containers start empty; locals release their storage when they go out of scope
+    if (node->varType == TOKEN_MAP || node->varType == TOKEN_LIST)
+    {
+        if (context->indentLevel > 0)
+        {
+            fprintf(context->output, " HC_CLEANUP(");
+            generateVarType(context, node);
+            fprintf(context->output, "_free)");
+        }
+
+        // A list initialized from another list takes over its storage
+        if (node->initializer != NULL)
+        {
+            fprintf(context->output, " = hc_list_take(&");
+            generateExpression(context, node->initializer);
+            fprintf(context->output, ");\n");
+            return;
+        }
+        if (context->regionDepth > 0)
+        {
+            fprintf(context->output, " = {.arena = hc_region_%d};\n", context->regionDepth);
+            return;
+        }
+        fprintf(context->output, " = {0};\n");
+        return;
+    }
+
+    // Local strings release their reference when they go out of scope;
+    // globals start from a literal or empty
+    if (node->varType == TOKEN_TEXT)
+    {
+        if (context->indentLevel == 0)
+        {
+            if (node->initializer != NULL)
+            {
+                fprintf(context->output, " = ");
+                generateStringConstant(context, node->initializer, true);
+                fprintf(context->output, ";\n");
+            }
+            else
+            {
+                fprintf(context->output, " = {0};\n");
+            }
+            return;
+        }
+
+        fprintf(context->output, " HC_CLEANUP(hc_str_release) = ");
+        if (node->initializer != NULL)
+        {
+            generateOwnedValue(context, node->initializer);
+        }
+        else
+        {
+            fprintf(context->output, "(hc_str){0}");
+        }
+        fprintf(context->output, ";\n");
+        return;
+    }
+
+    // A task stores its result once it has run
+    if (node->initializer != NULL && node->initializer->type == AST_SPAWN)
+    {
+        fprintf(context->output, ";\n");
+        emitIndentation(context);
+        generateSpawn(context, (AstSpawn *)node->initializer, &node->name);
+        fprintf(context->output, ";\n");
+        return;
+    }
 
     // If there's an initializer
     if (node->initializer != NULL)
@@ -120,13 +1133,12 @@ static void generateVarDecl(CodeGenContext *context, AstVarDecl *node)
     fprintf(context->output, ";\n");
 }
 
-// Generate code for a function declaration
-static void generateFunctionDecl(CodeGenContext *context, AstFunctionDecl *node)
+// Generate a function's return type, name and parameter list
+static void generateFunctionSignature(CodeGenContext *context, AstFunctionDecl *node)
 {
-    // Function header
-    fprintf(context->output, "%s %.*s(",
-            getTypeString(node->returnType),
-            node->name.length, node->name.start);
+    fprintf(context->output, "%s ", getTypeString(node->returnType));
+    emitFunctionName(context, node->name);
+    fprintf(context->output, "(");
 
     // Parameters
     for (int i = 0; i < node->paramCount; i++)
@@ -141,10 +1153,71 @@ static void generateFunctionDecl(CodeGenContext *context, AstFunctionDecl *node)
                 node->params[i].name.length, node->params[i].name.start);
     }
 
-    fprintf(context->output, ") ");
+    if (node->paramCount == 0)
+    {
+        fprintf(context->output, "void");
+    }
 
-    // Function body
+    fprintf(context->output, ")");
+}
+
+// Generate a coroutine's resume function: its body becomes a switch on the
+// resume point, with a case label after every रोको_और_दो
+static void generateCoroutine(CodeGenContext *context, AstFunctionDecl *node)
+{
+    generateFunctionSpecifiers(context, node);
+    fprintf(context->output, "int hc_co_%.*s_resume(hc_co_%.*s *hc_co)\n{\n",
+            node->name.length, node->name.start, node->name.length, node->name.start);
+    context->indentLevel++;
+    context->coroutine = node;
+    context->resumePoints = 0;
+    emitLine(context, "switch (hc_co->hc_state)");
+    emitLine(context, "{");
+    emitLine(context, "case 0:;");
     generateBlock(context, (AstBlock *)node->body);
+    emitLine(context, "}");
+    emitLine(context, "hc_co->hc_state = -1;");
+    emitLine(context, "return 0;");
+    context->coroutine = NULL;
+    context->indentLevel--;
+    fprintf(context->output, "}\n");
+}
+
+// Generate code for a function declaration
+static void generateFunctionDecl(CodeGenContext *context, AstFunctionDecl *node)
+{
+    if (node->coroutine)
+    {
+        generateCoroutine(context, node);
+        return;
+    }
+
+    // Function header
+    generateFunctionSpecifiers(context, node);
+    generateFunctionSignature(context, node);
+    fprintf(context->output, " ");
+
+    // Function body
+    if (!node->spawns)
+    {
+        generateBlock(context, (AstBlock *)node->body);
+        return;
+    }
+
+    // The frame's cleanup joins the tasks still running when the function
+    // returns, so their records and results never outlive it
+    AstBlock *body = (AstBlock *)node->body;
+    fprintf(context->output, "{\n");
+    context->indentLevel++;
+    context->taskFrame = true;
+    emitLine(context, "hc_task_frame hc_frame HC_CLEANUP(hc_task_sync) = {0};");
+    for (int i = 0; i < body->count; i++)
+    {
+        generateDeclaration(context, body->statements[i]);
+    }
+    context->taskFrame = false;
+    context->indentLevel--;
+    fprintf(context->output, "}\n");
 }
 
 // Generate code for a statement
@@ -170,35 +1243,135 @@ static void generateStatement(CodeGenContext *context, AstNode *node)
     case AST_EXPRESSION_STMT:
         generateExpressionStatement(context, (AstExpressionStmt *)node);
         break;
+    case AST_YIELD:
+        generateYield(context, (AstYield *)node);
+        break;
+    case AST_MEASURE:
+        generateMeasure(context, (AstMeasure *)node);
+        break;
+    case AST_SYNC:
+        // Without a frame there is nothing to wait for
+        emitLine(context, context->taskFrame ? "hc_task_sync(&hc_frame);" : ";");
+        break;
     default:
         fprintf(stderr, "Unknown statement type in code generation.\n");
         break;
     }
 }
 
-// Generate code for a block statement
+// Generate code for a block statement. A क्षेत्र block borrows an arena
+// for its containers and strings and hands it back reset on every way out.
 static void generateBlock(CodeGenContext *context, AstBlock *node)
 {
     emitIndentation(context);
     fprintf(context->output, "{\n");
 
     context->indentLevel++;
+    if (node->region)
+    {
+        context->regionDepth++;
+        emitLine(context, "hc_arena *hc_region_%d HC_CLEANUP(hc_region_leave) = hc_region_enter();",
+                 context->regionDepth);
+    }
     for (int i = 0; i < node->count; i++)
     {
         generateDeclaration(context, node->statements[i]);
     }
+    if (node->region)
+    {
+        context->regionDepth--;
+    }
     context->indentLevel--;
 
     emitIndentation(context);
     fprintf(context->output, "}\n");
 }
 
+// Check whether an expression is the literal 0
+static bool isZeroLiteral(AstNode *node)
+{
+    if (node == NULL || node->type != AST_LITERAL)
+        return false;
+
+    Token value = ((AstLiteral *)node)->value;
+    if (value.type != TOKEN_NUMBER)
+        return false;
+
+    for (int i = 0; i < value.length; i++)
+    {
+        if (value.start[i] != '0' && value.start[i] != '.')
+            return false;
+    }
+    return true;
+}
+
+// Static branch prediction for an if statement without a source hint
+static BranchHint predictBranch(AstIf *node)
+{
+    // Error handling is rare: the branch that reports an error is unlikely
+    if (isColdPath(node->thenBranch))
+        return BRANCH_HINT_UNLIKELY;
+    if (isColdPath(node->elseBranch))
+        return BRANCH_HINT_LIKELY;
+
+    // Error-shaped tests: a call whose result is compared with 0 usually
+    // returns a count or success, not zero. Other values, such as n % 2,
+    // are zero too often to guess.
+    if (node->condition->type == AST_BINARY)
+    {
+        AstBinary *binary = (AstBinary *)node->condition;
+        if ((isZeroLiteral(binary->left) && binary->right->type == AST_CALL) ||
+            (isZeroLiteral(binary->right) && binary->left->type == AST_CALL))
+        {
+            if (binary->operator== TOKEN_EQUALS)
+                return BRANCH_HINT_UNLIKELY;
+            if (binary->operator== TOKEN_NOT_EQUALS)
+                return BRANCH_HINT_LIKELY;
+        }
+    }
+
+    return BRANCH_HINT_NONE;
+}
+
+// Generate a condition wrapped in HC_LIKELY/HC_UNLIKELY as hinted
+static void generateCondition(CodeGenContext *context, AstNode *condition, BranchHint hint)
+{
+    switch (hint)
+    {
+    case BRANCH_HINT_LIKELY:
+        fprintf(context->output, "HC_LIKELY(");
+        break;
+    case BRANCH_HINT_UNLIKELY:
+        fprintf(context->output, "HC_UNLIKELY(");
+        break;
+    default:
+        generateExpression(context, condition);
+        return;
+    }
+
+    generateExpression(context, condition);
+    fprintf(context->output, ")");
+}
+
 // Generate code for an if statement
 static void generateIfStatement(CodeGenContext *context, AstIf *node)
 {
+    BranchHint hint = node->hint != BRANCH_HINT_NONE ? node->hint : predictBranch(node);
+
     emitIndentation(context);
     fprintf(context->output, "if (");
-    generateExpression(context, node->condition);
+    if (node->outcome >= 0)
+    {
+        // Range analysis decided the condition, so the C compiler drops the
+        // dead branch; the condition stays as the operand that is never
+        // evaluated
+        fprintf(context->output, "%s", node->outcome ? "1 || " : "0 && ");
+        generateExpression(context, node->condition);
+    }
+    else
+    {
+        generateCondition(context, node->condition, hint);
+    }
     fprintf(context->output, ") ");
 
     generateStatement(context, node->thenBranch);
@@ -214,9 +1387,12 @@ static void generateIfStatement(CodeGenContext *context, AstIf *node)
 // Generate code for a while statement
 static void generateWhileStatement(CodeGenContext *context, AstWhile *node)
 {
+    // Loop back-edges are taken far more often than not
+    BranchHint hint = node->hint != BRANCH_HINT_NONE ? node->hint : BRANCH_HINT_LIKELY;
+
     emitIndentation(context);
     fprintf(context->output, "while (");
-    generateExpression(context, node->condition);
+    generateCondition(context, node->condition, hint);
     fprintf(context->output, ") ");
 
     generateStatement(context, node->body);
@@ -234,9 +1410,11 @@ static void generateForStatement(CodeGenContext *context, AstFor *node)
         if (node->initializer->type == AST_VAR_DECL)
         {
             AstVarDecl *varDecl = (AstVarDecl *)node->initializer;
-            fprintf(context->output, "%s %.*s",
-                    getTypeString(varDecl->varType),
-                    varDecl->name.length, varDecl->name.start);
+            if (!isFrameVariable(context, varDecl->name))
+            {
+                fprintf(context->output, "%s ", getTypeString(varDecl->varType));
+            }
+            emitVariableName(context, varDecl->name);
 
             if (varDecl->initializer != NULL)
             {
@@ -244,51 +1422,271 @@ static void generateForStatement(CodeGenContext *context, AstFor *node)
                 generateExpression(context, varDecl->initializer);
             }
         }
-        else
+        else
+        {
+            generateExpression(context, node->initializer);
+        }
+    }
+    fprintf(context->output, "; ");
+
+    // Condition (the loop back-edge, so likely taken)
+    if (node->condition != NULL)
+    {
+        generateCondition(context, node->condition, BRANCH_HINT_LIKELY);
+    }
+    fprintf(context->output, "; ");
+
+    // Increment
+    if (node->increment != NULL)
+    {
+        generateExpression(context, node->increment);
+    }
+    fprintf(context->output, ") ");
+
+    generateStatement(context, node->body);
+}
+
+// Generate code for a return statement
+static void generateReturnStatement(CodeGenContext *context, AstReturn *node)
+{
+    // A coroutine that returns is finished
+    if (context->coroutine != NULL)
+    {
+        emitLine(context, "hc_co->hc_state = -1;");
+        emitLine(context, "return 0;");
+        return;
+    }
+
+    emitIndentation(context);
+    fprintf(context->output, "return");
+
+    if (node->value != NULL)
+    {
+        fprintf(context->output, " ");
+        generateOwnedValue(context, node->value);
+    }
+
+    fprintf(context->output, ";\n");
+}
+
+// Generate code for an expression statement
+static void generateExpressionStatement(CodeGenContext *context, AstExpressionStmt *node)
+{
+    emitIndentation(context);
+
+    // A new string nobody stores is released straight away
+    if (node->expression->temporary)
+    {
+        fprintf(context->output, "hc_str_drop(");
+        generateExpression(context, node->expression);
+        fprintf(context->output, ");\n");
+        return;
+    }
+
+    // A value computed inside मापो and dropped is consumed, so the work that
+    // produced it is measured rather than removed
+    if (context->measureDepth > 0 && node->expression->type != AST_ASSIGNMENT &&
+        isScalarType(node->expression->dataType))
+    {
+        fprintf(context->output, "HC_BENCH_KEEP(");
+        generateExpression(context, node->expression);
+        fprintf(context->output, ");\n");
+        return;
+    }
+
+    generateExpression(context, node->expression);
+    fprintf(context->output, ";\n");
+}
+
+// Variables by name, without repeats
+typedef struct
+{
+    Token *names;
+    int count;
+    int capacity;
+} NameSet;
+
+static bool nameSetContains(const NameSet *set, Token name)
+{
+    for (int i = 0; i < set->count; i++)
+    {
+        if (set->names[i].length == name.length && memcmp(set->names[i].start, name.start, name.length) == 0)
+            return true;
+    }
+    return false;
+}
+
+static void nameSetAdd(NameSet *set, Token name)
+{
+    if (nameSetContains(set, name))
+        return;
+    if (set->count == set->capacity)
+    {
+        set->capacity = set->capacity < 8 ? 8 : set->capacity * 2;
+        set->names = (Token *)realloc(set->names, sizeof(Token) * set->capacity);
+    }
+    set->names[set->count++] = name;
+}
+
+// Collect the scalar variables a मापो body reads or writes into used, and
+// the variables it declares into declared
+static void collectMeasured(AstNode *node, NameSet *used, NameSet *declared)
+{
+    if (node == NULL)
+        return;
+
+    switch (node->type)
+    {
+    case AST_BLOCK:
+    {
+        AstBlock *block = (AstBlock *)node;
+        for (int i = 0; i < block->count; i++)
+        {
+            collectMeasured(block->statements[i], used, declared);
+        }
+        break;
+    }
+    case AST_VAR_DECL:
+        nameSetAdd(declared, ((AstVarDecl *)node)->name);
+        collectMeasured(((AstVarDecl *)node)->initializer, used, declared);
+        break;
+    case AST_IF:
+    {
+        AstIf *ifStmt = (AstIf *)node;
+        collectMeasured(ifStmt->condition, used, declared);
+        collectMeasured(ifStmt->thenBranch, used, declared);
+        collectMeasured(ifStmt->elseBranch, used, declared);
+        break;
+    }
+    case AST_WHILE:
+        collectMeasured(((AstWhile *)node)->condition, used, declared);
+        collectMeasured(((AstWhile *)node)->body, used, declared);
+        break;
+    case AST_FOR:
+    {
+        AstFor *forStmt = (AstFor *)node;
+        collectMeasured(forStmt->initializer, used, declared);
+        collectMeasured(forStmt->condition, used, declared);
+        collectMeasured(forStmt->increment, used, declared);
+        collectMeasured(forStmt->body, used, declared);
+        break;
+    }
+    case AST_EXPRESSION_STMT:
+        collectMeasured(((AstExpressionStmt *)node)->expression, used, declared);
+        break;
+    case AST_MEASURE:
+        collectMeasured(((AstMeasure *)node)->runs, used, declared);
+        collectMeasured(((AstMeasure *)node)->body, used, declared);
+        break;
+    case AST_BINARY:
+        collectMeasured(((AstBinary *)node)->left, used, declared);
+        collectMeasured(((AstBinary *)node)->right, used, declared);
+        break;
+    case AST_UNARY:
+        collectMeasured(((AstUnary *)node)->right, used, declared);
+        break;
+    case AST_VARIABLE:
+        if (isScalarType(node->dataType) && ((AstVariable *)node)->constant == NULL)
+        {
+            nameSetAdd(used, ((AstVariable *)node)->name);
+        }
+        break;
+    case AST_ASSIGNMENT:
+    {
+        AstAssignment *assignment = (AstAssignment *)node;
+        if (assignment->index == NULL && isScalarType(node->dataType))
         {
-            generateExpression(context, node->initializer);
+            nameSetAdd(used, assignment->name);
         }
+        collectMeasured(assignment->index, used, declared);
+        collectMeasured(assignment->value, used, declared);
+        break;
     }
-    fprintf(context->output, "; ");
-
-    // Condition
-    if (node->condition != NULL)
+    case AST_INDEX:
+        collectMeasured(((AstIndex *)node)->index, used, declared);
+        break;
+    case AST_CALL:
     {
-        generateExpression(context, node->condition);
+        AstCall *call = (AstCall *)node;
+        for (int i = 0; i < call->argCount; i++)
+        {
+            collectMeasured(call->arguments[i], used, declared);
+        }
+        break;
     }
-    fprintf(context->output, "; ");
+    case AST_SPAWN:
+        collectMeasured((AstNode *)((AstSpawn *)node)->call, used, declared);
+        break;
+    default:
+        break;
+    }
+}
 
-    // Increment
-    if (node->increment != NULL)
+// Make the variables from outside the body that it refers to opaque to the
+// C compiler at this point
+static void emitOpaqueVariables(CodeGenContext *context, const NameSet *used, const NameSet *declared)
+{
+    for (int i = 0; i < used->count; i++)
     {
-        generateExpression(context, node->increment);
+        if (nameSetContains(declared, used->names[i]))
+            continue;
+        emitIndentation(context);
+        fprintf(context->output, "HC_BENCH_OPAQUE(");
+        emitVariableName(context, used->names[i]);
+        fprintf(context->output, ");\n");
     }
-    fprintf(context->output, ") ");
-
-    generateStatement(context, node->body);
 }
 
-// Generate code for a return statement
-static void generateReturnStatement(CodeGenContext *context, AstReturn *node)
+// मापो (runs) { body }: a warm-up and then runs timed iterations of body,
+// reported as fastest, median and 99th percentile. The variables the body
+// shares with the code around it are opaque on both sides of every
+// iteration, so the C compiler can neither hoist the body's work out of the
+// loop nor drop it as unused.
+static void generateMeasure(CodeGenContext *context, AstMeasure *node)
 {
+    NameSet used = {NULL, 0, 0};
+    NameSet declared = {NULL, 0, 0};
+    collectMeasured(node->body, &used, &declared);
+
+    int bench = ++context->measureDepth;
+    emitLine(context, "{");
+    context->indentLevel++;
+
     emitIndentation(context);
-    fprintf(context->output, "return");
+    fprintf(context->output, "hc_bench hc_bench_%d = hc_bench_begin(", bench);
+    generateExpression(context, node->runs);
+    fprintf(context->output, ", %d);\n", node->base.line);
+    emitLine(context, "while (hc_bench_next(&hc_bench_%d))", bench);
+    emitLine(context, "{");
+    context->indentLevel++;
+    emitOpaqueVariables(context, &used, &declared);
+    generateStatement(context, node->body);
+    emitOpaqueVariables(context, &used, &declared);
+    context->indentLevel--;
+    emitLine(context, "}");
+    emitLine(context, "hc_bench_report(&hc_bench_%d);", bench);
 
-    if (node->value != NULL)
-    {
-        fprintf(context->output, " ");
-        generateExpression(context, node->value);
-    }
+    context->indentLevel--;
+    emitLine(context, "}");
+    context->measureDepth--;
 
-    fprintf(context->output, ";\n");
+    free(used.names);
+    free(declared.names);
 }
 
-// Generate code for an expression statement
-static void generateExpressionStatement(CodeGenContext *context, AstExpressionStmt *node)
+// Generate a value that is about to be stored. Stores own their strings, so
+// a string that is already stored elsewhere gets a new reference.
+static void generateOwnedValue(CodeGenContext *context, AstNode *node)
 {
-    emitIndentation(context);
-    generateExpression(context, node->expression);
-    fprintf(context->output, ";\n");
+    if (node->dataType == TOKEN_TEXT && !node->temporary)
+    {
+        fprintf(context->output, "hc_str_copy(");
+        generateExpression(context, node);
+        fprintf(context->output, ")");
+        return;
+    }
+
+    generateExpression(context, node);
 }
 
 // Generate code for an expression
@@ -314,6 +1712,12 @@ static void generateExpression(CodeGenContext *context, AstNode *node)
     case AST_CALL:
         generateCall(context, (AstCall *)node);
         break;
+    case AST_INDEX:
+        generateIndex(context, (AstIndex *)node);
+        break;
+    case AST_SPAWN:
+        generateSpawn(context, (AstSpawn *)node, NULL);
+        break;
     default:
         fprintf(stderr, "Unknown expression type in code generation.\n");
         break;
@@ -321,10 +1725,107 @@ static void generateExpression(CodeGenContext *context, AstNode *node)
 }
 
 // Generate code for a binary expression
+// The hc_checked.h function a पूर्णांक operation goes through with
+// --checked-arith, or NULL when range analysis proved it safe. Global
+// initializers stay plain C constant expressions.
+static const char *checkedOperation(CodeGenContext *context, AstBinary *node)
+{
+    if (!context->checkedArith || node->base.dataType != TOKEN_INT || node->proven || context->indentLevel == 0)
+        return NULL;
+
+    switch (node->operator)
+    {
+    case TOKEN_PLUS:
+        return "hc_checked_add";
+    case TOKEN_MINUS:
+        return "hc_checked_sub";
+    case TOKEN_MULTIPLY:
+        return "hc_checked_mul";
+    case TOKEN_DIVIDE:
+        return "hc_checked_div";
+    case TOKEN_MODULO:
+        return "hc_checked_mod";
+    default:
+        return NULL;
+    }
+}
+
 static void generateBinary(CodeGenContext *context, AstBinary *node)
 {
+    if (node->base.dataType == TOKEN_TEXT)
+    {
+        // Literals concatenated with literals are joined at compile time
+        if (isStringConstant((AstNode *)node))
+        {
+            generateStringConstant(context, (AstNode *)node, false);
+            return;
+        }
+
+        // The whole chain a + b + c becomes one concatenation with one allocation
+        ConcatOperands operands = {0, NULL, 0, 0};
+        if (context->regionDepth > 0)
+        {
+            fprintf(context->output, "hc_str_concat_in(hc_region_%d, (hc_str[]){", context->regionDepth);
+        }
+        else
+        {
+            fprintf(context->output, "hc_str_concat((hc_str[]){");
+        }
+        generateConcatOperands(context, (AstNode *)node, &operands);
+        flushConcatLiterals(context, &operands);
+        fprintf(context->output, "}, %d)", operands.count);
+        free(operands.pending);
+        return;
+    }
+
+    // Operands that are not negative divide without the sign fix-ups of
+    // signed division
+    if (node->nonNegative && (node->operator== TOKEN_DIVIDE || node->operator== TOKEN_MODULO))
+    {
+        fprintf(context->output, "((int)((unsigned)");
+        generateExpression(context, node->left);
+        fprintf(context->output, " %s (unsigned)", node->operator== TOKEN_DIVIDE ? "/" : "%");
+        generateExpression(context, node->right);
+        fprintf(context->output, "))");
+        return;
+    }
+
+    const char *checked = checkedOperation(context, node);
+    if (checked != NULL)
+    {
+        fprintf(context->output, "%s(", checked);
+        generateExpression(context, node->left);
+        fprintf(context->output, ", ");
+        generateExpression(context, node->right);
+        fprintf(context->output, ", %d)", node->base.line);
+        return;
+    }
+
+    // Strings compare by content
+    bool strings = node->left->dataType == TOKEN_TEXT;
+    if (strings && (node->operator== TOKEN_EQUALS || node->operator== TOKEN_NOT_EQUALS))
+    {
+        fprintf(context->output, "%shc_str_equal(", node->operator== TOKEN_NOT_EQUALS ? "!" : "");
+        generateExpression(context, node->left);
+        fprintf(context->output, ", ");
+        generateExpression(context, node->right);
+        fprintf(context->output, ")");
+        return;
+    }
+
     fprintf(context->output, "(");
-    generateExpression(context, node->left);
+    if (strings)
+    {
+        fprintf(context->output, "hc_str_compare(");
+        generateExpression(context, node->left);
+        fprintf(context->output, ", ");
+        generateExpression(context, node->right);
+        fprintf(context->output, ")");
+    }
+    else
+    {
+        generateExpression(context, node->left);
+    }
 
     // Output the operator
     switch (node->operator)
@@ -373,13 +1874,68 @@ static void generateBinary(CodeGenContext *context, AstBinary *node)
         break;
     }
 
-    generateExpression(context, node->right);
+    if (strings)
+    {
+        fprintf(context->output, "0");
+    }
+    else
+    {
+        generateExpression(context, node->right);
+    }
     fprintf(context->output, ")");
 }
 
+// Emit the literals collected since the last non-literal operand as one operand
+static void flushConcatLiterals(CodeGenContext *context, ConcatOperands *operands)
+{
+    if (operands->pendingSize == 0)
+        return;
+
+    fprintf(context->output, "%s", operands->count > 0 ? ", " : "");
+    generateStringView(context, operands->pending, operands->pendingSize, false);
+    operands->count++;
+    operands->pendingSize = 0;
+}
+
+// Emit the operands of a concatenation chain, comma-separated. Adjacent
+// literals, even across the chain's nesting, are merged into one.
+static void generateConcatOperands(CodeGenContext *context, AstNode *node, ConcatOperands *operands)
+{
+    if (node->type == AST_BINARY && node->dataType == TOKEN_TEXT)
+    {
+        AstBinary *binary = (AstBinary *)node;
+        generateConcatOperands(context, binary->left, operands);
+        generateConcatOperands(context, binary->right, operands);
+        return;
+    }
+
+    if (node->type == AST_LITERAL)
+    {
+        AstLiteral *literal = (AstLiteral *)node;
+        decodeStringLiteral(literal->value.start + 1, literal->value.length - 2, &operands->pending,
+                            &operands->pendingSize, &operands->pendingCapacity);
+        return;
+    }
+
+    flushConcatLiterals(context, operands);
+    fprintf(context->output, "%s", operands->count > 0 ? ", " : "");
+    generateExpression(context, node);
+    operands->count++;
+}
+
 // Generate code for a unary expression
 static void generateUnary(CodeGenContext *context, AstUnary *node)
 {
+    // --checked-arith: -INT_MIN overflows
+    if (context->checkedArith && node->operator== TOKEN_MINUS && node->base.dataType == TOKEN_INT &&
+        !node->proven && context->indentLevel > 0)
+    {
+        fprintf(context->output, "hc_checked_neg(");
+        generateExpression(context, node->right);
+        fprintf(context->output, ", %d)", node->base.line);
+        return;
+    }
+
     // Output the operator
     switch (node->operator)
     {
@@ -389,6 +1945,11 @@ static void generateUnary(CodeGenContext *context, AstUnary *node)
     case TOKEN_NOT:
         fprintf(context->output, "!");
         break;
+    case TOKEN_INT:
+    case TOKEN_FLOAT:
+    case TOKEN_CHAR:
+        fprintf(context->output, "((%s)", getTypeString(node->operator));
+        break;
     default:
         fprintf(stderr, "Unknown unary operator in code generation.\n");
         break;
@@ -396,7 +1957,7 @@ static void generateUnary(CodeGenContext *context, AstUnary *node)
 
     generateExpression(context, node->right);
 
-    if (node->operator== TOKEN_MINUS)
+    if (node->operator!= TOKEN_NOT)
     {
         fprintf(context->output, ")");
     }
@@ -410,9 +1971,12 @@ static void generateLiteral(CodeGenContext *context, AstLiteral *node)
     {
     case TOKEN_NUMBER:
         fprintf(context->output, "%.*s", node->value.length, node->value.start);
+        // Decimal literals are doubles in C unless suffixed
+        if (context->singlePrecision && memchr(node->value.start, '.', node->value.length) != NULL)
+            fprintf(context->output, "f");
         break;
     case TOKEN_STRING:
-        fprintf(context->output, "\"%.*s\"", node->value.length - 2, node->value.start + 1);
+        generateStringConstant(context, (AstNode *)node, false);
         break;
     default:
         fprintf(stderr, "Unknown literal type in code generation.\n");
@@ -420,36 +1984,243 @@ static void generateLiteral(CodeGenContext *context, AstLiteral *node)
     }
 }
 
+// Emit a const char * to the given bytes: an entry of the literal table, or a
+// literal in place when there is no table
+static void generateStringBytes(CodeGenContext *context, const char *bytes, int length)
+{
+    if (context->strings != NULL)
+    {
+        fprintf(context->output, "hc_strings.s%d", internString(context->strings, bytes, length));
+        return;
+    }
+
+    fprintf(context->output, "\"");
+    writeEscapedString(context->output, bytes, length);
+    fprintf(context->output, "\"");
+}
+
+// Emit a पाठ view of the given bytes (a static initializer for globals)
+static void generateStringView(CodeGenContext *context, const char *bytes, int length, bool initializer)
+{
+    fprintf(context->output, initializer ? "HC_STR_VIEW_INIT(" : "HC_STR_VIEW(");
+    generateStringBytes(context, bytes, length);
+    fprintf(context->output, ", %d)", length);
+}
+
+// Collect the bytes of a literal or a concatenation of literals
+static void foldStringConstant(AstNode *node, char **bytes, int *size, int *capacity)
+{
+    if (node->type == AST_BINARY)
+    {
+        foldStringConstant(((AstBinary *)node)->left, bytes, size, capacity);
+        foldStringConstant(((AstBinary *)node)->right, bytes, size, capacity);
+        return;
+    }
+    if (node->type == AST_VARIABLE)
+    {
+        foldStringConstant(((AstVariable *)node)->constant->initializer, bytes, size, capacity);
+        return;
+    }
+
+    Token value = ((AstLiteral *)node)->value;
+    decodeStringLiteral(value.start + 1, value.length - 2, bytes, size, capacity);
+}
+
+// Generate a literal or a concatenation of literals as one static string
+static void generateStringConstant(CodeGenContext *context, AstNode *node, bool initializer)
+{
+    char *bytes = NULL;
+    int size = 0;
+    int capacity = 0;
+    foldStringConstant(node, &bytes, &size, &capacity);
+    generateStringView(context, bytes, size, initializer);
+    free(bytes);
+}
+
 // Generate code for a variable reference
 static void generateVariable(CodeGenContext *context, AstVariable *node)
 {
-    fprintf(context->output, "%.*s", node->name.length, node->name.start);
+    if (node->constant != NULL)
+    {
+        emitConstantValue(context, node->constant);
+        return;
+    }
+    emitVariableName(context, node->name);
 }
 
 // Generate code for an assignment
 static void generateAssignment(CodeGenContext *context, AstAssignment *node)
 {
-    fprintf(context->output, "%.*s = ", node->name.length, node->name.start);
+    // Assigning a list moves the source's storage instead of copying it
+    if (node->base.dataType == TOKEN_LIST)
+    {
+        fprintf(context->output, "hc_list_move(&%.*s, &", node->name.length, node->name.start);
+        generateExpression(context, node->value);
+        fprintf(context->output, ")");
+        return;
+    }
+
+    // Strings release the value they replace
+    if (node->base.dataType == TOKEN_TEXT)
+    {
+        fprintf(context->output, "hc_str_assign(");
+        if (node->index != NULL)
+        {
+            fprintf(context->output, "hc_list_at(&%.*s, ", node->name.length, node->name.start);
+            generateExpression(context, node->index);
+            fprintf(context->output, ")");
+        }
+        else
+        {
+            fprintf(context->output, "&%.*s", node->name.length, node->name.start);
+        }
+        fprintf(context->output, ", ");
+        generateOwnedValue(context, node->value);
+        fprintf(context->output, ")");
+        return;
+    }
+
+    if (node->index != NULL)
+    {
+        fprintf(context->output, "(*hc_list_at(&%.*s, ", node->name.length, node->name.start);
+        generateExpression(context, node->index);
+        fprintf(context->output, ")) = ");
+        generateExpression(context, node->value);
+        return;
+    }
+
+    if (node->value->type == AST_SPAWN)
+    {
+        generateSpawn(context, (AstSpawn *)node->value, &node->name);
+        return;
+    }
+
+    emitVariableName(context, node->name);
+    fprintf(context->output, " = ");
+    generateExpression(context, node->value);
+}
+
+// Generate code for a list element; the runtime checks the bounds
+static void generateIndex(CodeGenContext *context, AstIndex *node)
+{
+    fprintf(context->output, "(*hc_list_at(&%.*s, ", node->name.length, node->name.start);
+    generateExpression(context, node->index);
+    fprintf(context->output, "))");
+}
+
+// Generate कार्य f(args), storing the result in the variable named by result
+// if there is one. Spawns in the function body keep their task record in the
+// body's block; spawns in nested blocks or loops get one from the heap.
+static void generateSpawn(CodeGenContext *context, AstSpawn *node, Token *result)
+{
+    Token name = node->call->name;
+    fprintf(context->output, "hc_spawn_%.*s(&hc_frame, ", name.length, name.start);
+    if (node->heapTask)
+    {
+        fprintf(context->output, "NULL");
+    }
+    else
+    {
+        fprintf(context->output, "&(hc_task_%.*s){0}", name.length, name.start);
+    }
+
+    if (node->base.dataType != TOKEN_VOID)
+    {
+        if (result != NULL)
+        {
+            fprintf(context->output, ", &%.*s", result->length, result->start);
+        }
+        else
+        {
+            fprintf(context->output, ", NULL");
+        }
+    }
+
+    for (int i = 0; i < node->call->argCount; i++)
+    {
+        fprintf(context->output, ", ");
+        generateExpression(context, node->call->arguments[i]);
+    }
+    fprintf(context->output, ")");
+}
+
+// Generate रोको_और_दो: store the value, remember where to resume and return
+// to the caller; resuming jumps to the label that follows
+static void generateYield(CodeGenContext *context, AstYield *node)
+{
+    int point = ++context->resumePoints;
+    emitIndentation(context);
+    fprintf(context->output, "hc_co->hc_value = ");
     generateExpression(context, node->value);
+    fprintf(context->output, ";\n");
+    emitLine(context, "hc_co->hc_state = %d;", point);
+    emitLine(context, "return 1;");
+    emitLine(context, "case %d:;", point);
 }
 
 // Generate code for a function call
 static void generateCall(CodeGenContext *context, AstCall *node)
 {
-    // Map Hindi standard library names to C functions
-    if (node->name.length == 4 && strncmp(node->name.start, "लिखो", 4) == 0)
+    // अगला resumes a coroutine; मान reads the value it yielded last
+    if (node->coroutine != NULL && tokenIs(node->name, "अगला"))
     {
-        fprintf(context->output, "printf");
+        fprintf(context->output, "hc_co_%.*s_resume(&", node->coroutine->name.length, node->coroutine->name.start);
+        generateExpression(context, node->arguments[0]);
+        fprintf(context->output, ")");
+        return;
     }
-    else if (node->name.length == 3 && strncmp(node->name.start, "पढ़ो", 3) == 0)
+    if (node->coroutine != NULL && tokenIs(node->name, "मान"))
     {
-        fprintf(context->output, "scanf");
+        fprintf(context->output, "(");
+        generateExpression(context, node->arguments[0]);
+        fprintf(context->output, ").hc_value");
+        return;
     }
-    else
+
+    // तालिका_पढ़ो passes its column and list pairs as an array of descriptors
+    if (tokenIs(node->name, "तालिका_पढ़ो"))
+    {
+        fprintf(context->output, "hc_csv_read(");
+        generateExpression(context, node->arguments[0]);
+        fprintf(context->output, ", (char)%d, (hc_csv_column[]){", delimiterOf(node->arguments[1]));
+        for (int i = 2; i < node->argCount; i += 2)
+        {
+            fprintf(context->output, "%sHC_CSV_COLUMN(", i > 2 ? ", " : "");
+            generateExpression(context, node->arguments[i]);
+            fprintf(context->output, ", &");
+            generateExpression(context, node->arguments[i + 1]);
+            fprintf(context->output, ")");
+        }
+        fprintf(context->output, "}, %d)", node->argCount / 2 - 1);
+        return;
+    }
+
+    const char *builtin = NULL;
+    for (int i = 0; builtinLowerings[i].name != NULL; i++)
+    {
+        if (tokenIs(node->name, builtinLowerings[i].name) &&
+            (builtinLowerings[i].firstArg == TOKEN_ERROR ||
+             (node->argCount > 0 && node->arguments[0]->dataType == builtinLowerings[i].firstArg)))
+        {
+            builtin = builtinLowerings[i].cName;
+            break;
+        }
+    }
+
+    if (tokenIs(node->name, "लिखो") || tokenIs(node->name, "पढ़ो"))
     {
-        fprintf(context->output, "%.*s", node->name.length, node->name.start);
+        generateFormatCall(context, node, builtin);
+        return;
     }
 
+    if (builtin != NULL)
+    {
+        fprintf(context->output, "%s", builtin);
+    }
+    else
+    {
+        emitFunctionName(context, node->name);
+    }
     fprintf(context->output, "(");
 
     // Output the arguments
@@ -460,8 +2231,127 @@ static void generateCall(CodeGenContext *context, AstCall *node)
             fprintf(context->output, ", ");
         }
 
+        // The last argument of an atomic operation names its memory order
+        if (i == node->argCount - 1 && builtin != NULL && node->arguments[0]->dataType == TOKEN_ATOMIC)
+        {
+            fprintf(context->output, "%s", getMemoryOrderString(memoryOrderOf(node->arguments[i])));
+            continue;
+        }
+
+        // A field delimiter is searched for as a single byte
+        if (i == 1 && builtin != NULL && node->arguments[0]->dataType == TOKEN_FILE)
+        {
+            fprintf(context->output, "(char)%d", delimiterOf(node->arguments[i]));
+            continue;
+        }
+
+        // Runtime functions take containers, atomics and files by address
+        if (node->arguments[i]->dataType == TOKEN_MAP || node->arguments[i]->dataType == TOKEN_LIST ||
+            node->arguments[i]->dataType == TOKEN_CHANNEL || node->arguments[i]->dataType == TOKEN_ATOMIC ||
+            node->arguments[i]->dataType == TOKEN_FILE)
+        {
+            fprintf(context->output, "&");
+        }
+
         generateExpression(context, node->arguments[i]);
     }
 
     fprintf(context->output, ")");
-}
\ No newline at end of file
+}
+
+// Pass a string to printf as the length and pointer a %.*s conversion takes
+static void generateStringArgument(CodeGenContext *context, AstNode *node)
+{
+    fprintf(context->output, "(int)(");
+    generateExpression(context, node);
+    fprintf(context->output, ").length, hc_str_bytes((const hc_str[]){");
+    generateExpression(context, node);
+    fprintf(context->output, "})");
+}
+
+// Generate a call to printf or scanf. Strings need not be NUL-terminated, so
+// the %s conversion of each string argument becomes %.*s. Text printed
+// without conversions is written with fwrite.
+static void generateFormatCall(CodeGenContext *context, AstCall *node, const char *cName)
+{
+    AstNode *format = node->arguments[0];
+    if (!isStringConstant(format))
+    {
+        // A string printed on its own
+        fprintf(context->output, "%s(", cName);
+        generateStringBytes(context, "%.*s", 4);
+        fprintf(context->output, ", ");
+        generateStringArgument(context, format);
+        fprintf(context->output, ")");
+        return;
+    }
+
+    char *text = NULL;
+    int length = 0;
+    int capacity = 0;
+    foldStringConstant(format, &text, &length, &capacity);
+
+    // Folded literals are printed verbatim, single literals once their %% are undone
+    if (strcmp(cName, "printf") == 0 && node->argCount == 1 &&
+        (format->type != AST_LITERAL || nextFormatConversion(text, length, 0) < 0))
+    {
+        int size = length;
+        if (format->type == AST_LITERAL)
+        {
+            size = 0;
+            for (int i = 0; i < length; i++)
+            {
+                text[size++] = text[i];
+                if (text[i] == '%' && i + 1 < length && text[i + 1] == '%')
+                    i++;
+            }
+        }
+
+        fprintf(context->output, "fwrite(");
+        generateStringBytes(context, text, size);
+        fprintf(context->output, ", 1, %d, stdout)", size);
+        free(text);
+        return;
+    }
+
+    // Room for a .* per argument
+    char *rewritten = (char *)malloc(length + 2 * node->argCount);
+    int rewrittenLength = 0;
+    int written = 0;
+    int position = -1;
+    for (int i = 1; i < node->argCount; i++)
+    {
+        position = nextFormatConversion(text, length, position + 1);
+        if (position < 0)
+            break;
+
+        if (node->arguments[i]->dataType == TOKEN_TEXT)
+        {
+            for (; written < position; written++)
+                rewritten[rewrittenLength++] = text[written];
+            rewritten[rewrittenLength++] = '.';
+            rewritten[rewrittenLength++] = '*';
+        }
+    }
+    for (; written < length; written++)
+        rewritten[rewrittenLength++] = text[written];
+
+    fprintf(context->output, "%s(", cName);
+    generateStringBytes(context, rewritten, rewrittenLength);
+    free(rewritten);
+    free(text);
+
+    for (int i = 1; i < node->argCount; i++)
+    {
+        fprintf(context->output, ", ");
+        if (node->arguments[i]->dataType == TOKEN_TEXT)
+        {
+            generateStringArgument(context, node->arguments[i]);
+        }
+        else
+        {
+            generateExpression(context, node->arguments[i]);
+        }
+    }
+    fprintf(context->output, ")");
+}
@@ -0,0 +1,292 @@
+/* src/codegen/string_pool.c */
+#include "../../include/codegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Initialize an empty pool
+void initStringPool(StringPool *pool)
+{
+    pool->entries = NULL;
+    pool->count = 0;
+    pool->capacity = 0;
+    pool->slots = NULL;
+    pool->slotCount = 0;
+}
+
+// Free the pool and the strings in it
+void freeStringPool(StringPool *pool)
+{
+    for (int i = 0; i < pool->count; i++)
+    {
+        free(pool->entries[i].bytes);
+    }
+    free(pool->entries);
+    free(pool->slots);
+    initStringPool(pool);
+}
+
+// FNV-1a hash of a byte string
+static unsigned int hashBytes(const char *bytes, int length)
+{
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++)
+    {
+        hash = (hash ^ (unsigned char)bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Rebuild the hash index with room for twice as many strings
+static void growSlots(StringPool *pool)
+{
+    free(pool->slots);
+    pool->slotCount = pool->slotCount == 0 ? 64 : pool->slotCount * 2;
+    pool->slots = (int *)malloc(sizeof(int) * pool->slotCount);
+    for (int i = 0; i < pool->slotCount; i++)
+    {
+        pool->slots[i] = -1;
+    }
+
+    for (int i = 0; i < pool->count; i++)
+    {
+        unsigned int slot = hashBytes(pool->entries[i].bytes, pool->entries[i].length);
+        while (pool->slots[slot & (pool->slotCount - 1)] >= 0)
+            slot++;
+        pool->slots[slot & (pool->slotCount - 1)] = i;
+    }
+}
+
+// Add bytes to the pool unless an equal string is already there; returns its index
+int internString(StringPool *pool, const char *bytes, int length)
+{
+    // Keep the index at most half full
+    if (pool->count * 2 >= pool->slotCount)
+    {
+        growSlots(pool);
+    }
+
+    unsigned int slot = hashBytes(bytes, length);
+    for (;; slot++)
+    {
+        int index = pool->slots[slot & (pool->slotCount - 1)];
+        if (index < 0)
+            break;
+
+        PooledString *entry = &pool->entries[index];
+        if (entry->length == length && (length == 0 || memcmp(entry->bytes, bytes, length) == 0))
+            return index;
+    }
+
+    if (pool->count == pool->capacity)
+    {
+        pool->capacity = pool->capacity == 0 ? 16 : pool->capacity * 2;
+        pool->entries = (PooledString *)realloc(pool->entries, sizeof(PooledString) * pool->capacity);
+    }
+
+    PooledString *entry = &pool->entries[pool->count];
+    // The empty string has no bytes to copy, and may come with a NULL pointer
+    entry->bytes = (char *)malloc(length > 0 ? length : 1);
+    if (length > 0)
+        memcpy(entry->bytes, bytes, length);
+    entry->length = length;
+
+    pool->slots[slot & (pool->slotCount - 1)] = pool->count;
+    return pool->count++;
+}
+
+// Append one byte to a growable buffer
+static void appendByte(char **bytes, int *size, int *capacity, char byte)
+{
+    if (*size == *capacity)
+    {
+        *capacity = *capacity == 0 ? 64 : *capacity * 2;
+        *bytes = (char *)realloc(*bytes, *capacity);
+    }
+    (*bytes)[(*size)++] = byte;
+}
+
+// Value of a hexadecimal digit, or -1
+static int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// Append a code point as UTF-8
+static void appendCodePoint(char **bytes, int *size, int *capacity, unsigned long c)
+{
+    if (c < 0x80)
+    {
+        appendByte(bytes, size, capacity, (char)c);
+    }
+    else if (c < 0x800)
+    {
+        appendByte(bytes, size, capacity, (char)(0xC0 | (c >> 6)));
+        appendByte(bytes, size, capacity, (char)(0x80 | (c & 0x3F)));
+    }
+    else if (c < 0x10000)
+    {
+        appendByte(bytes, size, capacity, (char)(0xE0 | (c >> 12)));
+        appendByte(bytes, size, capacity, (char)(0x80 | ((c >> 6) & 0x3F)));
+        appendByte(bytes, size, capacity, (char)(0x80 | (c & 0x3F)));
+    }
+    else
+    {
+        appendByte(bytes, size, capacity, (char)(0xF0 | (c >> 18)));
+        appendByte(bytes, size, capacity, (char)(0x80 | ((c >> 12) & 0x3F)));
+        appendByte(bytes, size, capacity, (char)(0x80 | ((c >> 6) & 0x3F)));
+        appendByte(bytes, size, capacity, (char)(0x80 | (c & 0x3F)));
+    }
+}
+
+// Append the bytes a C string literal's text (without quotes) denotes
+void decodeStringLiteral(const char *text, int length, char **bytes, int *size, int *capacity)
+{
+    for (int i = 0; i < length; i++)
+    {
+        if (text[i] != '\\' || i + 1 == length)
+        {
+            appendByte(bytes, size, capacity, text[i]);
+            continue;
+        }
+
+        char c = text[++i];
+        switch (c)
+        {
+        case 'n':
+            appendByte(bytes, size, capacity, '\n');
+            break;
+        case 't':
+            appendByte(bytes, size, capacity, '\t');
+            break;
+        case 'r':
+            appendByte(bytes, size, capacity, '\r');
+            break;
+        case 'a':
+            appendByte(bytes, size, capacity, '\a');
+            break;
+        case 'b':
+            appendByte(bytes, size, capacity, '\b');
+            break;
+        case 'f':
+            appendByte(bytes, size, capacity, '\f');
+            break;
+        case 'v':
+            appendByte(bytes, size, capacity, '\v');
+            break;
+        case 'x':
+        {
+            // As in C, a hexadecimal escape takes every hex digit that follows
+            unsigned int value = 0;
+            while (i + 1 < length && hexValue(text[i + 1]) >= 0)
+            {
+                value = value * 16 + (unsigned int)hexValue(text[++i]);
+            }
+            appendByte(bytes, size, capacity, (char)value);
+            break;
+        }
+        case 'u':
+        case 'U':
+        {
+            unsigned long value = 0;
+            int digits = c == 'u' ? 4 : 8;
+            for (int d = 0; d < digits && i + 1 < length && hexValue(text[i + 1]) >= 0; d++)
+            {
+                value = value * 16 + (unsigned long)hexValue(text[++i]);
+            }
+            appendCodePoint(bytes, size, capacity, value);
+            break;
+        }
+        default:
+            if (c >= '0' && c <= '7')
+            {
+                // Up to three octal digits
+                unsigned int value = (unsigned int)(c - '0');
+                for (int d = 1; d < 3 && i + 1 < length && text[i + 1] >= '0' && text[i + 1] <= '7'; d++)
+                {
+                    value = value * 8 + (unsigned int)(text[++i] - '0');
+                }
+                appendByte(bytes, size, capacity, (char)value);
+            }
+            else
+            {
+                // \\, \", \', \? and unknown escapes stand for the character itself
+                appendByte(bytes, size, capacity, c);
+            }
+            break;
+        }
+    }
+}
+
+// Write bytes as the contents of a C string literal, without the quotes.
+// UTF-8 is written as is so the generated code stays readable.
+void writeEscapedString(FILE *output, const char *bytes, int length)
+{
+    for (int i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char)bytes[i];
+        switch (c)
+        {
+        case '\n':
+            fputs("\\n", output);
+            break;
+        case '\t':
+            fputs("\\t", output);
+            break;
+        case '\r':
+            fputs("\\r", output);
+            break;
+        case '"':
+            fputs("\\\"", output);
+            break;
+        case '\\':
+            fputs("\\\\", output);
+            break;
+        case '?':
+            // Keep ?? from forming a trigraph
+            fputs(i > 0 && bytes[i - 1] == '?' ? "\\?" : "?", output);
+            break;
+        default:
+            if (c < 0x20 || c == 0x7F)
+            {
+                // Always three digits, so a digit that follows is not absorbed
+                fprintf(output, "\\%03o", c);
+            }
+            else
+            {
+                fputc(c, output);
+            }
+            break;
+        }
+    }
+}
+
+// Write the pool as a static constant table named hc_strings. Each string is
+// a member array of its own, so the C compiler still checks the formats that
+// refer to it, while the table stays one contiguous object.
+void writeStringPool(FILE *output, StringPool *pool)
+{
+    if (pool->count == 0)
+        return;
+
+    fprintf(output, "// String literals, each stored once\n");
+    fprintf(output, "static const struct\n{\n");
+    for (int i = 0; i < pool->count; i++)
+    {
+        fprintf(output, "    char s%d[%d];\n", i, pool->entries[i].length + 1);
+    }
+    fprintf(output, "} hc_strings = {\n");
+    for (int i = 0; i < pool->count; i++)
+    {
+        fprintf(output, "    \"");
+        writeEscapedString(output, pool->entries[i].bytes, pool->entries[i].length);
+        fprintf(output, "\",\n");
+    }
+    fprintf(output, "};\n\n");
+}
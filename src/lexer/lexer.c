@@ -16,7 +16,13 @@ static const KeywordMap hindiKeywords[] = {
     {"पूर्णांक", TOKEN_INT},
     {"दशमलव", TOKEN_FLOAT},
     {"वर्ण", TOKEN_CHAR},
+    {"पाठ", TOKEN_TEXT},
     {"शून्य", TOKEN_VOID},
+    {"शब्दकोश", TOKEN_MAP},
+    {"सूची", TOKEN_LIST},
+    {"नलिका", TOKEN_CHANNEL},
+    {"परमाणु", TOKEN_ATOMIC},
+    {"संचिका", TOKEN_FILE},
     {"अगर", TOKEN_IF},
     {"वरना", TOKEN_ELSE},
     {"दौर", TOKEN_FOR},
@@ -25,6 +31,16 @@ static const KeywordMap hindiKeywords[] = {
     {"रुको", TOKEN_BREAK},
     {"जारी", TOKEN_CONTINUE},
     {"वापस", TOKEN_RETURN},
+    {"संभावित", TOKEN_LIKELY},
+    {"असंभावित", TOKEN_UNLIKELY},
+    {"कार्य", TOKEN_SPAWN},
+    {"प्रतीक्षा", TOKEN_SYNC},
+    {"सहक्रम", TOKEN_COROUTINE},
+    {"रोको_और_दो", TOKEN_YIELD},
+    {"क्षेत्र", TOKEN_REGION},
+    {"मापो", TOKEN_MEASURE},
+    {"सामान्य", TOKEN_GENERIC},
+    {"स्थिर", TOKEN_CONST},
     {NULL, 0} // End sentinel
 };
 
@@ -161,7 +177,8 @@ static bool isIdentifierStart(char c)
 
 static bool isIdentifierPart(char c)
 {
-    return isIdentifierStart(c) || isDigit(c);
+    // UTF-8 continuation bytes (0x80-0xBF) belong to the current Hindi character
+    return isIdentifierStart(c) || isDigit(c) || (unsigned char)c >= 0x80;
 }
 
 // Parse identifier and check if it's a keyword
@@ -178,7 +195,7 @@ static Token identifier(Lexer *lexer)
         const char *keyword = hindiKeywords[i].keyword;
         size_t length = strlen(keyword);
 
-        if (lexer->current - lexer->start == length &&
+        if ((size_t)(lexer->current - lexer->start) == length &&
             memcmp(lexer->start, keyword, length) == 0)
         {
             return makeToken(lexer, hindiKeywords[i].token);
@@ -281,6 +298,10 @@ Token scanToken(Lexer *lexer)
         return makeToken(lexer, TOKEN_LBRACE);
     case '}':
         return makeToken(lexer, TOKEN_RBRACE);
+    case '[':
+        return makeToken(lexer, TOKEN_LBRACKET);
+    case ']':
+        return makeToken(lexer, TOKEN_RBRACKET);
     case ';':
         return makeToken(lexer, TOKEN_SEMICOLON);
     case ',':
@@ -337,8 +358,20 @@ const char *getTokenName(TokenType type)
         return "FLOAT";
     case TOKEN_CHAR:
         return "CHAR";
+    case TOKEN_TEXT:
+        return "TEXT";
     case TOKEN_VOID:
         return "VOID";
+    case TOKEN_MAP:
+        return "MAP";
+    case TOKEN_LIST:
+        return "LIST";
+    case TOKEN_CHANNEL:
+        return "CHANNEL";
+    case TOKEN_ATOMIC:
+        return "ATOMIC";
+    case TOKEN_FILE:
+        return "FILE";
     case TOKEN_IF:
         return "IF";
     case TOKEN_ELSE:
@@ -355,6 +388,26 @@ const char *getTokenName(TokenType type)
         return "CONTINUE";
     case TOKEN_RETURN:
         return "RETURN";
+    case TOKEN_LIKELY:
+        return "LIKELY";
+    case TOKEN_UNLIKELY:
+        return "UNLIKELY";
+    case TOKEN_SPAWN:
+        return "SPAWN";
+    case TOKEN_SYNC:
+        return "SYNC";
+    case TOKEN_COROUTINE:
+        return "COROUTINE";
+    case TOKEN_YIELD:
+        return "YIELD";
+    case TOKEN_REGION:
+        return "REGION";
+    case TOKEN_MEASURE:
+        return "MEASURE";
+    case TOKEN_GENERIC:
+        return "GENERIC";
+    case TOKEN_CONST:
+        return "CONST";
     case TOKEN_IDENTIFIER:
         return "IDENTIFIER";
     case TOKEN_NUMBER:
@@ -403,9 +456,34 @@ const char *getTokenName(TokenType type)
         return "LBRACE";
     case TOKEN_RBRACE:
         return "RBRACE";
+    case TOKEN_LBRACKET:
+        return "LBRACKET";
+    case TOKEN_RBRACKET:
+        return "RBRACKET";
     case TOKEN_ERROR:
         return "ERROR";
     default:
         return "UNKNOWN";
     }
-}
\ No newline at end of file
+}
+
+// Index of the conversion character of the first printf conversion at or
+// after from, or -1 if there is none. "%%" is not a conversion.
+int nextFormatConversion(const char *text, int length, int from)
+{
+    for (int i = from; i < length; i++)
+    {
+        if (text[i] != '%')
+            continue;
+
+        i++;
+        if (i < length && text[i] == '%')
+            continue;
+
+        // Flags, width, precision and length modifiers
+        while (i < length && strchr("-+ #0123456789.*hlLqjzt", text[i]) != NULL)
+            i++;
+        return i < length ? i : -1;
+    }
+    return -1;
+}
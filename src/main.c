@@ -3,6 +3,7 @@
 #include "../include/parser.h"
 #include "../include/ast.h"
 #include "../include/semantic.h"
+#include "../include/analysis.h"
 #include "../include/codegen.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -53,9 +54,11 @@ static char *readFile(const char *path)
 static char *getOutputPath(const char *inputPath, const char *newExt)
 {
     // Get the base name (without extension)
-    char *baseName = strdup(inputPath);
+    char *baseName = (char *)malloc(strlen(inputPath) + 1);
+    strcpy(baseName, inputPath);
     char *dot = strrchr(baseName, '.');
-    if (dot != NULL)
+    char *slash = strrchr(baseName, '/');
+    if (dot != NULL && (slash == NULL || dot > slash))
     {
         *dot = '\0';
     }
@@ -80,6 +83,18 @@ static void printUsage(const char *programName)
     printf("  -o <output-file>   Specify output file (default: input-file.c)\n");
     printf("  -t                 Tokenize only (output tokens to stdout)\n");
     printf("  -p                 Parse only (no code generation)\n");
+    printf("  --dump-callgraph=dot|json\n");
+    printf("                     Print the call graph to stdout (no code generation)\n");
+    printf("  --dump-ranges      Print the value ranges of पूर्णांक variables and operations\n");
+    printf("                     to stdout (no code generation)\n");
+    printf("  --stack-report     Print the estimated stack use of every function and the\n");
+    printf("                     deepest call paths to stdout (no code generation)\n");
+    printf("  --stack-limit=N    Warn when a call path may use more than N bytes of stack\n");
+    printf("  -fsingle-precision Make decimal literals floats instead of doubles\n");
+    printf("  --checked-arith    Stop with the source line when पूर्णांक arithmetic overflows\n");
+    printf("                     or divides by zero\n");
+    printf("  --split=N          Split output into N translation units plus a shared\n");
+    printf("                     header and a makefile snippet (output-file.h/.mk)\n");
     printf("  -h                 Display this help message\n");
 }
 
@@ -95,8 +110,16 @@ int main(int argc, char *argv[])
     // Parse command-line options
     char *inputPath = NULL;
     char *outputPath = NULL;
+    bool ownsOutputPath = false;
     bool tokenizeOnly = false;
     bool parseOnly = false;
+    int splitParts = 0;
+    bool singlePrecision = false;
+    bool checkedArith = false;
+    const char *callGraphFormat = NULL;
+    bool dumpRanges = false;
+    bool stackReport = false;
+    long stackLimit = 0;
 
     for (int i = 1; i < argc; i++)
     {
@@ -120,6 +143,49 @@ int main(int argc, char *argv[])
         {
             parseOnly = true;
         }
+        else if (strcmp(argv[i], "-fsingle-precision") == 0)
+        {
+            singlePrecision = true;
+        }
+        else if (strcmp(argv[i], "--checked-arith") == 0)
+        {
+            checkedArith = true;
+        }
+        else if (strncmp(argv[i], "--split=", 8) == 0)
+        {
+            splitParts = atoi(argv[i] + 8);
+            if (splitParts < 1)
+            {
+                fprintf(stderr, "Error: --split requires a positive number of files.\n");
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--dump-callgraph=", 17) == 0)
+        {
+            callGraphFormat = argv[i] + 17;
+            if (strcmp(callGraphFormat, "dot") != 0 && strcmp(callGraphFormat, "json") != 0)
+            {
+                fprintf(stderr, "Error: --dump-callgraph expects 'dot' or 'json'.\n");
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--dump-ranges") == 0)
+        {
+            dumpRanges = true;
+        }
+        else if (strcmp(argv[i], "--stack-report") == 0)
+        {
+            stackReport = true;
+        }
+        else if (strncmp(argv[i], "--stack-limit=", 14) == 0)
+        {
+            stackLimit = atol(argv[i] + 14);
+            if (stackLimit < 1)
+            {
+                fprintf(stderr, "Error: --stack-limit requires a positive number of bytes.\n");
+                return 1;
+            }
+        }
         else if (strcmp(argv[i], "-h") == 0)
         {
             printUsage(argv[0]);
@@ -153,6 +219,7 @@ int main(int argc, char *argv[])
     if (outputPath == NULL)
     {
         outputPath = getOutputPath(inputPath, ".c");
+        ownsOutputPath = true;
     }
 
     // Initialize the lexer
@@ -201,6 +268,7 @@ int main(int argc, char *argv[])
     SymbolTable symbolTable;
     SemanticContext semanticContext;
     initSemanticAnalyzer(&semanticContext, &symbolTable);
+    semanticContext.singlePrecision = singlePrecision;
 
     bool semanticSuccess = analyzeProgram(&semanticContext, &symbolTable, program);
 
@@ -214,30 +282,113 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Whole-program analysis used for optimization hints
+    CallGraph callGraph;
+    buildCallGraph(&callGraph, program);
+
+    // Value ranges let code generation leave out checks and decided branches
+    analyzeRanges(program, dumpRanges && callGraphFormat == NULL ? stdout : NULL);
+
+    // Suffixed literals cannot mix precisions
+    if (!singlePrecision && callGraphFormat == NULL && !dumpRanges && !stackReport)
+    {
+        checkLoopPrecision(&callGraph);
+    }
+
+    // Worst-case stack use along the call graph
+    if (stackReport || stackLimit > 0)
+    {
+        StackUsage *stackUsage =
+            (StackUsage *)malloc(sizeof(StackUsage) * (callGraph.count > 0 ? callGraph.count : 1));
+        analyzeStackUsage(&callGraph, stackUsage);
+        if (stackReport && callGraphFormat == NULL)
+        {
+            dumpStackReport(&callGraph, stackUsage, stdout);
+        }
+        if (stackLimit > 0)
+        {
+            checkStackLimit(&callGraph, stackUsage, stackLimit);
+        }
+        free(stackUsage);
+    }
+
+    if (callGraphFormat != NULL || dumpRanges || stackReport)
+    {
+        if (callGraphFormat != NULL && strcmp(callGraphFormat, "dot") == 0)
+            dumpCallGraphDot(&callGraph, stdout);
+        else if (callGraphFormat != NULL)
+            dumpCallGraphJson(&callGraph, stdout);
+
+        freeCallGraph(&callGraph);
+        freeAst((AstNode *)program);
+        freeSymbolTable(&symbolTable);
+        free(source);
+        if (ownsOutputPath)
+        {
+            free(outputPath);
+        }
+        return 0;
+    }
+
+    CodeGenContext codeGenContext;
+
+    // Split code generation writes its own set of files next to the output path
+    if (splitParts > 0)
+    {
+        char *basePath = getOutputPath(outputPath, "");
+        initCodeGen(&codeGenContext, NULL);
+        codeGenContext.callGraph = &callGraph;
+        codeGenContext.singlePrecision = singlePrecision;
+        codeGenContext.checkedArith = checkedArith;
+
+        bool splitSuccess = generateSplitCode(&codeGenContext, program, basePath, splitParts);
+        if (splitSuccess)
+        {
+            printf("Code generation successful! Output written to '%s.h', '%s_*.c' and '%s.mk'.\n",
+                   basePath, basePath, basePath);
+        }
+
+        free(basePath);
+        freeCallGraph(&callGraph);
+        freeAst((AstNode *)program);
+        freeSymbolTable(&symbolTable);
+        free(source);
+        if (ownsOutputPath)
+        {
+            free(outputPath);
+        }
+        return splitSuccess ? 0 : 1;
+    }
+
     // Code generation
     FILE *outputFile = fopen(outputPath, "w");
     if (outputFile == NULL)
     {
         fprintf(stderr, "Error: Could not open output file '%s'.\n", outputPath);
+        freeCallGraph(&callGraph);
         freeAst((AstNode *)program);
         freeSymbolTable(&symbolTable);
         free(source);
         return 1;
     }
 
-    CodeGenContext codeGenContext;
     initCodeGen(&codeGenContext, outputFile);
+    codeGenContext.callGraph = &callGraph;
+    codeGenContext.singlePrecision = singlePrecision;
+    codeGenContext.checkedArith = checkedArith;
 
     generateCode(&codeGenContext, program);
 
     printf("Code generation successful! Output written to '%s'.\n", outputPath);
+    printCompileFlags(&codeGenContext, program, outputPath);
 
     fclose(outputFile);
+    freeCallGraph(&callGraph);
     freeAst((AstNode *)program);
     freeSymbolTable(&symbolTable);
     free(source);
-    if (outputPath != argv[2])
-    { // If we allocated it
+    if (ownsOutputPath)
+    {
         free(outputPath);
     }
 
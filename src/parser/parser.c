@@ -7,13 +7,23 @@
 // Forward declarations for recursive descent parsing
 static AstNode *declaration(Parser *parser);
 static AstNode *varDeclaration(Parser *parser, TokenType type);
+static AstNode *constantDeclaration(Parser *parser);
+static AstNode *mapDeclaration(Parser *parser);
+static AstNode *listDeclaration(Parser *parser);
+static AstNode *channelDeclaration(Parser *parser);
 static AstFunctionDecl *functionDeclaration(Parser *parser, TokenType returnType);
+static AstFunctionDecl *genericDeclaration(Parser *parser);
 static AstNode *statement(Parser *parser);
 static AstBlock *blockStatement(Parser *parser);
+static BranchHint branchHint(Parser *parser);
 static AstNode *ifStatement(Parser *parser);
 static AstNode *whileStatement(Parser *parser);
 static AstNode *forStatement(Parser *parser);
 static AstNode *returnStatement(Parser *parser);
+static AstNode *syncStatement(Parser *parser);
+static AstNode *yieldStatement(Parser *parser);
+static AstNode *regionStatement(Parser *parser);
+static AstNode *measureStatement(Parser *parser);
 static AstNode *expressionStatement(Parser *parser);
 static AstNode *expression(Parser *parser);
 static AstNode *assignment(Parser *parser);
@@ -39,6 +49,7 @@ void initParser(Parser *parser, Lexer *lexer)
     parser->lexer = lexer;
     parser->hadError = false;
     parser->panicMode = false;
+    parser->typeParamCount = 0;
     advance(parser); // Load the first token
 }
 
@@ -132,29 +143,112 @@ AstProgram *parse(Parser *parser)
 
     while (!check(parser, TOKEN_EOF))
     {
-        AstNode *decl = declaration(parser);
-        if (decl != NULL)
+        // Generic functions are kept apart; semantic analysis adds their
+        // instances to the declarations
+        if (match(parser, TOKEN_GENERIC))
         {
-            // Add the declaration to the program
-            if (program->count >= program->capacity)
+            AstFunctionDecl *generic = genericDeclaration(parser);
+            if (generic != NULL)
             {
-                program->capacity = program->capacity * 2;
-                program->declarations = realloc(program->declarations,
-                                                sizeof(AstNode *) * program->capacity);
+                if (program->genericCount >= program->genericCapacity)
+                {
+                    program->genericCapacity = program->genericCapacity == 0 ? 4 : program->genericCapacity * 2;
+                    program->generics = realloc(program->generics,
+                                                sizeof(AstFunctionDecl *) * program->genericCapacity);
+                }
+                program->generics[program->genericCount++] = generic;
             }
-            program->declarations[program->count++] = decl;
+            continue;
+        }
+
+        AstNode *decl = declaration(parser);
+        if (decl != NULL)
+        {
+            addDeclaration(program, decl);
         }
     }
 
     return program;
 }
 
+// Index of the type parameter name refers to in the generic function being
+// parsed, or -1
+static int typeParameter(Parser *parser, Token name)
+{
+    for (int i = 0; i < parser->typeParamCount; i++)
+    {
+        if (parser->typeParams[i].length == name.length &&
+            memcmp(parser->typeParams[i].start, name.start, name.length) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Parse a variable declared with a type parameter: T name = value;
+static AstNode *typeParameterDeclaration(Parser *parser)
+{
+    int typeParam = typeParameter(parser, parser->previous);
+    AstNode *node = varDeclaration(parser, TOKEN_ERROR);
+    if (node != NULL)
+    {
+        ((AstVarDecl *)node)->typeParam = typeParam;
+    }
+    return node;
+}
+
 // Parse a declaration (var or function)
 static AstNode *declaration(Parser *parser)
 {
+    // Container declarations
+    if (match(parser, TOKEN_MAP))
+    {
+        return mapDeclaration(parser);
+    }
+    if (match(parser, TOKEN_LIST))
+    {
+        return listDeclaration(parser);
+    }
+    if (match(parser, TOKEN_CHANNEL))
+    {
+        return channelDeclaration(parser);
+    }
+    if (match(parser, TOKEN_ATOMIC))
+    {
+        return varDeclaration(parser, TOKEN_ATOMIC);
+    }
+    if (match(parser, TOKEN_FILE))
+    {
+        return varDeclaration(parser, TOKEN_FILE);
+    }
+    if (match(parser, TOKEN_CONST))
+    {
+        return constantDeclaration(parser);
+    }
+
+    // सहक्रम T name(params) { ... } declares a coroutine, सहक्रम name = f(...);
+    // a variable running one
+    if (match(parser, TOKEN_COROUTINE))
+    {
+        if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) ||
+            match(parser, TOKEN_CHAR) || match(parser, TOKEN_TEXT) ||
+            match(parser, TOKEN_VOID))
+        {
+            AstFunctionDecl *function = functionDeclaration(parser, parser->previous.type);
+            if (function != NULL)
+            {
+                function->coroutine = true;
+            }
+            return (AstNode *)function;
+        }
+        return varDeclaration(parser, TOKEN_COROUTINE);
+    }
+
     // Check for type specifier
     if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) ||
-        match(parser, TOKEN_CHAR) || match(parser, TOKEN_VOID))
+        match(parser, TOKEN_CHAR) || match(parser, TOKEN_TEXT) ||
+        match(parser, TOKEN_VOID))
     {
         TokenType type = parser->previous.type;
 
@@ -170,6 +264,13 @@ static AstNode *declaration(Parser *parser)
         }
     }
 
+    // Inside a generic function, a type parameter declares a variable
+    if (check(parser, TOKEN_IDENTIFIER) && typeParameter(parser, parser->current) >= 0)
+    {
+        advance(parser);
+        return typeParameterDeclaration(parser);
+    }
+
     return statement(parser);
 }
 
@@ -189,13 +290,152 @@ static AstNode *varDeclaration(Parser *parser, TokenType type)
 
     // Check for initializer
     AstNode *initializer = NULL;
+    AstNode **elements = NULL;
+    int elementCount = 0;
+    int elementCapacity = 0;
     if (match(parser, TOKEN_ASSIGN))
     {
-        initializer = expression(parser);
+        // A table of elements: name = [a, b, c];
+        if (match(parser, TOKEN_LBRACKET))
+        {
+            if (!check(parser, TOKEN_RBRACKET))
+            {
+                do
+                {
+                    if (elementCount >= elementCapacity)
+                    {
+                        elementCapacity = elementCapacity == 0 ? 8 : elementCapacity * 2;
+                        elements = (AstNode **)realloc(elements, sizeof(AstNode *) * elementCapacity);
+                    }
+                    elements[elementCount++] = expression(parser);
+                } while (match(parser, TOKEN_COMMA));
+            }
+            consume(parser, TOKEN_RBRACKET, "Expect ']' after elements.");
+        }
+        else
+        {
+            initializer = expression(parser);
+        }
     }
 
     consume(parser, TOKEN_SEMICOLON, "Expect ';' after variable declaration.");
-    return (AstNode *)createVarDecl(name, type, initializer);
+    AstVarDecl *node = createVarDecl(name, type, initializer);
+    node->elements = elements;
+    node->elementCount = elementCount;
+    node->elementCapacity = elementCapacity;
+    return (AstNode *)node;
+}
+
+// Parse a constant: स्थिर type name = value; for a number, character or
+// string type, or स्थिर सूची<type> name = [elements];
+static AstNode *constantDeclaration(Parser *parser)
+{
+    AstNode *node;
+    if (match(parser, TOKEN_LIST))
+    {
+        node = listDeclaration(parser);
+    }
+    else if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) ||
+             match(parser, TOKEN_CHAR) || match(parser, TOKEN_TEXT))
+    {
+        node = varDeclaration(parser, parser->previous.type);
+    }
+    else if (check(parser, TOKEN_IDENTIFIER) && typeParameter(parser, parser->current) >= 0)
+    {
+        advance(parser);
+        node = typeParameterDeclaration(parser);
+    }
+    else
+    {
+        parserError(parser, "Expect type after 'स्थिर'.");
+        return NULL;
+    }
+
+    if (node != NULL)
+    {
+        ((AstVarDecl *)node)->constant = true;
+    }
+    return node;
+}
+
+// Parse an element type inside a container's angle brackets
+static TokenType elementType(Parser *parser)
+{
+    if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) ||
+        match(parser, TOKEN_CHAR) || match(parser, TOKEN_TEXT))
+    {
+        return parser->previous.type;
+    }
+
+    parserError(parser, "Expect element type.");
+    return TOKEN_ERROR;
+}
+
+// Parse a map declaration: शब्दकोश<key, value> name;
+static AstNode *mapDeclaration(Parser *parser)
+{
+    consume(parser, TOKEN_LESS, "Expect '<' after 'शब्दकोश'.");
+    TokenType keyType = elementType(parser);
+    consume(parser, TOKEN_COMMA, "Expect ',' between key and value types.");
+    TokenType valueType = elementType(parser);
+    consume(parser, TOKEN_GREATER, "Expect '>' after value type.");
+
+    AstNode *node = varDeclaration(parser, TOKEN_MAP);
+    if (node != NULL)
+    {
+        ((AstVarDecl *)node)->keyType = keyType;
+        ((AstVarDecl *)node)->elemType = valueType;
+    }
+    return node;
+}
+
+// Parse a list declaration: सूची<element> name;
+static AstNode *listDeclaration(Parser *parser)
+{
+    consume(parser, TOKEN_LESS, "Expect '<' after 'सूची'.");
+    TokenType elemType = elementType(parser);
+    consume(parser, TOKEN_GREATER, "Expect '>' after element type.");
+
+    AstNode *node = varDeclaration(parser, TOKEN_LIST);
+    if (node != NULL)
+    {
+        ((AstVarDecl *)node)->elemType = elemType;
+    }
+    return node;
+}
+
+// Parse a channel declaration: नलिका<element> name; or नलिका<element, size> name;
+static AstNode *channelDeclaration(Parser *parser)
+{
+    consume(parser, TOKEN_LESS, "Expect '<' after 'नलिका'.");
+    TokenType elemType = elementType(parser);
+
+    int capacity = 0;
+    if (match(parser, TOKEN_COMMA))
+    {
+        if (consume(parser, TOKEN_NUMBER, "Expect buffer size."))
+        {
+            Token size = parser->previous;
+            for (int i = 0; i < size.length; i++)
+            {
+                if (size.start[i] < '0' || size.start[i] > '9')
+                {
+                    parserError(parser, "Buffer size must be a whole number.");
+                    break;
+                }
+                capacity = capacity < 100000000 ? capacity * 10 + (size.start[i] - '0') : capacity;
+            }
+        }
+    }
+    consume(parser, TOKEN_GREATER, "Expect '>' after element type.");
+
+    AstNode *node = varDeclaration(parser, TOKEN_CHANNEL);
+    if (node != NULL)
+    {
+        ((AstVarDecl *)node)->elemType = elemType;
+        ((AstVarDecl *)node)->capacity = capacity;
+    }
+    return node;
 }
 
 // Parse a function declaration
@@ -229,23 +469,32 @@ static AstFunctionDecl *functionDeclaration(Parser *parser, TokenType returnType
                 break;
             }
 
-            // Parameter type
+            // Parameter type, or a type parameter of a generic function
+            TokenType paramType = TOKEN_ERROR;
+            int typeParam = -1;
             if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) ||
-                match(parser, TOKEN_CHAR))
+                match(parser, TOKEN_CHAR) || match(parser, TOKEN_TEXT))
             {
-                TokenType paramType = parser->previous.type;
-
-                // Parameter name
-                if (consume(parser, TOKEN_IDENTIFIER, "Expect parameter name."))
-                {
-                    function->params[function->paramCount].type = paramType;
-                    function->params[function->paramCount].name = parser->previous;
-                    function->paramCount++;
-                }
+                paramType = parser->previous.type;
+            }
+            else if (check(parser, TOKEN_IDENTIFIER) && typeParameter(parser, parser->current) >= 0)
+            {
+                typeParam = typeParameter(parser, parser->current);
+                advance(parser);
             }
             else
             {
                 parserError(parser, "Expect parameter type.");
+                continue;
+            }
+
+            // Parameter name
+            if (consume(parser, TOKEN_IDENTIFIER, "Expect parameter name."))
+            {
+                function->params[function->paramCount].type = paramType;
+                function->params[function->paramCount].typeParam = typeParam;
+                function->params[function->paramCount].name = parser->previous;
+                function->paramCount++;
             }
         } while (match(parser, TOKEN_COMMA));
     }
@@ -259,6 +508,61 @@ static AstFunctionDecl *functionDeclaration(Parser *parser, TokenType returnType
     return function;
 }
 
+// Parse a generic function: सामान्य<T, ...> type name(params) { ... }. Inside
+// it, each type parameter can stand for the type of parameters, variables and
+// the result.
+static AstFunctionDecl *genericDeclaration(Parser *parser)
+{
+    consume(parser, TOKEN_LESS, "Expect '<' after 'सामान्य'.");
+    parser->typeParamCount = 0;
+    do
+    {
+        if (!consume(parser, TOKEN_IDENTIFIER, "Expect type parameter name."))
+            break;
+        if (typeParameter(parser, parser->previous) >= 0)
+        {
+            parserError(parser, "Type parameter is already declared.");
+            break;
+        }
+        if (parser->typeParamCount >= MAX_TYPE_PARAMS)
+        {
+            parserError(parser, "Too many type parameters.");
+            break;
+        }
+        parser->typeParams[parser->typeParamCount++] = parser->previous;
+    } while (match(parser, TOKEN_COMMA));
+    consume(parser, TOKEN_GREATER, "Expect '>' after type parameters.");
+
+    // Return type
+    TokenType returnType = TOKEN_ERROR;
+    int returnTypeParam = -1;
+    if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) ||
+        match(parser, TOKEN_CHAR) || match(parser, TOKEN_TEXT) ||
+        match(parser, TOKEN_VOID))
+    {
+        returnType = parser->previous.type;
+    }
+    else if (check(parser, TOKEN_IDENTIFIER) && typeParameter(parser, parser->current) >= 0)
+    {
+        returnTypeParam = typeParameter(parser, parser->current);
+        advance(parser);
+    }
+    else
+    {
+        parserError(parser, "Expect return type.");
+    }
+
+    AstFunctionDecl *function = functionDeclaration(parser, returnType);
+    if (function != NULL)
+    {
+        function->returnTypeParam = returnTypeParam;
+        function->typeParamCount = parser->typeParamCount;
+        memcpy(function->typeParams, parser->typeParams, sizeof(Token) * parser->typeParamCount);
+    }
+    parser->typeParamCount = 0;
+    return function;
+}
+
 // Parse a statement
 static AstNode *statement(Parser *parser)
 {
@@ -278,10 +582,26 @@ static AstNode *statement(Parser *parser)
     {
         return returnStatement(parser);
     }
+    if (match(parser, TOKEN_SYNC))
+    {
+        return syncStatement(parser);
+    }
+    if (match(parser, TOKEN_YIELD))
+    {
+        return yieldStatement(parser);
+    }
     if (match(parser, TOKEN_LBRACE))
     {
         return (AstNode *)blockStatement(parser);
     }
+    if (match(parser, TOKEN_REGION))
+    {
+        return regionStatement(parser);
+    }
+    if (match(parser, TOKEN_MEASURE))
+    {
+        return measureStatement(parser);
+    }
 
     return expressionStatement(parser);
 }
@@ -311,10 +631,21 @@ static AstBlock *blockStatement(Parser *parser)
     return block;
 }
 
+// Parse an optional संभावित/असंभावित hint in front of a condition
+static BranchHint branchHint(Parser *parser)
+{
+    if (match(parser, TOKEN_LIKELY))
+        return BRANCH_HINT_LIKELY;
+    if (match(parser, TOKEN_UNLIKELY))
+        return BRANCH_HINT_UNLIKELY;
+    return BRANCH_HINT_NONE;
+}
+
 // Parse an if statement
 static AstNode *ifStatement(Parser *parser)
 {
     consume(parser, TOKEN_LPAREN, "Expect '(' after 'if'.");
+    BranchHint hint = branchHint(parser);
     AstNode *condition = expression(parser);
     consume(parser, TOKEN_RPAREN, "Expect ')' after if condition.");
 
@@ -326,19 +657,24 @@ static AstNode *ifStatement(Parser *parser)
         elseBranch = statement(parser);
     }
 
-    return (AstNode *)createIf(condition, thenBranch, elseBranch);
+    AstIf *ifStmt = createIf(condition, thenBranch, elseBranch);
+    ifStmt->hint = hint;
+    return (AstNode *)ifStmt;
 }
 
 // Parse a while statement
 static AstNode *whileStatement(Parser *parser)
 {
     consume(parser, TOKEN_LPAREN, "Expect '(' after 'while'.");
+    BranchHint hint = branchHint(parser);
     AstNode *condition = expression(parser);
     consume(parser, TOKEN_RPAREN, "Expect ')' after while condition.");
 
     AstNode *body = statement(parser);
 
-    return (AstNode *)createWhile(condition, body);
+    AstWhile *whileStmt = createWhile(condition, body);
+    whileStmt->hint = hint;
+    return (AstNode *)whileStmt;
 }
 
 // Parse a for statement
@@ -353,10 +689,15 @@ static AstNode *forStatement(Parser *parser)
         // No initializer
     }
     else if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) ||
-             match(parser, TOKEN_CHAR))
+             match(parser, TOKEN_CHAR) || match(parser, TOKEN_TEXT))
     {
         initializer = varDeclaration(parser, parser->previous.type);
     }
+    else if (check(parser, TOKEN_IDENTIFIER) && typeParameter(parser, parser->current) >= 0)
+    {
+        advance(parser);
+        initializer = typeParameterDeclaration(parser);
+    }
     else
     {
         initializer = expressionStatement(parser);
@@ -397,6 +738,59 @@ static AstNode *returnStatement(Parser *parser)
     return (AstNode *)createReturn(value);
 }
 
+// Parse a प्रतीक्षा statement
+static AstNode *syncStatement(Parser *parser)
+{
+    Token keyword = parser->previous;
+    consume(parser, TOKEN_SEMICOLON, "Expect ';' after 'प्रतीक्षा'.");
+
+    AstSync *sync = createSync();
+    sync->base.line = keyword.line;
+    sync->base.column = keyword.column;
+    return (AstNode *)sync;
+}
+
+// Parse क्षेत्र { ... }
+static AstNode *regionStatement(Parser *parser)
+{
+    Token keyword = parser->previous;
+    consume(parser, TOKEN_LBRACE, "Expect '{' after 'क्षेत्र'.");
+
+    AstBlock *block = blockStatement(parser);
+    block->region = true;
+    block->base.line = keyword.line;
+    block->base.column = keyword.column;
+    return (AstNode *)block;
+}
+
+// Parse मापो (runs) { ... }
+static AstNode *measureStatement(Parser *parser)
+{
+    Token keyword = parser->previous;
+    consume(parser, TOKEN_LPAREN, "Expect '(' after 'मापो'.");
+    AstNode *runs = expression(parser);
+    consume(parser, TOKEN_RPAREN, "Expect ')' after the number of runs.");
+    consume(parser, TOKEN_LBRACE, "Expect '{' before the measured block.");
+
+    AstMeasure *measure = createMeasure(runs, (AstNode *)blockStatement(parser));
+    measure->base.line = keyword.line;
+    measure->base.column = keyword.column;
+    return (AstNode *)measure;
+}
+
+// Parse रोको_और_दो value;
+static AstNode *yieldStatement(Parser *parser)
+{
+    Token keyword = parser->previous;
+    AstNode *value = expression(parser);
+    consume(parser, TOKEN_SEMICOLON, "Expect ';' after yielded value.");
+
+    AstYield *yield = createYield(value);
+    yield->base.line = keyword.line;
+    yield->base.column = keyword.column;
+    return (AstNode *)yield;
+}
+
 // Parse an expression statement
 static AstNode *expressionStatement(Parser *parser)
 {
@@ -426,6 +820,16 @@ static AstNode *assignment(Parser *parser)
             return (AstNode *)createAssignment(name, value);
         }
 
+        if (expr->type == AST_INDEX)
+        {
+            // name[index] = value: reuse the index expression, drop its shell
+            AstIndex *element = (AstIndex *)expr;
+            AstAssignment *assign = createAssignment(element->name, value);
+            assign->index = element->index;
+            free(element);
+            return (AstNode *)assign;
+        }
+
         parserError(parser, "Invalid assignment target.");
     }
 
@@ -524,7 +928,7 @@ static AstNode *factor(Parser *parser)
     return expr;
 }
 
-// Parse unary (-, !)
+// Parse unary (-, !, कार्य)
 static AstNode *unary(Parser *parser)
 {
     if (match(parser, TOKEN_MINUS) || match(parser, TOKEN_NOT))
@@ -534,6 +938,18 @@ static AstNode *unary(Parser *parser)
         return (AstNode *)createUnary(op, right);
     }
 
+    // कार्य f(...): where it may appear is up to the semantic pass
+    if (match(parser, TOKEN_SPAWN))
+    {
+        AstNode *expr = call(parser);
+        if (expr == NULL || expr->type != AST_CALL)
+        {
+            parserError(parser, "Expect a function call after 'कार्य'.");
+            return expr;
+        }
+        return (AstNode *)createSpawn((AstCall *)expr);
+    }
+
     return call(parser);
 }
 
@@ -577,6 +993,21 @@ static AstNode *call(Parser *parser)
         return (AstNode *)call;
     }
 
+    if (match(parser, TOKEN_LBRACKET))
+    {
+        if (expr->type != AST_VARIABLE)
+        {
+            parserError(parser, "Can only index lists.");
+            return expr;
+        }
+
+        Token name = ((AstVariable *)expr)->name;
+        AstNode *index = expression(parser);
+        consume(parser, TOKEN_RBRACKET, "Expect ']' after index.");
+        free(expr);
+        return (AstNode *)createIndex(name, index);
+    }
+
     return expr;
 }
 
@@ -598,6 +1029,22 @@ static AstNode *primary(Parser *parser)
         return (AstNode *)createVariable(parser->previous);
     }
 
+    // Conversion: पूर्णांक(x), दशमलव(x) or वर्ण(x)
+    if (match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) || match(parser, TOKEN_CHAR))
+    {
+        Token type = parser->previous;
+        consume(parser, TOKEN_LPAREN, "Expect '(' after type in a conversion.");
+        AstNode *value = expression(parser);
+        consume(parser, TOKEN_RPAREN, "Expect ')' after conversion.");
+        if (value == NULL)
+            return NULL;
+
+        AstUnary *conversion = createUnary(type.type, value);
+        conversion->base.line = type.line;
+        conversion->base.column = type.column;
+        return (AstNode *)conversion;
+    }
+
     if (match(parser, TOKEN_LPAREN))
     {
         AstNode *expr = expression(parser);
@@ -1,5 +1,7 @@
 /* src/semantic/semantic.c */
 #include "../../include/semantic.h"
+#include <limits.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,26 +18,166 @@ static bool analyzeForStatement(SemanticContext *context, SymbolTable *table, As
 static bool analyzeReturnStatement(SemanticContext *context, SymbolTable *table, AstReturn *node);
 static bool analyzeExpressionStatement(SemanticContext *context, SymbolTable *table, AstExpressionStmt *node);
 static TokenType analyzeExpression(SemanticContext *context, SymbolTable *table, AstNode *node);
+static TokenType analyzeValue(SemanticContext *context, SymbolTable *table, AstNode *node);
+static bool checkWritable(SemanticContext *context, AstNode *node, Symbol *symbol);
 static TokenType analyzeBinary(SemanticContext *context, SymbolTable *table, AstBinary *node);
 static TokenType analyzeUnary(SemanticContext *context, SymbolTable *table, AstUnary *node);
 static TokenType analyzeLiteral(SemanticContext *context, SymbolTable *table, AstLiteral *node);
 static TokenType analyzeVariable(SemanticContext *context, SymbolTable *table, AstVariable *node);
 static TokenType analyzeAssignment(SemanticContext *context, SymbolTable *table, AstAssignment *node);
 static TokenType analyzeCall(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeGenericCall(SemanticContext *context, SymbolTable *table, AstCall *node,
+                                    AstFunctionDecl *generic);
+static void analyzeFormatArguments(SemanticContext *context, SymbolTable *table, AstCall *node,
+                                   bool reads);
+static TokenType analyzeIndex(SemanticContext *context, SymbolTable *table, AstIndex *node);
+static TokenType analyzeSpawn(SemanticContext *context, SymbolTable *table, AstSpawn *node);
+static void storeTaskResult(SemanticContext *context, AstNode *value, Symbol *symbol);
+static void analyzeSync(SymbolTable *table);
+static bool analyzeYield(SemanticContext *context, SymbolTable *table, AstYield *node);
+static bool analyzeMeasure(SemanticContext *context, SymbolTable *table, AstMeasure *node);
+static bool keepsCoroutine(AstFunctionDecl *coroutine, AstFunctionDecl *target, int depth);
+static TokenType analyzeMapPut(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeMapGet(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeMapContains(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeMapRemove(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeListPush(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeListPop(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeSize(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeStringLength(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeSlice(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeCharacterCount(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeCharacterAt(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeChannelSend(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeChannelReceive(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeAtomicLoad(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeAtomicStore(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeAtomicAdd(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeAtomicCompareExchange(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeCoroutineNext(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeCoroutineValue(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeFileOpen(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeFileNextLine(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeFileLine(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeFileNextField(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeFileField(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeTableRead(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeSort(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeSearch(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeTimeNano(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeRandom(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeRandomFill(SemanticContext *context, SymbolTable *table, AstCall *node);
+static TokenType analyzeRandomSeed(SemanticContext *context, SymbolTable *table, AstCall *node);
+
+// Builtin functions with their own type rules
+typedef struct
+{
+    const char *name;
+    int argCount; // -1 when analyze checks the count itself
+    TokenType (*analyze)(SemanticContext *context, SymbolTable *table, AstCall *node);
+} Builtin;
+
+static const Builtin builtins[] = {
+    {"रखो", 3, analyzeMapPut},       // रखो(map, key, value)
+    {"पाओ", 2, analyzeMapGet},       // पाओ(map, key)
+    {"है", 2, analyzeMapContains},   // है(map, key)
+    {"हटाओ", 2, analyzeMapRemove},   // हटाओ(map, key)
+    {"जोड़ो", 2, analyzeListPush},     // जोड़ो(list, value)
+    {"निकालो", 1, analyzeListPop},    // निकालो(list)
+    {"आकार", 1, analyzeSize},        // आकार(container)
+    {"लंबाई", 1, analyzeStringLength}, // लंबाई(string)
+    {"टुकड़ा", 3, analyzeSlice},        // टुकड़ा(string, start, length)
+    {"अक्षर_गिनती", 1, analyzeCharacterCount}, // अक्षर_गिनती(string)
+    {"अक्षर", 2, analyzeCharacterAt}, // अक्षर(string, index)
+    {"भेजो", 2, analyzeChannelSend},     // भेजो(channel, value)
+    {"लो", 1, analyzeChannelReceive},     // लो(channel)
+    {"परमाणु_पढ़ो", 2, analyzeAtomicLoad},  // परमाणु_पढ़ो(atomic, order)
+    {"परमाणु_लिखो", 3, analyzeAtomicStore}, // परमाणु_लिखो(atomic, value, order)
+    {"परमाणु_जोड़ो", 3, analyzeAtomicAdd},   // परमाणु_जोड़ो(atomic, value, order)
+    {"परमाणु_बदलो", 4, analyzeAtomicCompareExchange}, // परमाणु_बदलो(atomic, expected, desired, order)
+    {"अगला", 1, analyzeCoroutineNext},   // अगला(coroutine)
+    {"मान", 1, analyzeCoroutineValue},   // मान(coroutine)
+    {"खोलो", 1, analyzeFileOpen},          // खोलो(path)
+    {"अगली_पंक्ति", 1, analyzeFileNextLine}, // अगली_पंक्ति(file)
+    {"पंक्ति", 1, analyzeFileLine},          // पंक्ति(file)
+    {"अगला_खंड", 2, analyzeFileNextField},  // अगला_खंड(file, delimiter)
+    {"खंड", 1, analyzeFileField},           // खंड(file)
+    {"तालिका_पढ़ो", -1, analyzeTableRead},    // तालिका_पढ़ो(path, delimiter, column, list, ...)
+    {"क्रमबद्ध", 1, analyzeSort},             // क्रमबद्ध(list)
+    {"खोज", 2, analyzeSearch},               // खोज(list, value)
+    {"समय_नैनो", 0, analyzeTimeNano},         // समय_नैनो()
+    {"यादृच्छिक", 1, analyzeRandom},           // यादृच्छिक(bound)
+    {"यादृच्छिक_भरो", 3, analyzeRandomFill},   // यादृच्छिक_भरो(list, count, bound)
+    {"यादृच्छिक_बीज", 1, analyzeRandomSeed},   // यादृच्छिक_बीज(seed)
+    {NULL, 0, NULL} // End sentinel
+};
 
 // Current function for return type checking
 static TokenType currentFunctionReturnType = TOKEN_VOID;
 
+// Token lexemes are not NUL-terminated; copy one into a buffer for symbol lookups.
+// The symbol table copies names it keeps, so a single scratch buffer is enough.
+static const char *lexeme(Token token)
+{
+    static char buffer[256];
+    int length = token.length < (int)sizeof(buffer) - 1 ? token.length : (int)sizeof(buffer) - 1;
+    memcpy(buffer, token.start, length);
+    buffer[length] = '\0';
+    return buffer;
+}
+
 // Initialize the semantic analyzer
 void initSemanticAnalyzer(SemanticContext *context, SymbolTable *symbolTable)
 {
     context->errorCount = 0;
+    context->runtimeFeatures = 0;
+    context->temporaryAllowed = false;
+    context->formatString = false;
+    context->program = NULL;
+    context->function = NULL;
+    context->functionDepth = 0;
+    context->yieldCount = 0;
+    context->useCount = 0;
+    context->regionDepth = 0;
+    context->measureDepth = 0;
+    context->singlePrecision = false;
     initSymbolTable(symbolTable);
+
+    // Standard library functions take a format string and any number of arguments
+    defineFunction(symbolTable, "लिखो", TOKEN_INT, -1, NULL, 0, 0);
+    defineFunction(symbolTable, "पढ़ो", TOKEN_INT, -1, NULL, 0, 0);
+}
+
+// A generic function's type parameters are bound by the types of the
+// arguments, so each must be the type of a parameter
+static void checkGeneric(SemanticContext *context, AstFunctionDecl *generic)
+{
+    if (strcmp(lexeme(generic->name), "मुख्य") == 0)
+    {
+        semanticError(context, generic->base.line, generic->base.column,
+                      "The entry point cannot be generic.");
+    }
+
+    for (int k = 0; k < generic->typeParamCount; k++)
+    {
+        bool bound = false;
+        for (int i = 0; i < generic->paramCount; i++)
+        {
+            bound = bound || generic->params[i].typeParam == k;
+        }
+        if (!bound)
+        {
+            semanticError(context, generic->typeParams[k].line, generic->typeParams[k].column,
+                          "Every type parameter must be the type of a parameter.");
+        }
+    }
 }
 
 // Analyze the program
 bool analyzeProgram(SemanticContext *context, SymbolTable *symbolTable, AstProgram *program)
 {
+    context->program = program;
+
     // First pass: Register all global functions and variables
     for (int i = 0; i < program->count; i++)
     {
@@ -52,427 +194,2053 @@ bool analyzeProgram(SemanticContext *context, SymbolTable *symbolTable, AstProgr
                 paramTypes[j] = func->params[j].type;
             }
 
-            // Define the function in the symbol table
-            defineFunction(symbolTable, func->name.start, func->returnType,
+            // Define the function in the symbol table; calling a coroutine
+            // creates an instance of it
+            defineFunction(symbolTable, lexeme(func->name),
+                           func->coroutine ? TOKEN_COROUTINE : func->returnType,
                            func->paramCount, paramTypes, func->base.line, func->base.column);
 
             free(paramTypes); // Clean up
         }
     }
 
-    // Second pass: Analyze each declaration
-    for (int i = 0; i < program->count; i++)
+    // Generic functions are registered under their own name; each call
+    // checks its arguments against the generic parameters
+    for (int i = 0; i < program->genericCount; i++)
     {
-        if (!analyzeDeclaration(context, symbolTable, program->declarations[i]))
+        AstFunctionDecl *generic = program->generics[i];
+        checkGeneric(context, generic);
+
+        TokenType *paramTypes = malloc(sizeof(TokenType) * generic->paramCount);
+        for (int j = 0; j < generic->paramCount; j++)
         {
-            return false;
+            paramTypes[j] = generic->params[j].type;
         }
-    }
 
-    return context->errorCount == 0;
-}
+        Symbol *symbol = defineFunction(symbolTable, lexeme(generic->name), generic->returnType,
+                                        generic->paramCount, paramTypes, generic->base.line,
+                                        generic->base.column);
+        if (symbol != NULL)
+        {
+            symbol->generic = generic;
+        }
 
-// Analyze a declaration
-static bool analyzeDeclaration(SemanticContext *context, SymbolTable *table, AstNode *node)
-{
-    switch (node->type)
-    {
-    case AST_VAR_DECL:
-        return analyzeVarDecl(context, table, (AstVarDecl *)node);
-    case AST_FUNCTION_DECL:
-        return analyzeFunctionDecl(context, table, (AstFunctionDecl *)node);
-    default:
-        return analyzeStatement(context, table, node);
+        free(paramTypes);
     }
-}
 
-// Analyze a variable declaration
-static bool analyzeVarDecl(SemanticContext *context, SymbolTable *table, AstVarDecl *node)
-{
-    // Check if the variable has an initializer
-    TokenType initType = TOKEN_VOID;
-    if (node->initializer != NULL)
+    // Second pass: Analyze each declaration; instances of generic functions
+    // are appended while this runs and analyzed in turn
+    for (int i = 0; i < program->count; i++)
     {
-        initType = analyzeExpression(context, table, node->initializer);
-
-        // Check type compatibility
-        if (initType != node->varType && initType != TOKEN_ERROR)
+        if (!analyzeDeclaration(context, symbolTable, program->declarations[i]))
         {
-            semanticError(context, node->base.line, node->base.column,
-                          "Type mismatch in variable initialization.");
+            return false;
         }
     }
 
-    // Define the variable in the symbol table
-    Symbol *symbol = defineVariable(table, node->name.start, node->varType,
-                                    node->base.line, node->base.column);
+    // A coroutine frame cannot contain itself
+    for (int i = 0; i < program->count; i++)
+    {
+        AstNode *node = program->declarations[i];
+        if (node->type == AST_FUNCTION_DECL && ((AstFunctionDecl *)node)->coroutine &&
+            keepsCoroutine((AstFunctionDecl *)node, (AstFunctionDecl *)node, program->count))
+        {
+            semanticError(context, node->line, node->column,
+                          "A coroutine cannot keep an instance of itself across 'रोको_और_दो'.");
+        }
+    }
 
-    return symbol != NULL;
+    program->runtimeFeatures = context->runtimeFeatures;
+    return context->errorCount == 0;
 }
 
-// Analyze a function declaration
-static bool analyzeFunctionDecl(SemanticContext *context, SymbolTable *table, AstFunctionDecl *node)
+// Scalars are the types held by value: everything but containers
+static bool isScalarType(TokenType type)
 {
-    // Save the current function return type for return statement checking
-    TokenType previousReturnType = currentFunctionReturnType;
-    currentFunctionReturnType = node->returnType;
-
-    // Create a new scope for function parameters and body
-    beginScope(table);
+    return type == TOKEN_INT || type == TOKEN_FLOAT || type == TOKEN_CHAR || type == TOKEN_TEXT;
+}
 
-    // Define parameters in the new scope
-    for (int i = 0; i < node->paramCount; i++)
-    {
-        defineVariable(table, node->params[i].name.start, node->params[i].type,
-                       node->params[i].name.line, node->params[i].name.column);
-    }
+static bool isContainerType(TokenType type)
+{
+    return type == TOKEN_MAP || type == TOKEN_LIST;
+}
 
-    // Analyze function body
-    bool result = analyzeBlock(context, table, (AstBlock *)node->body);
+static bool isNumberType(TokenType type)
+{
+    return type == TOKEN_INT || type == TOKEN_FLOAT;
+}
 
-    // End scope and restore previous function return type
-    endScope(table);
-    currentFunctionReturnType = previousReturnType;
+// Whether a value of type from can be stored where type to is expected.
+// Integers widen to decimals; every other conversion must be written out,
+// as in पूर्णांक(x).
+static bool promotes(TokenType from, TokenType to)
+{
+    return from == to || (from == TOKEN_INT && to == TOKEN_FLOAT);
+}
 
-    return result;
+// Types a task can take and return: plain values that can be copied to
+// another thread. Strings share a reference count that is not atomic.
+static bool isTaskValueType(TokenType type)
+{
+    return type == TOKEN_INT || type == TOKEN_FLOAT || type == TOKEN_CHAR;
 }
 
-// Analyze a statement
-static bool analyzeStatement(SemanticContext *context, SymbolTable *table, AstNode *node)
+// The user-defined function with the given name
+static AstFunctionDecl *findFunction(SemanticContext *context, Token name)
 {
-    switch (node->type)
+    for (int i = 0; i < context->program->count; i++)
     {
-    case AST_BLOCK:
-        return analyzeBlock(context, table, (AstBlock *)node);
-    case AST_IF:
-        return analyzeIfStatement(context, table, (AstIf *)node);
-    case AST_WHILE:
-        return analyzeWhileStatement(context, table, (AstWhile *)node);
-    case AST_FOR:
-        return analyzeForStatement(context, table, (AstFor *)node);
-    case AST_RETURN:
-        return analyzeReturnStatement(context, table, (AstReturn *)node);
-    case AST_EXPRESSION_STMT:
-        return analyzeExpressionStatement(context, table, (AstExpressionStmt *)node);
-    default:
-        semanticError(context, node->line, node->column, "Unknown statement type.");
-        return false;
+        AstNode *declaration = context->program->declarations[i];
+        if (declaration->type != AST_FUNCTION_DECL)
+            continue;
+
+        // lexeme() reuses one buffer, so compare the tokens themselves
+        AstFunctionDecl *function = (AstFunctionDecl *)declaration;
+        if (function->name.length == name.length &&
+            memcmp(function->name.start, name.start, name.length) == 0)
+            return function;
     }
+    return NULL;
 }
 
-// Analyze a block statement
-static bool analyzeBlock(SemanticContext *context, SymbolTable *table, AstBlock *node)
+// Whether coroutine keeps an instance of target in its frame, directly or
+// through the coroutines it keeps (searching at most depth levels)
+static bool keepsCoroutine(AstFunctionDecl *coroutine, AstFunctionDecl *target, int depth)
 {
-    beginScope(table);
-
-    for (int i = 0; i < node->count; i++)
+    for (int i = 0; i < coroutine->slotCount && depth > 0; i++)
     {
-        if (!analyzeDeclaration(context, table, node->statements[i]))
-        {
-            endScope(table);
-            return false;
-        }
+        AstFrameSlot *slot = &coroutine->slots[i];
+        if (slot->kept && slot->coroutine != NULL &&
+            (slot->coroutine == target || keepsCoroutine(slot->coroutine, target, depth - 1)))
+            return true;
     }
+    return false;
+}
 
-    endScope(table);
-    return true;
+static int appendFrameSlot(AstFunctionDecl *function, Token name, TokenType type, bool kept)
+{
+    function->slots = (AstFrameSlot *)realloc(function->slots,
+                                              sizeof(AstFrameSlot) * (function->slotCount + 1));
+    AstFrameSlot *slot = &function->slots[function->slotCount];
+    slot->name = name;
+    slot->type = type;
+    slot->coroutine = NULL;
+    slot->kept = kept;
+    return function->slotCount++;
 }
 
-// Analyze an if statement
-static bool analyzeIfStatement(SemanticContext *context, SymbolTable *table, AstIf *node)
+// Give a local of the coroutine being analyzed its slot, or -1 outside
+// coroutines. The generated frame refers to locals by name, so locals may not
+// shadow each other, and locals that share a name share a slot.
+static int addFrameSlot(SemanticContext *context, SymbolTable *table, AstVarDecl *node)
 {
-    // Analyze the condition
-    TokenType condType = analyzeExpression(context, table, node->condition);
+    AstFunctionDecl *function = context->function;
+    if (function == NULL || !function->coroutine)
+        return -1;
 
-    // Condition should be a boolean expression
-    if (condType != TOKEN_ERROR && condType != TOKEN_INT)
+    if (!isTaskValueType(node->varType) && node->varType != TOKEN_COROUTINE)
     {
-        semanticError(context, node->condition->line, node->condition->column,
-                      "Condition must be a boolean expression.");
+        semanticError(context, node->base.line, node->base.column,
+                      "Coroutine variables must be numbers, characters or coroutines.");
+        return -1;
     }
 
-    // Analyze the then branch
-    bool thenResult = analyzeStatement(context, table, node->thenBranch);
-
-    // Analyze the else branch if it exists
-    bool elseResult = true;
-    if (node->elseBranch != NULL)
+    Symbol *outer = resolveSymbol(table, lexeme(node->name));
+    if (outer != NULL && outer->frameSlot >= 0 && outer->scopeDepth < table->scopeDepth)
     {
-        elseResult = analyzeStatement(context, table, node->elseBranch);
+        semanticError(context, node->base.line, node->base.column,
+                      "Variables in a coroutine cannot shadow each other.");
+        return -1;
     }
 
-    return thenResult && elseResult;
+    for (int i = 0; i < function->slotCount; i++)
+    {
+        AstFrameSlot *slot = &function->slots[i];
+        if (slot->name.length == node->name.length &&
+            memcmp(slot->name.start, node->name.start, node->name.length) == 0)
+        {
+            if (slot->type != node->varType)
+            {
+                semanticError(context, node->base.line, node->base.column,
+                              "Variables of a coroutine that share a name must have the same type.");
+                return -1;
+            }
+            return i;
+        }
+    }
+    return appendFrameSlot(function, node->name, node->varType, false);
 }
 
-// Analyze a while statement
-static bool analyzeWhileStatement(SemanticContext *context, SymbolTable *table, AstWhile *node)
+static void bindFrameSlot(SemanticContext *context, Symbol *symbol, int slot)
 {
-    // Analyze the condition
-    TokenType condType = analyzeExpression(context, table, node->condition);
+    if (symbol == NULL)
+        return;
+    symbol->frameSlot = slot;
+    symbol->yieldsBefore = context->yieldCount;
+}
 
-    // Condition should be a boolean expression
-    if (condType != TOKEN_ERROR && condType != TOKEN_INT)
+// Note a reference to a variable. A coroutine keeps a local in its frame when
+// the local is referred to after a रोको_और_दो that follows its definition.
+static void useVariable(SemanticContext *context, Symbol *symbol)
+{
+    symbol->lastUse = ++context->useCount;
+    if (symbol->frameSlot >= 0 && context->yieldCount > symbol->yieldsBefore)
     {
-        semanticError(context, node->condition->line, node->condition->column,
-                      "Condition must be a boolean expression.");
+        context->function->slots[symbol->frameSlot].kept = true;
     }
-
-    // Analyze the loop body
-    return analyzeStatement(context, table, node->body);
 }
 
-// Analyze a for statement
-static bool analyzeForStatement(SemanticContext *context, SymbolTable *table, AstFor *node)
+// A loop that yields resumes into its next iteration, so the variables
+// declared outside the loop body that the loop refers to live across the
+// yield. uses is the use count before the loop.
+static void keepLoopVariables(SemanticContext *context, SymbolTable *table, int yields, int uses)
 {
-    beginScope(table);
-
-    // Analyze initializer if present
-    if (node->initializer != NULL)
-    {
-        if (!analyzeDeclaration(context, table, node->initializer))
-        {
-            endScope(table);
-            return false;
-        }
-    }
+    if (context->yieldCount == yields)
+        return;
 
-    // Analyze condition if present
-    if (node->condition != NULL)
+    for (Symbol *symbol = table->first; symbol != NULL; symbol = symbol->next)
     {
-        TokenType condType = analyzeExpression(context, table, node->condition);
-
-        // Condition should be a boolean expression
-        if (condType != TOKEN_ERROR && condType != TOKEN_INT)
+        if (symbol->frameSlot >= 0 && symbol->lastUse > uses)
         {
-            semanticError(context, node->condition->line, node->condition->column,
-                          "Condition must be a boolean expression.");
+            context->function->slots[symbol->frameSlot].kept = true;
         }
     }
+}
 
-    // Analyze increment if present
-    if (node->increment != NULL)
+// Atomics are only read and written through the परमाणु_ builtins, which
+// name the memory order; a plain access would silently be sequentially
+// consistent, or tear a read-modify-write into two steps
+static TokenType plainAccess(SemanticContext *context, AstNode *node, TokenType type)
+{
+    if (type == TOKEN_ATOMIC)
     {
-        analyzeExpression(context, table, node->increment);
+        semanticError(context, node->line, node->column, "Atomics are read with परमाणु_पढ़ो.");
+        return TOKEN_ERROR;
     }
+    return type;
+}
 
-    // Analyze the loop body
-    bool result = analyzeStatement(context, table, node->body);
-
-    endScope(table);
-    return result;
+static bool isConcatenation(AstNode *node)
+{
+    return node != NULL && node->type == AST_BINARY && ((AstBinary *)node)->operator== TOKEN_PLUS;
 }
 
-// Analyze a return statement
-static bool analyzeReturnStatement(SemanticContext *context, SymbolTable *table, AstReturn *node)
+// Whether a पाठ expression builds a new string rather than naming one that
+// is already stored (variables, literals, list elements and map values).
+// Concatenations of literals are folded into a literal at compile time.
+static bool createsString(AstNode *node)
 {
-    // Check if returning from void function without a value
-    if (currentFunctionReturnType == TOKEN_VOID && node->value != NULL)
+    switch (node->type)
     {
-        semanticError(context, node->base.line, node->base.column,
-                      "Cannot return a value from a void function.");
+    case AST_BINARY:
+        return !isStringConstant(node);
+    case AST_CALL:
+    {
+        // Lines and fields of a file are views of its mapping
+        const char *name = lexeme(((AstCall *)node)->name);
+        return strcmp(name, "पाओ") != 0 && strcmp(name, "पंक्ति") != 0 && strcmp(name, "खंड") != 0;
+    }
+    default:
         return false;
     }
+}
 
-    // Check if returning from non-void function without a value
-    if (currentFunctionReturnType != TOKEN_VOID && node->value == NULL)
+// Lists are never copied: a list can only be initialized or assigned from
+// another list variable, whose storage moves over and leaves it empty
+static void checkListMove(SemanticContext *context, SymbolTable *table, AstNode *source,
+                          TokenType elemType)
+{
+    TokenType type = analyzeExpression(context, table, source);
+    if (type == TOKEN_ERROR)
+        return;
+
+    if (source->type != AST_VARIABLE || type != TOKEN_LIST)
     {
-        semanticError(context, node->base.line, node->base.column,
-                      "Missing return value in non-void function.");
-        return false;
+        semanticError(context, source->line, source->column,
+                      "A list can only be initialized or assigned from another list.");
+        return;
     }
 
-    // Check return value type if present
-    if (node->value != NULL)
+    Symbol *symbol = resolveSymbol(table, lexeme(((AstVariable *)source)->name));
+    if (symbol->elemType != elemType)
     {
-        TokenType valueType = analyzeExpression(context, table, node->value);
-
-        if (valueType != TOKEN_ERROR && valueType != currentFunctionReturnType)
-        {
-            semanticError(context, node->value->line, node->value->column,
-                          "Return type mismatch.");
-            return false;
-        }
+        semanticError(context, source->line, source->column, "List element types differ.");
     }
+    checkWritable(context, source, symbol);
+}
 
-    return true;
+// A स्थिर variable is written only by its declaration. Moving a list out
+// empties it, so that counts as a write too.
+static bool checkWritable(SemanticContext *context, AstNode *node, Symbol *symbol)
+{
+    if (symbol == NULL || symbol->constant == NULL)
+        return true;
+
+    semanticError(context, node->line, node->column, "Constants cannot be changed.");
+    return false;
 }
 
-// Analyze an expression statement
-static bool analyzeExpressionStatement(SemanticContext *context, SymbolTable *table, AstExpressionStmt *node)
+static ConstantValue unknownConstant(void)
 {
-    analyzeExpression(context, table, node->expression);
-    return true;
+    ConstantValue value = {false, false, false, 0, 0.0};
+    return value;
 }
 
-// Analyze an expression and return its type
-static TokenType analyzeExpression(SemanticContext *context, SymbolTable *table, AstNode *node)
+static ConstantValue intConstant(int intValue)
 {
-    if (node == NULL)
-        return TOKEN_ERROR;
+    ConstantValue value = {true, false, false, intValue, 0.0};
+    return value;
+}
 
-    switch (node->type)
-    {
-    case AST_BINARY:
-        return analyzeBinary(context, table, (AstBinary *)node);
-    case AST_UNARY:
-        return analyzeUnary(context, table, (AstUnary *)node);
-    case AST_LITERAL:
-        return analyzeLiteral(context, table, (AstLiteral *)node);
-    case AST_VARIABLE:
-        return analyzeVariable(context, table, (AstVariable *)node);
-    case AST_ASSIGNMENT:
-        return analyzeAssignment(context, table, (AstAssignment *)node);
-    case AST_CALL:
-        return analyzeCall(context, table, (AstCall *)node);
-    default:
-        semanticError(context, node->line, node->column, "Unknown expression type.");
-        return TOKEN_ERROR;
-    }
+static ConstantValue floatConstant(double floatValue, bool single)
+{
+    ConstantValue value = {true, true, single, 0, single ? (double)(float)floatValue : floatValue};
+    return value;
 }
 
-// Analyze a binary expression
-static TokenType analyzeBinary(SemanticContext *context, SymbolTable *table, AstBinary *node)
+// An operand of float arithmetic, converted as C converts it
+static double floatOperand(ConstantValue value, bool single)
 {
-    TokenType leftType = analyzeExpression(context, table, node->left);
-    TokenType rightType = analyzeExpression(context, table, node->right);
+    double number = value.isFloat ? value.floatValue : (double)value.intValue;
+    return single ? (double)(float)number : number;
+}
 
-    // Skip further analysis if either operand had errors
-    if (leftType == TOKEN_ERROR || rightType == TOKEN_ERROR)
+// Check an integer result of a constant expression, computed in 64 bits
+static ConstantValue checkedInt(SemanticContext *context, AstNode *node, long long result)
+{
+    if (result < INT_MIN || result > INT_MAX)
     {
-        return TOKEN_ERROR;
+        semanticError(context, node->line, node->column, "Constant expression overflows.");
+        return unknownConstant();
     }
+    return intConstant((int)result);
+}
 
-    // For arithmetic operators
-    if (node->operator== TOKEN_PLUS || node->operator== TOKEN_MINUS ||
-        node->operator== TOKEN_MULTIPLY || node->operator== TOKEN_DIVIDE ||
-        node->operator== TOKEN_MODULO)
-    {
+// Value of an expression made of number literals, known constants and
+// operators, computed the way the generated C computes it: integers in int,
+// a float with a literal in double, floats with floats or integers in float.
+// Reports overflow and division by zero, which C leaves undefined.
+static ConstantValue evaluateConstant(SemanticContext *context, AstNode *node)
+{
+    if (node == NULL)
+        return unknownConstant();
+
+    switch (node->type)
+    {
+    case AST_LITERAL:
+    {
+        Token value = ((AstLiteral *)node)->value;
+        if (value.type != TOKEN_NUMBER)
+            return unknownConstant();
+
+        char digits[64];
+        if (value.length >= (int)sizeof(digits))
+            return unknownConstant();
+        memcpy(digits, value.start, value.length);
+        digits[value.length] = '\0';
+
+        if (node->dataType == TOKEN_FLOAT)
+            return floatConstant(strtod(digits, NULL), context->singlePrecision);
+        // A literal past INT_MAX is not an int in C either
+        long long number = strtoll(digits, NULL, 10);
+        return number <= INT_MAX ? intConstant((int)number) : unknownConstant();
+    }
+    case AST_VARIABLE:
+    {
+        AstVarDecl *constant = ((AstVariable *)node)->constant;
+        return constant != NULL && constant->varType != TOKEN_TEXT ? constant->value : unknownConstant();
+    }
+    case AST_UNARY:
+    {
+        AstUnary *unary = (AstUnary *)node;
+        ConstantValue operand = evaluateConstant(context, unary->right);
+        if (!operand.known)
+            return operand;
+        switch (unary->operator)
+        {
+        case TOKEN_NOT:
+            return intConstant(!operand.intValue);
+        case TOKEN_MINUS:
+            if (operand.isFloat)
+                return floatConstant(-operand.floatValue, operand.single);
+            return checkedInt(context, node, -(long long)operand.intValue);
+        case TOKEN_FLOAT:
+            return floatConstant(floatOperand(operand, false), true);
+        case TOKEN_INT:
+            if (!operand.isFloat)
+                return operand;
+            // Converting a decimal outside the int range is undefined in C
+            if (!(operand.floatValue > -2147483649.0 && operand.floatValue < 2147483648.0))
+            {
+                semanticError(context, node->line, node->column, "Constant expression overflows.");
+                return unknownConstant();
+            }
+            return intConstant((int)operand.floatValue);
+        case TOKEN_CHAR:
+        {
+            // Outside char's range the conversion is implementation-defined
+            // for integers and undefined for decimals
+            double value = operand.isFloat ? operand.floatValue : operand.intValue;
+            if (!(value > CHAR_MIN - 1.0 && value < CHAR_MAX + 1.0))
+            {
+                semanticError(context, node->line, node->column, "Constant expression overflows.");
+                return unknownConstant();
+            }
+            return intConstant((int)value);
+        }
+        default:
+            return unknownConstant();
+        }
+    }
+    case AST_BINARY:
+    {
+        AstBinary *binary = (AstBinary *)node;
+        if (node->dataType == TOKEN_TEXT)
+            return unknownConstant();
+
+        ConstantValue left = evaluateConstant(context, binary->left);
+        ConstantValue right = evaluateConstant(context, binary->right);
+        if (!left.known || !right.known)
+            return unknownConstant();
+
+        if (binary->operator== TOKEN_AND)
+            return intConstant(left.intValue && right.intValue);
+        if (binary->operator== TOKEN_OR)
+            return intConstant(left.intValue || right.intValue);
+
+        if (left.isFloat || right.isFloat)
+        {
+            // Double unless every float operand is single precision
+            bool single = (!left.isFloat || left.single) && (!right.isFloat || right.single);
+            double a = floatOperand(left, single);
+            double b = floatOperand(right, single);
+            double result;
+            switch (binary->operator)
+            {
+            case TOKEN_EQUALS:
+                return intConstant(a == b);
+            case TOKEN_NOT_EQUALS:
+                return intConstant(a != b);
+            case TOKEN_LESS:
+                return intConstant(a < b);
+            case TOKEN_GREATER:
+                return intConstant(a > b);
+            case TOKEN_LESS_EQ:
+                return intConstant(a <= b);
+            case TOKEN_GREATER_EQ:
+                return intConstant(a >= b);
+            case TOKEN_PLUS:
+                result = a + b;
+                break;
+            case TOKEN_MINUS:
+                result = a - b;
+                break;
+            case TOKEN_MULTIPLY:
+                result = a * b;
+                break;
+            case TOKEN_DIVIDE:
+                if (b == 0)
+                {
+                    semanticError(context, node->line, node->column,
+                                  "Division by zero in a constant expression.");
+                    return unknownConstant();
+                }
+                result = a / b;
+                break;
+            default:
+                return unknownConstant();
+            }
+
+            ConstantValue value = floatConstant(result, single);
+            if (!isfinite(value.floatValue))
+            {
+                semanticError(context, node->line, node->column, "Constant expression overflows.");
+                return unknownConstant();
+            }
+            return value;
+        }
+
+        long long a = left.intValue;
+        long long b = right.intValue;
+        switch (binary->operator)
+        {
+        case TOKEN_EQUALS:
+            return intConstant(a == b);
+        case TOKEN_NOT_EQUALS:
+            return intConstant(a != b);
+        case TOKEN_LESS:
+            return intConstant(a < b);
+        case TOKEN_GREATER:
+            return intConstant(a > b);
+        case TOKEN_LESS_EQ:
+            return intConstant(a <= b);
+        case TOKEN_GREATER_EQ:
+            return intConstant(a >= b);
+        case TOKEN_PLUS:
+            return checkedInt(context, node, a + b);
+        case TOKEN_MINUS:
+            return checkedInt(context, node, a - b);
+        case TOKEN_MULTIPLY:
+            return checkedInt(context, node, a * b);
+        case TOKEN_DIVIDE:
+        case TOKEN_MODULO:
+            if (b == 0)
+            {
+                semanticError(context, node->line, node->column,
+                              "Division by zero in a constant expression.");
+                return unknownConstant();
+            }
+            return checkedInt(context, node, binary->operator== TOKEN_DIVIDE ? a / b : a % b);
+        default:
+            return unknownConstant();
+        }
+    }
+    default:
+        return unknownConstant();
+    }
+}
+
+// Work out the value of a स्थिर number, character or string. Uses of
+// constants with a known value are replaced by it; global constants must
+// have one, as they are laid out at compile time.
+static void analyzeConstant(SemanticContext *context, SymbolTable *table, AstVarDecl *node,
+                            TokenType initType)
+{
+    if (node->initializer == NULL)
+    {
+        semanticError(context, node->base.line, node->base.column, "A constant must be initialized.");
+        return;
+    }
+    if (node->initializer->type == AST_SPAWN)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "A constant cannot receive the result of 'कार्य'.");
+        return;
+    }
+    if (!promotes(initType, node->varType))
+        return;
+
+    if (node->varType == TOKEN_TEXT)
+    {
+        // Global strings report their own error
+        node->value.known = isStringConstant(node->initializer);
+        return;
+    }
+
+    int errors = context->errorCount;
+    node->value = evaluateConstant(context, node->initializer);
+    if (node->value.known && node->varType == TOKEN_FLOAT)
+    {
+        // The value a दशमलव variable holds
+        node->value = floatConstant(floatOperand(node->value, false), true);
+    }
+    if (!node->value.known && table->scopeDepth == 0 && context->errorCount == errors)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "A global constant must be initialized with a constant expression.");
+    }
+}
+
+// A स्थिर list is a table of constant elements, laid out at compile time
+static void analyzeConstantTable(SemanticContext *context, SymbolTable *table, AstVarDecl *node)
+{
+    if (node->elements == NULL)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "A constant list must be initialized with [elements].");
+        return;
+    }
+
+    for (int i = 0; i < node->elementCount; i++)
+    {
+        AstNode *element = node->elements[i];
+        TokenType type = analyzeExpression(context, table, element);
+        if (type == TOKEN_ERROR)
+            continue;
+
+        if (!promotes(type, node->elemType))
+        {
+            semanticError(context, element->line, element->column, "List element types differ.");
+        }
+        else if (type == TOKEN_TEXT ? !isStringConstant(element) : !evaluateConstant(context, element).known)
+        {
+            semanticError(context, element->line, element->column,
+                          "Elements of a constant list must be constant expressions.");
+        }
+    }
+}
+
+// Analyze a declaration
+static bool analyzeDeclaration(SemanticContext *context, SymbolTable *table, AstNode *node)
+{
+    switch (node->type)
+    {
+    case AST_VAR_DECL:
+        return analyzeVarDecl(context, table, (AstVarDecl *)node);
+    case AST_FUNCTION_DECL:
+        return analyzeFunctionDecl(context, table, (AstFunctionDecl *)node);
+    default:
+        return analyzeStatement(context, table, node);
+    }
+}
+
+// Analyze a variable declaration
+static bool analyzeVarDecl(SemanticContext *context, SymbolTable *table, AstVarDecl *node)
+{
+    int slot = addFrameSlot(context, table, node);
+
+    if (node->elements != NULL && !(node->constant && node->varType == TOKEN_LIST))
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Only constant lists can be initialized with [elements].");
+    }
+
+    if (node->varType == TOKEN_MAP)
+    {
+        if (node->initializer != NULL)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Maps start empty and cannot have an initializer.");
+        }
+        if (node->keyType != TOKEN_INT && node->keyType != TOKEN_TEXT)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Map keys must be integers or strings.");
+        }
+
+        Symbol *symbol = defineVariable(table, lexeme(node->name), TOKEN_MAP,
+                                        node->base.line, node->base.column);
+        if (symbol != NULL)
+        {
+            symbol->keyType = node->keyType;
+            symbol->elemType = node->elemType;
+        }
+        context->runtimeFeatures |= RUNTIME_MAP;
+        return symbol != NULL;
+    }
+
+    if (node->varType == TOKEN_LIST)
+    {
+        if (node->constant)
+        {
+            analyzeConstantTable(context, table, node);
+        }
+        else if (node->initializer != NULL)
+        {
+            if (table->scopeDepth == 0)
+            {
+                semanticError(context, node->base.line, node->base.column,
+                              "Global lists start empty and cannot have an initializer.");
+            }
+            checkListMove(context, table, node->initializer, node->elemType);
+        }
+
+        Symbol *symbol = defineVariable(table, lexeme(node->name), TOKEN_LIST,
+                                        node->base.line, node->base.column);
+        if (symbol != NULL)
+        {
+            symbol->elemType = node->elemType;
+            symbol->constant = node->constant ? node : NULL;
+        }
+        context->runtimeFeatures |= RUNTIME_LIST;
+        return symbol != NULL;
+    }
+
+    if (node->varType == TOKEN_CHANNEL)
+    {
+        // Tasks take only plain values, so they reach channels through globals
+        if (table->scopeDepth != 0)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Channels must be declared at global scope.");
+        }
+        if (node->initializer != NULL)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Channels start empty and cannot have an initializer.");
+        }
+        if (node->elemType == TOKEN_TEXT)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Channels carry numbers or characters.");
+        }
+        if (node->capacity > (1 << 24))
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Channel buffer is too large.");
+        }
+
+        Symbol *symbol = defineVariable(table, lexeme(node->name), TOKEN_CHANNEL,
+                                        node->base.line, node->base.column);
+        if (symbol != NULL)
+        {
+            symbol->elemType = node->elemType;
+        }
+        // Blocked channel operations let the task pool add workers
+        context->runtimeFeatures |= RUNTIME_CHAN | RUNTIME_TASK;
+        return symbol != NULL;
+    }
+
+    if (node->varType == TOKEN_ATOMIC)
+    {
+        // An atomic starts from a plain integer; after that only the परमाणु_
+        // builtins touch it
+        if (node->initializer != NULL)
+        {
+            TokenType initType = analyzeValue(context, table, node->initializer);
+            if (initType != TOKEN_ERROR && initType != TOKEN_INT)
+            {
+                semanticError(context, node->base.line, node->base.column,
+                              "Atomics hold integers.");
+            }
+        }
+
+        Symbol *symbol = defineVariable(table, lexeme(node->name), TOKEN_ATOMIC,
+                                        node->base.line, node->base.column);
+        context->runtimeFeatures |= RUNTIME_ATOMIC;
+        return symbol != NULL;
+    }
+
+    if (node->varType == TOKEN_FILE)
+    {
+        if (table->scopeDepth == 0)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Files are opened inside functions.");
+        }
+
+        TokenType initType = node->initializer != NULL
+                                 ? analyzeExpression(context, table, node->initializer)
+                                 : TOKEN_VOID;
+        if (initType != TOKEN_FILE && initType != TOKEN_ERROR)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "A 'संचिका' variable must be initialized with खोलो.");
+        }
+
+        Symbol *symbol = defineVariable(table, lexeme(node->name), TOKEN_FILE,
+                                        node->base.line, node->base.column);
+        // Lines and fields are पाठ views
+        context->runtimeFeatures |= RUNTIME_FILE | RUNTIME_STR;
+        return symbol != NULL;
+    }
+
+    if (node->varType == TOKEN_COROUTINE)
+    {
+        if (table->scopeDepth == 0)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Coroutines run inside functions.");
+        }
+
+        AstFunctionDecl *coroutine = NULL;
+        TokenType initType = analyzeExpression(context, table, node->initializer);
+        if (node->initializer == NULL || node->initializer->type != AST_CALL ||
+            (initType != TOKEN_COROUTINE && initType != TOKEN_ERROR))
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "A 'सहक्रम' variable must be initialized by calling a coroutine.");
+        }
+        else
+        {
+            coroutine = ((AstCall *)node->initializer)->coroutine;
+        }
+
+        if (slot >= 0 && coroutine != NULL)
+        {
+            AstFrameSlot *frameSlot = &context->function->slots[slot];
+            if (frameSlot->coroutine != NULL && frameSlot->coroutine != coroutine)
+            {
+                semanticError(context, node->base.line, node->base.column,
+                              "Variables of a coroutine that share a name must have the same type.");
+            }
+            frameSlot->coroutine = coroutine;
+        }
+
+        Symbol *symbol = defineVariable(table, lexeme(node->name), TOKEN_COROUTINE,
+                                        node->base.line, node->base.column);
+        if (symbol != NULL)
+        {
+            symbol->coroutine = coroutine;
+            symbol->elemType = coroutine != NULL ? coroutine->returnType : TOKEN_ERROR;
+        }
+        bindFrameSlot(context, symbol, slot);
+        return symbol != NULL;
+    }
+
+    if (node->varType == TOKEN_TEXT)
+    {
+        context->runtimeFeatures |= RUNTIME_STR;
+    }
+
+    // Check if the variable has an initializer
+    TokenType initType = TOKEN_VOID;
+    if (node->initializer != NULL && node->initializer->type == AST_SPAWN)
+    {
+        initType = analyzeSpawn(context, table, (AstSpawn *)node->initializer);
+    }
+    else if (node->initializer != NULL)
+    {
+        initType = analyzeValue(context, table, node->initializer);
+
+        // Check type compatibility
+        if (initType != TOKEN_ERROR && !promotes(initType, node->varType))
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Type mismatch in variable initialization.");
+        }
+    }
+
+    // Global strings are initialized statically
+    if (node->varType == TOKEN_TEXT && table->scopeDepth == 0 && node->initializer != NULL &&
+        !isStringConstant(node->initializer))
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Global strings can only be initialized with a string literal.");
+    }
+
+    if (node->constant)
+    {
+        analyzeConstant(context, table, node, initType);
+    }
+
+    // Define the variable in the symbol table
+    Symbol *symbol = defineVariable(table, lexeme(node->name), node->varType,
+                                    node->base.line, node->base.column);
+    bindFrameSlot(context, symbol, slot);
+    if (symbol != NULL && node->constant)
+    {
+        symbol->constant = node;
+    }
+
+    if (symbol != NULL && node->initializer != NULL && node->initializer->type == AST_SPAWN)
+    {
+        storeTaskResult(context, node->initializer, symbol);
+    }
+
+    return symbol != NULL;
+}
+
+// Analyze a function declaration
+static bool analyzeFunctionDecl(SemanticContext *context, SymbolTable *table, AstFunctionDecl *node)
+{
+    // Save the current function return type for return statement checking
+    TokenType previousReturnType = currentFunctionReturnType;
+    currentFunctionReturnType = node->returnType;
+    context->function = node;
+
+    // Create a new scope for function parameters and body
+    beginScope(table);
+
+    if (node->returnType == TOKEN_TEXT)
+    {
+        context->runtimeFeatures |= RUNTIME_STR;
+    }
+
+    // A coroutine's frame holds its parameters and the values it yields
+    if (node->coroutine && !isTaskValueType(node->returnType))
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Coroutines yield numbers or characters.");
+    }
+    if (node->coroutine && strcmp(lexeme(node->name), "मुख्य") == 0)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "The entry point cannot be a coroutine.");
+    }
+
+    // Define parameters in the new scope
+    for (int i = 0; i < node->paramCount; i++)
+    {
+        if (node->params[i].type == TOKEN_TEXT)
+        {
+            context->runtimeFeatures |= RUNTIME_STR;
+        }
+        Symbol *param = defineVariable(table, lexeme(node->params[i].name), node->params[i].type,
+                                       node->params[i].name.line, node->params[i].name.column);
+
+        if (node->coroutine && !isTaskValueType(node->params[i].type))
+        {
+            semanticError(context, node->params[i].name.line, node->params[i].name.column,
+                          "Coroutine parameters must be numbers or characters.");
+        }
+        else if (node->coroutine && param != NULL)
+        {
+            param->frameSlot = appendFrameSlot(node, node->params[i].name, node->params[i].type, true);
+        }
+    }
+
+    // Analyze function body
+    context->functionDepth = table->scopeDepth + 1;
+    context->yieldCount = 0;
+    bool result = analyzeBlock(context, table, (AstBlock *)node->body);
+
+    // Tasks still running at the end are waited for when the function returns
+    analyzeSync(table);
+
+    // End scope and restore previous function return type
+    endScope(table);
+    currentFunctionReturnType = previousReturnType;
+    context->function = NULL;
+
+    return result;
+}
+
+// Analyze a statement
+static bool analyzeStatement(SemanticContext *context, SymbolTable *table, AstNode *node)
+{
+    switch (node->type)
+    {
+    case AST_BLOCK:
+        return analyzeBlock(context, table, (AstBlock *)node);
+    case AST_IF:
+        return analyzeIfStatement(context, table, (AstIf *)node);
+    case AST_WHILE:
+        return analyzeWhileStatement(context, table, (AstWhile *)node);
+    case AST_FOR:
+        return analyzeForStatement(context, table, (AstFor *)node);
+    case AST_RETURN:
+        return analyzeReturnStatement(context, table, (AstReturn *)node);
+    case AST_EXPRESSION_STMT:
+        return analyzeExpressionStatement(context, table, (AstExpressionStmt *)node);
+    case AST_SYNC:
+        analyzeSync(table);
+        return true;
+    case AST_YIELD:
+        return analyzeYield(context, table, (AstYield *)node);
+    case AST_MEASURE:
+        return analyzeMeasure(context, table, (AstMeasure *)node);
+    default:
+        semanticError(context, node->line, node->column, "Unknown statement type.");
+        return false;
+    }
+}
+
+// Analyze a block statement
+static bool analyzeBlock(SemanticContext *context, SymbolTable *table, AstBlock *node)
+{
+    beginScope(table);
+
+    int regionDepth = context->regionDepth;
+    if (node->region)
+    {
+        context->regionDepth = table->scopeDepth;
+        context->runtimeFeatures |= RUNTIME_REGION;
+    }
+
+    bool result = true;
+    for (int i = 0; i < node->count && result; i++)
+    {
+        result = analyzeDeclaration(context, table, node->statements[i]);
+    }
+
+    context->regionDepth = regionDepth;
+    endScope(table);
+    return result;
+}
+
+// Whether name is a string or container declared inside the innermost क्षेत्र
+static bool declaredInRegion(SemanticContext *context, SymbolTable *table, Token name)
+{
+    Symbol *symbol = resolveSymbol(table, lexeme(name));
+    return symbol != NULL && symbol->type == SYMBOL_VARIABLE && symbol->scopeDepth >= context->regionDepth &&
+           (symbol->dataType == TOKEN_TEXT || isContainerType(symbol->dataType));
+}
+
+// Whether the value of an analyzed expression may live in the arena of the
+// innermost क्षेत्र: it concatenates strings there, or is derived from a
+// string or container declared inside it
+static bool madeInRegion(SemanticContext *context, SymbolTable *table, AstNode *node)
+{
+    if (node == NULL || context->regionDepth == 0 ||
+        (node->dataType != TOKEN_TEXT && !isContainerType(node->dataType)))
+        return false;
+
+    switch (node->type)
+    {
+    case AST_BINARY:
+        return !isStringConstant(node);
+    case AST_VARIABLE:
+        return ((AstVariable *)node)->constant == NULL &&
+               declaredInRegion(context, table, ((AstVariable *)node)->name);
+    case AST_INDEX:
+        return declaredInRegion(context, table, ((AstIndex *)node)->name);
+    case AST_CALL:
+    {
+        AstCall *call = (AstCall *)node;
+        for (int i = 0; i < call->argCount; i++)
+        {
+            if (madeInRegion(context, table, call->arguments[i]))
+                return true;
+        }
+        return false;
+    }
+    default:
+        return false;
+    }
+}
+
+// Reject storing a value from the innermost क्षेत्र's arena in a variable
+// that outlives the region
+static void checkRegionStore(SemanticContext *context, SymbolTable *table, AstAssignment *node,
+                             Symbol *symbol)
+{
+    if (symbol->scopeDepth < context->regionDepth && madeInRegion(context, table, node->value))
+    {
+        semanticError(context, node->value->line, node->value->column,
+                      "A value made inside a 'क्षेत्र' cannot be stored outside it.");
+    }
+}
+
+// Analyze an if statement
+static bool analyzeIfStatement(SemanticContext *context, SymbolTable *table, AstIf *node)
+{
+    // Analyze the condition
+    TokenType condType = analyzeExpression(context, table, node->condition);
+
+    // Condition should be a boolean expression
+    if (condType != TOKEN_ERROR && condType != TOKEN_INT)
+    {
+        semanticError(context, node->condition->line, node->condition->column,
+                      "Condition must be a boolean expression.");
+    }
+
+    // Analyze the then branch
+    bool thenResult = analyzeStatement(context, table, node->thenBranch);
+
+    // Analyze the else branch if it exists
+    bool elseResult = true;
+    if (node->elseBranch != NULL)
+    {
+        elseResult = analyzeStatement(context, table, node->elseBranch);
+    }
+
+    return thenResult && elseResult;
+}
+
+// Analyze a while statement
+static bool analyzeWhileStatement(SemanticContext *context, SymbolTable *table, AstWhile *node)
+{
+    int yields = context->yieldCount;
+    int uses = context->useCount;
+
+    // Analyze the condition
+    TokenType condType = analyzeExpression(context, table, node->condition);
+
+    // Condition should be a boolean expression
+    if (condType != TOKEN_ERROR && condType != TOKEN_INT)
+    {
+        semanticError(context, node->condition->line, node->condition->column,
+                      "Condition must be a boolean expression.");
+    }
+
+    // Analyze the loop body
+    bool result = analyzeStatement(context, table, node->body);
+    keepLoopVariables(context, table, yields, uses);
+    return result;
+}
+
+// Analyze a for statement
+static bool analyzeForStatement(SemanticContext *context, SymbolTable *table, AstFor *node)
+{
+    int yields = context->yieldCount;
+    int uses = context->useCount;
+    beginScope(table);
+
+    // Analyze initializer if present
+    if (node->initializer != NULL)
+    {
+        if (!analyzeDeclaration(context, table, node->initializer))
+        {
+            endScope(table);
+            return false;
+        }
+    }
+
+    // Analyze condition if present
+    if (node->condition != NULL)
+    {
+        TokenType condType = analyzeExpression(context, table, node->condition);
+
+        // Condition should be a boolean expression
+        if (condType != TOKEN_ERROR && condType != TOKEN_INT)
+        {
+            semanticError(context, node->condition->line, node->condition->column,
+                          "Condition must be a boolean expression.");
+        }
+    }
+
+    // Analyze increment if present
+    if (node->increment != NULL)
+    {
+        analyzeExpression(context, table, node->increment);
+    }
+
+    // Analyze the loop body; the loop variable is declared outside it
+    bool result = analyzeStatement(context, table, node->body);
+    keepLoopVariables(context, table, yields, uses);
+
+    endScope(table);
+    return result;
+}
+
+// Analyze a return statement
+static bool analyzeReturnStatement(SemanticContext *context, SymbolTable *table, AstReturn *node)
+{
+    // The runs would go unreported
+    if (context->measureDepth > 0)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "'वापस' cannot leave a 'मापो' block.");
+        return false;
+    }
+
+    if (context->function != NULL && context->function->coroutine)
+    {
+        if (node->value != NULL)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Coroutines hand out values with 'रोको_और_दो'; 'वापस' only ends them.");
+            return false;
+        }
+        return true;
+    }
+
+    // Check if returning from void function without a value
+    if (currentFunctionReturnType == TOKEN_VOID && node->value != NULL)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Cannot return a value from a void function.");
+        return false;
+    }
+
+    // Check if returning from non-void function without a value
+    if (currentFunctionReturnType != TOKEN_VOID && node->value == NULL)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Missing return value in non-void function.");
+        return false;
+    }
+
+    // Check return value type if present
+    if (node->value != NULL)
+    {
+        TokenType valueType = analyzeValue(context, table, node->value);
+
+        if (valueType != TOKEN_ERROR && !promotes(valueType, currentFunctionReturnType))
+        {
+            semanticError(context, node->value->line, node->value->column,
+                          "Return type mismatch.");
+            return false;
+        }
+
+        if (madeInRegion(context, table, node->value))
+        {
+            semanticError(context, node->value->line, node->value->column,
+                          "A value made inside a 'क्षेत्र' cannot be returned from it.");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Analyze an expression statement
+static bool analyzeExpressionStatement(SemanticContext *context, SymbolTable *table, AstExpressionStmt *node)
+{
+    if (node->expression->type == AST_SPAWN)
+    {
+        analyzeSpawn(context, table, (AstSpawn *)node->expression);
+        return true;
+    }
+
+    analyzeValue(context, table, node->expression);
+    return true;
+}
+
+// Analyze an expression, record its type on the node and return it
+static TokenType analyzeExpression(SemanticContext *context, SymbolTable *table, AstNode *node)
+{
+    if (node == NULL)
+        return TOKEN_ERROR;
+
+    // Only stores may receive a new string; anywhere else it would never be released
+    bool temporaryAllowed = context->temporaryAllowed;
+    context->temporaryAllowed = false;
+
+    TokenType type;
+    switch (node->type)
+    {
+    case AST_BINARY:
+        type = analyzeBinary(context, table, (AstBinary *)node);
+        break;
+    case AST_UNARY:
+        type = analyzeUnary(context, table, (AstUnary *)node);
+        break;
+    case AST_LITERAL:
+        type = analyzeLiteral(context, table, (AstLiteral *)node);
+        break;
+    case AST_VARIABLE:
+        type = analyzeVariable(context, table, (AstVariable *)node);
+        break;
+    case AST_ASSIGNMENT:
+        type = analyzeAssignment(context, table, (AstAssignment *)node);
+        break;
+    case AST_CALL:
+        type = analyzeCall(context, table, (AstCall *)node);
+        break;
+    case AST_INDEX:
+        type = analyzeIndex(context, table, (AstIndex *)node);
+        break;
+    case AST_SPAWN:
+        semanticError(context, node->line, node->column,
+                      "'कार्य' must start a statement or be stored in a variable.");
+        type = TOKEN_ERROR;
+        break;
+    default:
+        semanticError(context, node->line, node->column, "Unknown expression type.");
+        type = TOKEN_ERROR;
+        break;
+    }
+
+    // Strings are hc_str values everywhere but in a constant format string
+    if (type == TOKEN_TEXT && !context->formatString)
+    {
+        context->runtimeFeatures |= RUNTIME_STR;
+    }
+
+    node->dataType = type;
+    node->temporary = type == TOKEN_TEXT && createsString(node);
+    if (node->temporary && !temporaryAllowed)
+    {
+        semanticError(context, node->line, node->column,
+                      "Store the new string in a variable before using it.");
+    }
+    return type;
+}
+
+// Analyze an expression whose value is stored (initializers, assignments,
+// returns) or discarded (expression statements): it may create a new string
+static TokenType analyzeValue(SemanticContext *context, SymbolTable *table, AstNode *node)
+{
+    context->temporaryAllowed = true;
+    return plainAccess(context, node, analyzeExpression(context, table, node));
+}
+
+// Analyze a binary expression
+static TokenType analyzeBinary(SemanticContext *context, SymbolTable *table, AstBinary *node)
+{
+    // A chain of concatenations is built in one step, so its links are not new strings
+    context->temporaryAllowed = node->operator== TOKEN_PLUS && isConcatenation(node->left);
+    TokenType leftType = plainAccess(context, node->left, analyzeExpression(context, table, node->left));
+    context->temporaryAllowed = node->operator== TOKEN_PLUS && isConcatenation(node->right);
+    TokenType rightType = plainAccess(context, node->right, analyzeExpression(context, table, node->right));
+
+    // Skip further analysis if either operand had errors
+    if (leftType == TOKEN_ERROR || rightType == TOKEN_ERROR)
+    {
+        return TOKEN_ERROR;
+    }
+
+    // For arithmetic operators
+    if (node->operator== TOKEN_PLUS || node->operator== TOKEN_MINUS ||
+        node->operator== TOKEN_MULTIPLY || node->operator== TOKEN_DIVIDE ||
+        node->operator== TOKEN_MODULO)
+    {
+        // String concatenation
+        if (node->operator== TOKEN_PLUS && leftType == TOKEN_TEXT && rightType == TOKEN_TEXT)
+        {
+            return TOKEN_TEXT;
+        }
 
         // Both operands must be numeric
         if ((leftType != TOKEN_INT && leftType != TOKEN_FLOAT) ||
             (rightType != TOKEN_INT && rightType != TOKEN_FLOAT))
         {
             semanticError(context, node->base.line, node->base.column,
-                          "Arithmetic operators require numeric operands.");
+                          "Arithmetic operators require numeric operands.");
+            return TOKEN_ERROR;
+        }
+
+        // If either operand is float, result is float
+        if (leftType == TOKEN_FLOAT || rightType == TOKEN_FLOAT)
+        {
+            return TOKEN_FLOAT;
+        }
+
+        return TOKEN_INT;
+    }
+
+    // For comparison operators
+    if (node->operator== TOKEN_EQUALS || node->operator== TOKEN_NOT_EQUALS ||
+        node->operator== TOKEN_LESS || node->operator== TOKEN_GREATER ||
+        node->operator== TOKEN_LESS_EQ || node->operator== TOKEN_GREATER_EQ)
+    {
+
+        // Types must be compatible; an integer compared with a decimal is widened
+        if ((leftType != rightType || !isScalarType(leftType)) &&
+            !(isNumberType(leftType) && isNumberType(rightType)))
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Comparison operators require compatible operands.");
+            return TOKEN_ERROR;
+        }
+
+        // Comparison results in a boolean (int)
+        return TOKEN_INT;
+    }
+
+    // For logical operators (&&, ||)
+    if (node->operator== TOKEN_AND || node->operator== TOKEN_OR)
+    {
+        // Both operands must be boolean-convertible (int)
+        if (leftType != TOKEN_INT || rightType != TOKEN_INT)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Logical operators require boolean operands.");
+            return TOKEN_ERROR;
+        }
+
+        return TOKEN_INT;
+    }
+
+    semanticError(context, node->base.line, node->base.column,
+                  "Unknown binary operator.");
+    return TOKEN_ERROR;
+}
+
+// Analyze a unary expression
+static TokenType analyzeUnary(SemanticContext *context, SymbolTable *table, AstUnary *node)
+{
+    TokenType operandType = plainAccess(context, node->right, analyzeExpression(context, table, node->right));
+
+    // Skip further analysis if operand had errors
+    if (operandType == TOKEN_ERROR)
+    {
+        return TOKEN_ERROR;
+    }
+
+    // Negation operator (-)
+    if (node->operator== TOKEN_MINUS)
+    {
+        if (operandType != TOKEN_INT && operandType != TOKEN_FLOAT)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Unary negation requires a numeric operand.");
+            return TOKEN_ERROR;
+        }
+
+        return operandType;
+    }
+
+    // Conversions: पूर्णांक(x), दशमलव(x) and वर्ण(x)
+    if (node->operator== TOKEN_INT || node->operator== TOKEN_FLOAT || node->operator== TOKEN_CHAR)
+    {
+        if (!isNumberType(operandType) && operandType != TOKEN_CHAR)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Only numbers and characters can be converted.");
+            return TOKEN_ERROR;
+        }
+
+        return node->operator;
+    }
+
+    // Logical NOT operator (!)
+    if (node->operator== TOKEN_NOT)
+    {
+        if (operandType != TOKEN_INT)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Logical NOT requires a boolean operand.");
+            return TOKEN_ERROR;
+        }
+
+        return TOKEN_INT;
+    }
+
+    semanticError(context, node->base.line, node->base.column,
+                  "Unknown unary operator.");
+    return TOKEN_ERROR;
+}
+
+// Analyze a literal
+static TokenType analyzeLiteral(SemanticContext *context, SymbolTable *table, AstLiteral *node)
+{
+    switch (node->value.type)
+    {
+    case TOKEN_NUMBER:
+        // Check if it's an integer or float
+        if (memchr(node->value.start, '.', node->value.length) != NULL)
+        {
+            return TOKEN_FLOAT;
+        }
+        else
+        {
+            return TOKEN_INT;
+        }
+    case TOKEN_STRING:
+        return TOKEN_TEXT;
+    default:
+        semanticError(context, node->base.line, node->base.column,
+                      "Unknown literal type.");
+        return TOKEN_ERROR;
+    }
+}
+
+// Analyze a variable reference
+static TokenType analyzeVariable(SemanticContext *context, SymbolTable *table, AstVariable *node)
+{
+    Symbol *symbol = resolveSymbol(table, lexeme(node->name));
+
+    if (symbol == NULL)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Undefined variable.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->type != SYMBOL_VARIABLE)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Expected a variable name.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->pendingTask)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Wait with 'प्रतीक्षा' before using the result of 'कार्य'.");
+    }
+
+    // Constants with a known value are replaced by it
+    if (symbol->constant != NULL && symbol->constant->value.known)
+    {
+        node->constant = symbol->constant;
+    }
+
+    useVariable(context, symbol);
+    return symbol->dataType;
+}
+
+// Analyze an assignment
+static TokenType analyzeAssignment(SemanticContext *context, SymbolTable *table, AstAssignment *node)
+{
+    Symbol *symbol = resolveSymbol(table, lexeme(node->name));
+
+    if (symbol == NULL)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Undefined variable in assignment.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->type != SYMBOL_VARIABLE)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Cannot assign to a function.");
+        return TOKEN_ERROR;
+    }
+
+    if (!checkWritable(context, (AstNode *)node, symbol))
+        return TOKEN_ERROR;
+
+    useVariable(context, symbol);
+
+    // Element assignment: name[index] = value
+    if (node->index != NULL)
+    {
+        if (symbol->dataType != TOKEN_LIST)
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Only lists can be indexed.");
             return TOKEN_ERROR;
         }
 
-        // If either operand is float, result is float
-        if (leftType == TOKEN_FLOAT || rightType == TOKEN_FLOAT)
+        TokenType indexType = analyzeExpression(context, table, node->index);
+        if (indexType != TOKEN_ERROR && indexType != TOKEN_INT)
         {
-            return TOKEN_FLOAT;
+            semanticError(context, node->index->line, node->index->column,
+                          "List index must be an integer.");
         }
 
-        return TOKEN_INT;
+        TokenType elementType = analyzeValue(context, table, node->value);
+        if (elementType != TOKEN_ERROR && !promotes(elementType, symbol->elemType))
+        {
+            semanticError(context, node->base.line, node->base.column,
+                          "Type mismatch in assignment.");
+            return TOKEN_ERROR;
+        }
+        checkRegionStore(context, table, node, symbol);
+        return symbol->elemType;
     }
 
-    // For comparison operators
-    if (node->operator== TOKEN_EQUALS || node->operator== TOKEN_NOT_EQUALS ||
-        node->operator== TOKEN_LESS || node->operator== TOKEN_GREATER ||
-        node->operator== TOKEN_LESS_EQ || node->operator== TOKEN_GREATER_EQ)
+    if (symbol->dataType == TOKEN_LIST)
+    {
+        checkListMove(context, table, node->value, symbol->elemType);
+        checkRegionStore(context, table, node, symbol);
+        return TOKEN_LIST;
+    }
+
+    if (symbol->dataType == TOKEN_ATOMIC)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Atomics are written with परमाणु_लिखो.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->dataType == TOKEN_COROUTINE)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Coroutines cannot be assigned.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->dataType == TOKEN_FILE)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Files cannot be assigned.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->pendingTask)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "A task is still writing this variable; wait with 'प्रतीक्षा' first.");
+    }
+
+    TokenType valueType;
+    if (node->value->type == AST_SPAWN)
+    {
+        valueType = analyzeSpawn(context, table, (AstSpawn *)node->value);
+        storeTaskResult(context, node->value, symbol);
+    }
+    else
+    {
+        valueType = analyzeValue(context, table, node->value);
+    }
+
+    if (!isScalarType(symbol->dataType))
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Containers cannot be assigned.");
+        return TOKEN_ERROR;
+    }
+
+    // A task stores its result through a pointer of the variable's type
+    bool exact = node->value->type == AST_SPAWN;
+    if (valueType != TOKEN_ERROR &&
+        (exact ? valueType != symbol->dataType : !promotes(valueType, symbol->dataType)))
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Type mismatch in assignment.");
+        return TOKEN_ERROR;
+    }
+
+    checkRegionStore(context, table, node, symbol);
+    return valueType;
+}
+
+// Analyze a function call
+static TokenType analyzeCall(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    const char *name = lexeme(node->name);
+    for (int i = 0; builtins[i].name != NULL; i++)
+    {
+        if (strcmp(builtins[i].name, name) == 0)
+        {
+            if (builtins[i].argCount >= 0 && node->argCount != builtins[i].argCount)
+            {
+                semanticError(context, node->base.line, node->base.column,
+                              "Wrong number of arguments.");
+                return TOKEN_ERROR;
+            }
+            return builtins[i].analyze(context, table, node);
+        }
+    }
+
+    Symbol *symbol = resolveSymbol(table, name);
+
+    if (symbol == NULL)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Undefined function.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->type != SYMBOL_FUNCTION)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Cannot call a variable.");
+        return TOKEN_ERROR;
+    }
+
+    if (symbol->generic != NULL)
+    {
+        return analyzeGenericCall(context, table, node, symbol->generic);
+    }
+
+    // Variadic functions (paramCount < 0) take a format string and any scalars
+    if (symbol->paramCount < 0)
+    {
+        analyzeFormatArguments(context, table, node, strcmp(name, "पढ़ो") == 0);
+        return symbol->dataType;
+    }
+
+    // Check argument count
+    if (node->argCount != symbol->paramCount)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Wrong number of arguments.");
+        return TOKEN_ERROR;
+    }
+
+    // Check argument types
+    for (int i = 0; i < node->argCount; i++)
+    {
+        TokenType argType = analyzeExpression(context, table, node->arguments[i]);
+
+        if (argType != TOKEN_ERROR && !promotes(argType, symbol->paramTypes[i]))
+        {
+            semanticError(context, node->arguments[i]->line, node->arguments[i]->column,
+                          "Argument type mismatch.");
+        }
+    }
+
+    if (symbol->dataType == TOKEN_COROUTINE)
+    {
+        node->coroutine = findFunction(context, node->name);
+    }
+
+    return symbol->dataType; // Return the function's return type
+}
+
+// Suffix naming a type argument in the names of instances
+static const char *typeArgumentName(TokenType type)
+{
+    switch (type)
+    {
+    case TOKEN_INT:
+        return "int";
+    case TOKEN_FLOAT:
+        return "float";
+    case TOKEN_CHAR:
+        return "char";
+    default:
+        return "str";
+    }
+}
+
+// A call to a generic function binds each type parameter to the type of the
+// arguments passed for it, and calls the instance for those types instead.
+// The first call with a set of types creates the instance, named after the
+// generic and the types (जोड़__int), and appends it to the program, so it is
+// analyzed and generated like any other function; later calls share it.
+static TokenType analyzeGenericCall(SemanticContext *context, SymbolTable *table, AstCall *node,
+                                    AstFunctionDecl *generic)
+{
+    if (node->argCount != generic->paramCount)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Wrong number of arguments.");
+        return TOKEN_ERROR;
+    }
+
+    TokenType typeArguments[MAX_TYPE_PARAMS];
+    for (int k = 0; k < generic->typeParamCount; k++)
+    {
+        typeArguments[k] = TOKEN_ERROR;
+    }
+
+    bool bound = true;
+    for (int i = 0; i < node->argCount; i++)
+    {
+        AstNode *argument = node->arguments[i];
+        TokenType argType = analyzeExpression(context, table, argument);
+        int k = generic->params[i].typeParam;
+        if (argType == TOKEN_ERROR)
+        {
+            bound = false;
+        }
+        else if (k < 0)
+        {
+            if (!promotes(argType, generic->params[i].type))
+            {
+                semanticError(context, argument->line, argument->column,
+                              "Argument type mismatch.");
+            }
+        }
+        else if (!isScalarType(argType))
+        {
+            semanticError(context, argument->line, argument->column,
+                          "A type parameter stands for a number, a character or a string.");
+            bound = false;
+        }
+        else if (typeArguments[k] == TOKEN_ERROR)
+        {
+            typeArguments[k] = argType;
+        }
+        else if (typeArguments[k] != argType)
+        {
+            semanticError(context, argument->line, argument->column,
+                          "Arguments for the same type parameter must have the same type.");
+            bound = false;
+        }
+    }
+    if (!bound)
+        return TOKEN_ERROR;
+
+    // Instance name: the generic's name followed by its type arguments
+    char name[256];
+    int length = snprintf(name, sizeof(name), "%.*s_", generic->name.length, generic->name.start);
+    for (int k = 0; k < generic->typeParamCount && length < (int)sizeof(name); k++)
+    {
+        length += snprintf(name + length, sizeof(name) - length, "_%s", typeArgumentName(typeArguments[k]));
+    }
+
+    Token instanceName = node->name;
+    instanceName.start = name;
+    instanceName.length = (int)strlen(name);
+    AstFunctionDecl *instance = findFunction(context, instanceName);
+    if (instance == NULL)
+    {
+        char *ownedName = malloc(strlen(name) + 1);
+        strcpy(ownedName, name);
+        instance = instantiateFunction(generic, typeArguments, ownedName);
+        addDeclaration(context->program, (AstNode *)instance);
+
+        TokenType paramTypes[8];
+        for (int i = 0; i < instance->paramCount; i++)
+        {
+            paramTypes[i] = instance->params[i].type;
+        }
+        defineFunction(table, name, instance->returnType, instance->paramCount, paramTypes,
+                       instance->base.line, instance->base.column);
+    }
+    else if (instance->generic != generic)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "A function already has the name of this instance.");
+        return TOKEN_ERROR;
+    }
+
+    node->name.start = instance->name.start;
+    node->name.length = instance->name.length;
+    return instance->returnType;
+}
+
+// Analyze कार्य f(args): a call to a user-defined function that may run on
+// another worker until the enclosing function reaches प्रतीक्षा
+static TokenType analyzeSpawn(SemanticContext *context, SymbolTable *table, AstSpawn *node)
+{
+    AstCall *call = node->call;
+    const char *name = lexeme(call->name);
+
+    if (context->function == NULL)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "'कार्य' can only be used inside a function.");
+        return TOKEN_ERROR;
+    }
+
+    // A task could outlive the frame it reports back to
+    if (context->function->coroutine)
     {
+        semanticError(context, node->base.line, node->base.column,
+                      "Coroutines cannot start tasks.");
+        return TOKEN_ERROR;
+    }
 
-        // Types must be compatible
-        if (leftType != rightType)
+    for (int i = 0; builtins[i].name != NULL; i++)
+    {
+        if (strcmp(builtins[i].name, name) == 0)
         {
             semanticError(context, node->base.line, node->base.column,
-                          "Comparison operators require compatible operands.");
+                          "Only user-defined functions can run as tasks.");
             return TOKEN_ERROR;
         }
+    }
 
-        // Comparison results in a boolean (int)
-        return TOKEN_INT;
+    Symbol *symbol = resolveSymbol(table, name);
+    if (symbol != NULL && symbol->type == SYMBOL_FUNCTION && symbol->paramCount < 0)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "Only user-defined functions can run as tasks.");
+        return TOKEN_ERROR;
     }
 
-    // For logical operators (&&, ||)
-    if (node->operator== TOKEN_AND || node->operator== TOKEN_OR)
+    TokenType type = analyzeCall(context, table, call);
+    if (type == TOKEN_ERROR)
+        return TOKEN_ERROR;
+
+    for (int i = 0; i < call->argCount; i++)
     {
-        // Both operands must be boolean-convertible (int)
-        if (leftType != TOKEN_INT || rightType != TOKEN_INT)
+        if (!isTaskValueType(call->arguments[i]->dataType))
+        {
+            semanticError(context, call->arguments[i]->line, call->arguments[i]->column,
+                          "Task arguments must be numbers or characters.");
+            return TOKEN_ERROR;
+        }
+    }
+
+    if (type != TOKEN_VOID && !isTaskValueType(type))
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "A task must return a number, a character or nothing.");
+        return TOKEN_ERROR;
+    }
+
+    // Tasks spawned in a loop or nested block outlive the block, so their
+    // records cannot live on its stack
+    node->heapTask = table->scopeDepth > context->functionDepth;
+    context->function->spawns = true;
+    findFunction(context, call->name)->spawned = true;
+
+    context->runtimeFeatures |= RUNTIME_TASK;
+    node->base.dataType = type;
+    return type;
+}
+
+// The variable a task's result is stored in must stay in place until the
+// function waits, so it has to be declared directly in the function body
+static void storeTaskResult(SemanticContext *context, AstNode *value, Symbol *symbol)
+{
+    if (value->dataType == TOKEN_ERROR)
+        return;
+
+    if (value->dataType == TOKEN_VOID)
+    {
+        semanticError(context, value->line, value->column,
+                      "This task returns nothing.");
+        return;
+    }
+
+    if (symbol->scopeDepth != context->functionDepth || ((AstSpawn *)value)->heapTask)
+    {
+        semanticError(context, value->line, value->column,
+                      "The result of 'कार्य' must be stored by the function body in a variable declared there.");
+        return;
+    }
+
+    symbol->pendingTask = true;
+}
+
+// प्रतीक्षा: every task the function started has finished
+static void analyzeSync(SymbolTable *table)
+{
+    for (Symbol *symbol = table->first; symbol != NULL; symbol = symbol->next)
+    {
+        symbol->pendingTask = false;
+    }
+}
+
+// Check the arguments of लिखो and पढ़ो against their format string. Strings
+// are passed to printf as a length and a pointer, so they need a literal
+// format whose conversion for them is %s.
+static void analyzeFormatArguments(SemanticContext *context, SymbolTable *table, AstCall *node,
+                                   bool reads)
+{
+    if (node->argCount == 0)
+    {
+        semanticError(context, node->base.line, node->base.column, "Expected a format string.");
+        return;
+    }
+
+    AstNode *format = node->arguments[0];
+    context->formatString = true;
+    TokenType formatType = analyzeExpression(context, table, format);
+    context->formatString = false;
+    if (formatType == TOKEN_TEXT && !isStringConstant(format))
+    {
+        context->runtimeFeatures |= RUNTIME_STR;
+    }
+    if (formatType != TOKEN_ERROR && formatType != TOKEN_TEXT)
+    {
+        semanticError(context, format->line, format->column, "Expected a format string.");
+    }
+
+    bool literal = format->type == AST_LITERAL && formatType == TOKEN_TEXT;
+    if (!literal && node->argCount > 1)
+    {
+        semanticError(context, format->line, format->column,
+                      "The format must be a string literal when values follow it.");
+    }
+
+    // The literal's text without its quotes
+    const char *text = NULL;
+    int textLength = 0;
+    if (literal)
+    {
+        text = ((AstLiteral *)format)->value.start + 1;
+        textLength = ((AstLiteral *)format)->value.length - 2;
+    }
+
+    int position = -1;
+    for (int i = 1; i < node->argCount; i++)
+    {
+        AstNode *argument = node->arguments[i];
+        TokenType argType = analyzeExpression(context, table, argument);
+        if (literal)
+        {
+            position = nextFormatConversion(text, textLength, position + 1);
+        }
+
+        if (argType == TOKEN_ERROR)
+            continue;
+
+        if (!isScalarType(argType))
+        {
+            semanticError(context, argument->line, argument->column,
+                          "Only numbers and strings can be passed to this function.");
+        }
+        else if (argType == TOKEN_TEXT && reads)
+        {
+            semanticError(context, argument->line, argument->column,
+                          "Strings cannot be read with पढ़ो.");
+        }
+        else if (reads && argument->type == AST_VARIABLE)
         {
-            semanticError(context, node->base.line, node->base.column,
-                          "Logical operators require boolean operands.");
-            return TOKEN_ERROR;
+            checkWritable(context, argument, resolveSymbol(table, lexeme(((AstVariable *)argument)->name)));
         }
+        else if (argType == TOKEN_TEXT && literal &&
+                 (position < 0 || text[position] != 's'))
+        {
+            semanticError(context, argument->line, argument->column,
+                          "Strings must be printed with %s.");
+        }
+    }
+}
 
-        return TOKEN_INT;
+// Resolve a builtin's container argument, which must name a variable of the given kind
+static Symbol *containerArgument(SemanticContext *context, SymbolTable *table, AstCall *node,
+                                 TokenType kind, const char *message)
+{
+    AstNode *argument = node->arguments[0];
+    TokenType type = analyzeExpression(context, table, argument);
+    if (type == TOKEN_ERROR)
+        return NULL;
+
+    if (argument->type != AST_VARIABLE || type != kind)
+    {
+        semanticError(context, argument->line, argument->column, message);
+        return NULL;
     }
 
-    semanticError(context, node->base.line, node->base.column,
-                  "Unknown binary operator.");
-    return TOKEN_ERROR;
+    return resolveSymbol(table, lexeme(((AstVariable *)argument)->name));
 }
 
-// Analyze a unary expression
-static TokenType analyzeUnary(SemanticContext *context, SymbolTable *table, AstUnary *node)
+// Check a builtin argument against the type it must have
+static void checkArgument(SemanticContext *context, SymbolTable *table, AstCall *node,
+                          int index, TokenType expected)
 {
-    TokenType operandType = analyzeExpression(context, table, node->right);
+    AstNode *argument = node->arguments[index];
+    TokenType type = analyzeExpression(context, table, argument);
 
-    // Skip further analysis if operand had errors
-    if (operandType == TOKEN_ERROR)
+    if (type != TOKEN_ERROR && !promotes(type, expected))
     {
-        return TOKEN_ERROR;
+        semanticError(context, argument->line, argument->column, "Argument type mismatch.");
     }
+}
 
-    // Negation operator (-)
-    if (node->operator== TOKEN_MINUS)
+// A list of numbers, for क्रमबद्ध, खोज and यादृच्छिक_भरो; message says what
+// other lists cannot be used for
+static Symbol *numberListArgument(SemanticContext *context, SymbolTable *table, AstCall *node,
+                                  const char *message)
+{
+    Symbol *list = containerArgument(context, table, node, TOKEN_LIST, "Expected a list.");
+    if (list != NULL && list->elemType != TOKEN_INT && list->elemType != TOKEN_FLOAT)
     {
-        if (operandType != TOKEN_INT && operandType != TOKEN_FLOAT)
-        {
-            semanticError(context, node->base.line, node->base.column,
-                          "Unary negation requires a numeric operand.");
-            return TOKEN_ERROR;
-        }
-
-        return operandType;
+        semanticError(context, node->arguments[0]->line, node->arguments[0]->column, message);
+        return NULL;
     }
+    return list;
+}
 
-    // Logical NOT operator (!)
-    if (node->operator== TOKEN_NOT)
-    {
-        if (operandType != TOKEN_INT)
-        {
-            semanticError(context, node->base.line, node->base.column,
-                          "Logical NOT requires a boolean operand.");
-            return TOKEN_ERROR;
-        }
+// रखो(map, key, value): insert or overwrite
+static TokenType analyzeMapPut(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *map = containerArgument(context, table, node, TOKEN_MAP, "Expected a map.");
+    if (map == NULL)
+        return TOKEN_ERROR;
 
-        return TOKEN_INT;
-    }
+    checkArgument(context, table, node, 1, map->keyType);
+    checkArgument(context, table, node, 2, map->elemType);
+    return TOKEN_VOID;
+}
 
-    semanticError(context, node->base.line, node->base.column,
-                  "Unknown unary operator.");
-    return TOKEN_ERROR;
+// पाओ(map, key): the value for key, or zero
+static TokenType analyzeMapGet(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *map = containerArgument(context, table, node, TOKEN_MAP, "Expected a map.");
+    if (map == NULL)
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, map->keyType);
+    return map->elemType;
 }
 
-// Analyze a literal
-static TokenType analyzeLiteral(SemanticContext *context, SymbolTable *table, AstLiteral *node)
+// है(map, key): 1 if key is present
+static TokenType analyzeMapContains(SemanticContext *context, SymbolTable *table, AstCall *node)
 {
-    switch (node->value.type)
+    Symbol *map = containerArgument(context, table, node, TOKEN_MAP, "Expected a map.");
+    if (map == NULL)
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, map->keyType);
+    return TOKEN_INT;
+}
+
+// हटाओ(map, key): 1 if key was present and has been removed
+static TokenType analyzeMapRemove(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *map = containerArgument(context, table, node, TOKEN_MAP, "Expected a map.");
+    if (map == NULL)
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, map->keyType);
+    return TOKEN_INT;
+}
+
+// जोड़ो(list, value): append value
+static TokenType analyzeListPush(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *list = containerArgument(context, table, node, TOKEN_LIST, "Expected a list.");
+    if (list == NULL || !checkWritable(context, node->arguments[0], list))
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, list->elemType);
+    return TOKEN_VOID;
+}
+
+// निकालो(list): remove and return the last element
+static TokenType analyzeListPop(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *list = containerArgument(context, table, node, TOKEN_LIST, "Expected a list.");
+    if (list == NULL || !checkWritable(context, node->arguments[0], list))
+        return TOKEN_ERROR;
+    return list->elemType;
+}
+
+// आकार(container): number of elements
+static TokenType analyzeSize(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    AstNode *argument = node->arguments[0];
+    TokenType type = analyzeExpression(context, table, argument);
+    if (type == TOKEN_ERROR)
+        return TOKEN_ERROR;
+
+    if (argument->type != AST_VARIABLE || !isContainerType(type))
     {
-    case TOKEN_NUMBER:
-        // Check if it's an integer or float
-        if (strchr(node->value.start, '.') != NULL)
-        {
-            return TOKEN_FLOAT;
-        }
-        else
-        {
-            return TOKEN_INT;
-        }
-    case TOKEN_STRING:
-        return TOKEN_CHAR; // Treating string as character array
-    default:
-        semanticError(context, node->base.line, node->base.column,
-                      "Unknown literal type.");
+        semanticError(context, argument->line, argument->column, "Expected a container.");
         return TOKEN_ERROR;
     }
+    return TOKEN_INT;
 }
 
-// Analyze a variable reference
-static TokenType analyzeVariable(SemanticContext *context, SymbolTable *table, AstVariable *node)
+// Analyze a list element: name[index]
+static TokenType analyzeIndex(SemanticContext *context, SymbolTable *table, AstIndex *node)
 {
-    Symbol *symbol = resolveSymbol(table, node->name.start);
+    Symbol *symbol = resolveSymbol(table, lexeme(node->name));
 
     if (symbol == NULL)
     {
@@ -481,85 +2249,409 @@ static TokenType analyzeVariable(SemanticContext *context, SymbolTable *table, A
         return TOKEN_ERROR;
     }
 
-    if (symbol->type != SYMBOL_VARIABLE)
+    if (symbol->type != SYMBOL_VARIABLE || symbol->dataType != TOKEN_LIST)
     {
         semanticError(context, node->base.line, node->base.column,
-                      "Expected a variable name.");
+                      "Only lists can be indexed.");
         return TOKEN_ERROR;
     }
 
-    return symbol->dataType;
+    useVariable(context, symbol);
+    TokenType elemType = symbol->elemType;
+    TokenType indexType = analyzeExpression(context, table, node->index);
+    if (indexType != TOKEN_ERROR && indexType != TOKEN_INT)
+    {
+        semanticError(context, node->index->line, node->index->column,
+                      "List index must be an integer.");
+    }
+
+    return elemType;
 }
 
-// Analyze an assignment
-static TokenType analyzeAssignment(SemanticContext *context, SymbolTable *table, AstAssignment *node)
+// लंबाई(string): length in bytes
+static TokenType analyzeStringLength(SemanticContext *context, SymbolTable *table, AstCall *node)
 {
-    TokenType valueType = analyzeExpression(context, table, node->value);
+    checkArgument(context, table, node, 0, TOKEN_TEXT);
+    return TOKEN_INT;
+}
 
-    Symbol *symbol = resolveSymbol(table, node->name.start);
+// टुकड़ा(string, start, length): the bytes [start, start + length), sharing storage
+static TokenType analyzeSlice(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    checkArgument(context, table, node, 0, TOKEN_TEXT);
+    checkArgument(context, table, node, 1, TOKEN_INT);
+    checkArgument(context, table, node, 2, TOKEN_INT);
+    return TOKEN_TEXT;
+}
 
-    if (symbol == NULL)
+// अक्षर_गिनती(string): number of characters as a reader sees them
+static TokenType analyzeCharacterCount(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    checkArgument(context, table, node, 0, TOKEN_TEXT);
+    return TOKEN_INT;
+}
+
+// अक्षर(string, index): the index-th character, conjuncts included
+static TokenType analyzeCharacterAt(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    checkArgument(context, table, node, 0, TOKEN_TEXT);
+    checkArgument(context, table, node, 1, TOKEN_INT);
+    return TOKEN_TEXT;
+}
+
+static TokenType analyzeChannelSend(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *channel = containerArgument(context, table, node, TOKEN_CHANNEL, "Expected a channel.");
+    if (channel == NULL)
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, channel->elemType);
+    return TOKEN_VOID;
+}
+
+static TokenType analyzeChannelReceive(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *channel = containerArgument(context, table, node, TOKEN_CHANNEL, "Expected a channel.");
+    return channel == NULL ? TOKEN_ERROR : channel->elemType;
+}
+
+// The last argument of a परमाणु_ builtin names its memory order; loads
+// cannot release and stores cannot acquire
+static void checkMemoryOrder(SemanticContext *context, AstCall *node, bool load, bool store)
+{
+    AstNode *argument = node->arguments[node->argCount - 1];
+    MemoryOrder order = memoryOrderOf(argument);
+
+    if (order == MEMORY_ORDER_NONE)
     {
-        semanticError(context, node->base.line, node->base.column,
-                      "Undefined variable in assignment.");
+        semanticError(context, argument->line, argument->column,
+                      "Expected a memory order: शिथिल, अर्जन, विमोचन, अर्जन_विमोचन or अनुक्रमिक.");
+    }
+    else if ((load && (order == MEMORY_ORDER_RELEASE || order == MEMORY_ORDER_ACQ_REL)) ||
+             (store && (order == MEMORY_ORDER_ACQUIRE || order == MEMORY_ORDER_ACQ_REL)))
+    {
+        semanticError(context, argument->line, argument->column,
+                      load ? "A load cannot have release order." : "A store cannot have acquire order.");
+    }
+}
+
+// परमाणु_पढ़ो(atomic, order): the current value
+static TokenType analyzeAtomicLoad(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *atomic = containerArgument(context, table, node, TOKEN_ATOMIC, "Expected an atomic.");
+    checkMemoryOrder(context, node, true, false);
+    return atomic == NULL ? TOKEN_ERROR : TOKEN_INT;
+}
+
+// परमाणु_लिखो(atomic, value, order): replace the value
+static TokenType analyzeAtomicStore(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *atomic = containerArgument(context, table, node, TOKEN_ATOMIC, "Expected an atomic.");
+    if (atomic == NULL)
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, TOKEN_INT);
+    checkMemoryOrder(context, node, false, true);
+    return TOKEN_VOID;
+}
+
+// परमाणु_जोड़ो(atomic, value, order): add in one step and return the old value
+static TokenType analyzeAtomicAdd(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *atomic = containerArgument(context, table, node, TOKEN_ATOMIC, "Expected an atomic.");
+    if (atomic == NULL)
         return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, TOKEN_INT);
+    checkMemoryOrder(context, node, false, false);
+    return TOKEN_INT;
+}
+
+// परमाणु_बदलो(atomic, expected, desired, order): store desired if the value
+// is expected; 1 if it was
+static TokenType analyzeAtomicCompareExchange(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *atomic = containerArgument(context, table, node, TOKEN_ATOMIC, "Expected an atomic.");
+    if (atomic == NULL)
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, TOKEN_INT);
+    checkArgument(context, table, node, 2, TOKEN_INT);
+    checkMemoryOrder(context, node, false, false);
+    return TOKEN_INT;
+}
+
+// रोको_और_दो value: hand value to whoever resumed the coroutine
+static bool analyzeYield(SemanticContext *context, SymbolTable *table, AstYield *node)
+{
+    if (context->function == NULL || !context->function->coroutine)
+    {
+        semanticError(context, node->base.line, node->base.column,
+                      "'रोको_और_दो' can only be used in a coroutine.");
+        return false;
     }
 
-    if (symbol->type != SYMBOL_VARIABLE)
+    // The region's arena would be handed back while the coroutine is suspended
+    if (context->regionDepth > 0)
     {
         semanticError(context, node->base.line, node->base.column,
-                      "Cannot assign to a function.");
-        return TOKEN_ERROR;
+                      "A coroutine cannot suspend inside a 'क्षेत्र'.");
+        return false;
     }
 
-    if (valueType != TOKEN_ERROR && valueType != symbol->dataType)
+    // Time spent suspended would be counted as the run's
+    if (context->measureDepth > 0)
     {
         semanticError(context, node->base.line, node->base.column,
-                      "Type mismatch in assignment.");
-        return TOKEN_ERROR;
+                      "A coroutine cannot suspend inside 'मापो'.");
+        return false;
     }
 
-    return valueType;
+    TokenType type = analyzeValue(context, table, node->value);
+    if (type != TOKEN_ERROR && type != context->function->returnType)
+    {
+        semanticError(context, node->value->line, node->value->column,
+                      "Yielded value does not match the coroutine's type.");
+    }
+
+    context->yieldCount++;
+    return true;
 }
 
-// Analyze a function call
-static TokenType analyzeCall(SemanticContext *context, SymbolTable *table, AstCall *node)
+// मापो (runs) { body }
+static bool analyzeMeasure(SemanticContext *context, SymbolTable *table, AstMeasure *node)
 {
-    Symbol *symbol = resolveSymbol(table, node->name.start);
+    TokenType runsType = analyzeExpression(context, table, node->runs);
+    if (runsType != TOKEN_ERROR && runsType != TOKEN_INT)
+    {
+        semanticError(context, node->runs->line, node->runs->column,
+                      "The number of runs must be an integer.");
+    }
 
-    if (symbol == NULL)
+    context->measureDepth++;
+    bool result = analyzeStatement(context, table, node->body);
+    context->measureDepth--;
+
+    context->runtimeFeatures |= RUNTIME_TIME;
+    return result;
+}
+
+// अगला(coroutine): run it to its next रोको_और_दो; 1 if it yielded a value,
+// 0 once it has finished
+static TokenType analyzeCoroutineNext(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *coroutine = containerArgument(context, table, node, TOKEN_COROUTINE, "Expected a coroutine.");
+    if (coroutine == NULL)
+        return TOKEN_ERROR;
+
+    node->coroutine = coroutine->coroutine;
+    return TOKEN_INT;
+}
+
+// मान(coroutine): the value it yielded last
+static TokenType analyzeCoroutineValue(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *coroutine = containerArgument(context, table, node, TOKEN_COROUTINE, "Expected a coroutine.");
+    if (coroutine == NULL)
+        return TOKEN_ERROR;
+
+    node->coroutine = coroutine->coroutine;
+    return coroutine->elemType;
+}
+
+// खोलो(path): map the file at path for reading
+static TokenType analyzeFileOpen(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    checkArgument(context, table, node, 0, TOKEN_TEXT);
+    context->runtimeFeatures |= RUNTIME_FILE | RUNTIME_STR;
+    return TOKEN_FILE;
+}
+
+// अगली_पंक्ति(file): move to the next line; 0 at the end of the file
+static TokenType analyzeFileNextLine(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *file = containerArgument(context, table, node, TOKEN_FILE, "Expected a file.");
+    return file == NULL ? TOKEN_ERROR : TOKEN_INT;
+}
+
+// पंक्ति(file): the current line, without its line break
+static TokenType analyzeFileLine(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *file = containerArgument(context, table, node, TOKEN_FILE, "Expected a file.");
+    return file == NULL ? TOKEN_ERROR : TOKEN_TEXT;
+}
+
+// अगला_खंड(file, delimiter): move to the next field of the current line; 0
+// at the end of the line
+static TokenType analyzeFileNextField(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *file = containerArgument(context, table, node, TOKEN_FILE, "Expected a file.");
+    if (file == NULL)
+        return TOKEN_ERROR;
+
+    // The search compares whole blocks against one byte
+    AstNode *delimiter = node->arguments[1];
+    if (delimiterOf(delimiter) < 0)
     {
-        semanticError(context, node->base.line, node->base.column,
-                      "Undefined function.");
+        semanticError(context, delimiter->line, delimiter->column,
+                      "The delimiter must be a one-character string literal.");
+    }
+    return TOKEN_INT;
+}
+
+// खंड(file): the current field
+static TokenType analyzeFileField(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *file = containerArgument(context, table, node, TOKEN_FILE, "Expected a file.");
+    return file == NULL ? TOKEN_ERROR : TOKEN_TEXT;
+}
+
+// क्रमबद्ध(list): sort in ascending order
+static TokenType analyzeSort(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *list = numberListArgument(context, table, node,
+                                      "Only lists of numbers can be sorted and searched.");
+    if (list == NULL || !checkWritable(context, node->arguments[0], list))
+        return TOKEN_ERROR;
+
+    context->runtimeFeatures |= RUNTIME_SORT;
+    return TOKEN_VOID;
+}
+
+// खोज(list, value): index of value in a sorted list, or -1
+static TokenType analyzeSearch(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *list = numberListArgument(context, table, node,
+                                      "Only lists of numbers can be sorted and searched.");
+    if (list == NULL)
         return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, list->elemType);
+    context->runtimeFeatures |= RUNTIME_SORT;
+    return TOKEN_INT;
+}
+
+// Position a तालिका_पढ़ो column argument names, or -1 unless it is a small
+// integer literal
+static int columnIndexOf(AstNode *node)
+{
+    if (node->type != AST_LITERAL || ((AstLiteral *)node)->value.type != TOKEN_NUMBER)
+        return -1;
+
+    Token value = ((AstLiteral *)node)->value;
+    int index = 0;
+    for (int i = 0; i < value.length; i++)
+    {
+        if (value.start[i] < '0' || value.start[i] > '9' || index > 1000)
+            return -1;
+        index = index * 10 + (value.start[i] - '0');
     }
+    return index <= 1000 ? index : -1;
+}
 
-    if (symbol->type != SYMBOL_FUNCTION)
+// तालिका_पढ़ो(path, delimiter, column, list, ...): read the given columns of
+// a CSV or TSV file into lists of numbers or strings; the number of records
+static TokenType analyzeTableRead(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    if (node->argCount < 4 || node->argCount % 2 != 0)
     {
         semanticError(context, node->base.line, node->base.column,
-                      "Cannot call a variable.");
+                      "Expected a path, a delimiter and pairs of column and list.");
         return TOKEN_ERROR;
     }
 
-    // Check argument count
-    if (node->argCount != symbol->paramCount)
+    checkArgument(context, table, node, 0, TOKEN_TEXT);
+    AstNode *delimiter = node->arguments[1];
+    int byte = delimiterOf(delimiter);
+    if (byte < 0 || byte == '"' || byte == '\n')
     {
-        semanticError(context, node->base.line, node->base.column,
-                      "Wrong number of arguments.");
-        return TOKEN_ERROR;
+        semanticError(context, delimiter->line, delimiter->column,
+                      "The delimiter must be a one-character string literal.");
     }
 
-    // Check argument types
-    for (int i = 0; i < node->argCount; i++)
+    for (int i = 2; i < node->argCount; i += 2)
     {
-        TokenType argType = analyzeExpression(context, table, node->arguments[i]);
+        AstNode *column = node->arguments[i];
+        if (columnIndexOf(column) < 0)
+        {
+            semanticError(context, column->line, column->column,
+                          "A column is an integer literal from 0 to 1000.");
+        }
+        for (int j = 2; j < i; j += 2)
+        {
+            if (columnIndexOf(node->arguments[j]) == columnIndexOf(column) && columnIndexOf(column) >= 0)
+            {
+                semanticError(context, column->line, column->column, "Column is read twice.");
+            }
+        }
 
-        if (argType != TOKEN_ERROR && argType != symbol->paramTypes[i])
+        AstNode *list = node->arguments[i + 1];
+        TokenType type = analyzeExpression(context, table, list);
+        if (type == TOKEN_ERROR)
+            continue;
+        Symbol *symbol = list->type == AST_VARIABLE
+                             ? resolveSymbol(table, lexeme(((AstVariable *)list)->name))
+                             : NULL;
+        if (type != TOKEN_LIST || symbol == NULL || symbol->elemType == TOKEN_CHAR)
         {
-            semanticError(context, node->arguments[i]->line, node->arguments[i]->column,
-                          "Argument type mismatch.");
+            semanticError(context, list->line, list->column,
+                          "Expected a list of numbers or strings.");
+        }
+        else
+        {
+            checkWritable(context, list, symbol);
         }
     }
 
-    return symbol->dataType; // Return the function's return type
-}
\ No newline at end of file
+    context->runtimeFeatures |= RUNTIME_CSV | RUNTIME_FILE | RUNTIME_LIST | RUNTIME_STR;
+    return TOKEN_INT;
+}
+
+// समय_नैनो(): nanoseconds on a monotonic clock, for timing short sections
+static TokenType analyzeTimeNano(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    (void)table;
+    (void)node;
+    context->runtimeFeatures |= RUNTIME_TIME;
+    return TOKEN_INT;
+}
+
+// यादृच्छिक(bound): a random number from 0 up to, not including, bound; an
+// integer or a float like bound
+static TokenType analyzeRandom(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    AstNode *bound = node->arguments[0];
+    TokenType type = analyzeExpression(context, table, bound);
+    if (type == TOKEN_ERROR)
+        return TOKEN_ERROR;
+    if (type != TOKEN_INT && type != TOKEN_FLOAT)
+    {
+        semanticError(context, bound->line, bound->column, "The bound must be a number.");
+        return TOKEN_ERROR;
+    }
+
+    context->runtimeFeatures |= RUNTIME_RANDOM;
+    return type;
+}
+
+// यादृच्छिक_भरो(list, count, bound): append count random numbers below bound
+static TokenType analyzeRandomFill(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    Symbol *list = numberListArgument(context, table, node,
+                                      "Only lists of numbers can be filled with random numbers.");
+    if (list == NULL || !checkWritable(context, node->arguments[0], list))
+        return TOKEN_ERROR;
+
+    checkArgument(context, table, node, 1, TOKEN_INT);
+    checkArgument(context, table, node, 2, list->elemType);
+    context->runtimeFeatures |= RUNTIME_RANDOM;
+    return TOKEN_VOID;
+}
+
+// यादृच्छिक_बीज(seed): make the random numbers that follow repeatable
+static TokenType analyzeRandomSeed(SemanticContext *context, SymbolTable *table, AstCall *node)
+{
+    checkArgument(context, table, node, 0, TOKEN_INT);
+    context->runtimeFeatures |= RUNTIME_RANDOM;
+    return TOKEN_VOID;
+}
@@ -23,6 +23,15 @@ static Symbol *createSymbol(const char *name, SymbolType type, int scopeDepth)
 
     symbol->type = type;
     symbol->dataType = TOKEN_VOID; // Default
+    symbol->keyType = TOKEN_VOID;
+    symbol->elemType = TOKEN_VOID;
+    symbol->pendingTask = false;
+    symbol->coroutine = NULL;
+    symbol->generic = NULL;
+    symbol->constant = NULL;
+    symbol->frameSlot = -1;
+    symbol->yieldsBefore = 0;
+    symbol->lastUse = 0;
     symbol->paramCount = 0;
     symbol->paramTypes = NULL;
     symbol->scopeDepth = scopeDepth;